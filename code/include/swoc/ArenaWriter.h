@@ -34,10 +34,10 @@ public:
    * @param n Amount of data in bytes.
    * @return @a this
    */
-  ArenaWriter& write(void const *data, size_t n) override;
+  ArenaWriter& write(void const *data, size_t n);
 
   /// Write a single character @a c to the buffer.
-  ArenaWriter& write(char c) override;
+  ArenaWriter& write(char c);
 
   using super_type::write; // import super class write.
 
@@ -51,6 +51,12 @@ public:
 protected:
   MemArena& _arena; ///< Arena for the buffer.
 
+  /// Expand the buffer and write @a c.
+  ArenaWriter& overflow(char c) override;
+
+  /// Expand the buffer and write @a data.
+  ArenaWriter& overflow(void const *data, size_t n) override;
+
   /** Reallocate the buffer to increase the capacity.
    *
    * @param n Total size required.
@@ -61,4 +67,14 @@ protected:
 inline swoc::ArenaWriter::ArenaWriter(swoc::MemArena& arena)
     : super_type(arena.remnant()), _arena(arena) {}
 
+inline ArenaWriter&
+ArenaWriter::write(char c) {
+  return static_cast<self_type&>(this->BufferWriter::write(c));
+}
+
+inline ArenaWriter&
+ArenaWriter::write(void const *data, size_t n) {
+  return static_cast<self_type&>(this->BufferWriter::write(data, n));
+}
+
 }} // namespace swoc
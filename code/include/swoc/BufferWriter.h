@@ -39,6 +39,12 @@ class ArgPack;
  * needed can be determined by the method @c extent.
  *
  * @note This is a protocol class, concrete subclasses implement the functionality.
+ *
+ * Writing is done through an output window, the range [ @a _cursor, @a _limit ), of memory that
+ * can be written directly. Writes that fit in the window are done inline without a virtual call,
+ * other writes are passed to the virtual @c overflow methods. Subclasses that have a buffer should
+ * keep the window set to the unused part of the buffer. A subclass that leaves the window empty
+ * gets every write through @c overflow.
  */
 class BufferWriter {
 public:
@@ -47,19 +53,15 @@ public:
    * @param c Character to write.
    * @return @a this.
    */
-  virtual BufferWriter& write(char c) = 0;
+  BufferWriter& write(char c);
 
   /** Write @a length bytes starting at @a data to the buffer.
    *
    * @param data Source data.
    * @param length Number of bytes in the source data.
    * @return @a this.
-   *
-   * @internal This uses the single character write to output the data. It is presumed concrete
-   * subclasses will override this method to use more efficient mechanisms, dependent on the type of
-   * output buffer.
    */
-  virtual BufferWriter& write(void const *data, size_t length);
+  BufferWriter& write(void const *data, size_t length);
 
   /** Add the contents of @a sv to the buffer, up to the size of the view.
 
@@ -222,6 +224,37 @@ public:
   template<typename... Args>
   BufferWriter& print_v(const bwf::Format& fmt, const std::tuple<Args...>& args);
 
+  /** Formatted output to the buffer, with a format string parsed at compile time.
+   *
+   * @tparam F Format string.
+   * @tparam Args Types of the format arguments.
+   * @param args Arguments for the format string.
+   * @return @a this
+   *
+   * @a F must be a character array with static storage duration. It is parsed at compile time
+   * and each argument is formatted directly, which is faster than a @c bwf::Format. Errors in the
+   * format string, including argument indices out of range, are compile errors.
+   *
+   * @code
+   *   static constexpr char FMT[] = "Count {} in {:x}";
+   *   w.print<FMT>(count, addr);
+   * @endcode
+   *
+   * @see bwf::StaticFormat
+   */
+  template <char const *F, typename... Args> BufferWriter& print(Args&&... args);
+
+  /** Formatted output to the buffer, with a format string parsed at compile time.
+   *
+   * @tparam F Format string.
+   * @tparam Args Types of the format arguments.
+   * @param args The format arguments in a tuple.
+   * @return @a this
+   *
+   * This is the equivalent of the "va..." form for printing with a static format.
+   */
+  template <char const *F, typename... Args> BufferWriter& print_v(std::tuple<Args...> const& args);
+
   /** Write formatted output of @a args to @a this buffer.
    *
    * @tparam Binding Type for the name binding instance.
@@ -281,6 +314,32 @@ public:
    * Write the buffer contents to @a stream.
    */
   virtual std::ostream& operator>>(std::ostream& stream) const = 0;
+
+protected:
+  /** Write @a c when the output window is full.
+   *
+   * @param c Character to write.
+   * @return @a this
+   *
+   * Concrete subclasses must override this to handle a full window, e.g. by discarding @a c or
+   * by adding space and updating the window.
+   */
+  virtual BufferWriter& overflow(char c) = 0;
+
+  /** Write @a length bytes starting at @a data when they do not fit in the output window.
+   *
+   * @param data Source data.
+   * @param length Number of bytes in the source data.
+   * @return @a this
+   *
+   * @internal This writes the data one character at a time. It is presumed concrete subclasses
+   * will override this method to use more efficient mechanisms, dependent on the type of output
+   * buffer.
+   */
+  virtual BufferWriter& overflow(void const *data, size_t length);
+
+  char *_cursor = nullptr; ///< Next byte to write in the output window.
+  char *_limit  = nullptr; ///< End of the output window.
 };
 
 /** A concrete @c BufferWriter class for a fixed buffer.
@@ -322,10 +381,10 @@ public:
   self_type& assign(MemSpan<char> const& span);
 
   /// Write a single character @a c to the buffer.
-  FixedBufferWriter& write(char c) override;
+  FixedBufferWriter& write(char c);
 
   /// Write @a length bytes, starting at @a data, to the buffer.
-  FixedBufferWriter& write(const void *data, size_t length) override;
+  FixedBufferWriter& write(const void *data, size_t length);
 
   // Bring in non-overridden methods.
   using super_type::write;
@@ -388,12 +447,26 @@ public:
 
   template<typename... Args>
   self_type& print_v(bwf::Format const& fmt, std::tuple<Args...> const& args);
+
+  template <char const *F, typename... Args> self_type& print(Args&&... args);
+
+  template <char const *F, typename... Args> self_type& print_v(std::tuple<Args...> const& args);
   /// @endcond
 
 protected:
-  char *const _buffer;   ///< Output buffer.
-  size_t _capacity;      ///< Size of output buffer.
-  size_t _attempted = 0; ///< Number of characters written, including those discarded due error condition.
+  /// Discard @a c, the buffer is full.
+  FixedBufferWriter& overflow(char c) override;
+
+  /// Write as much of @a data as fits in the buffer, discarding the rest.
+  FixedBufferWriter& overflow(const void *data, size_t length) override;
+
+  /// Set the output window for the current buffer and capacity, with @a n bytes used.
+  void reset_window(size_t n);
+
+  char *const _buffer; ///< Output buffer.
+  size_t _capacity;    ///< Size of output buffer.
+  /// Number of characters discarded due to an error condition. The output window is empty if this is not zero.
+  size_t _excess = 0;
 };
 
 /** A @c BufferWriter that has an internal buffer.
@@ -439,8 +512,29 @@ protected:
 
 inline BufferWriter::~BufferWriter() {}
 
+inline BufferWriter&
+BufferWriter::write(char c) {
+  if (_cursor < _limit) {
+    *_cursor++ = c;
+    return *this;
+  }
+  return this->overflow(c);
+}
+
 inline BufferWriter&
 BufferWriter::write(const void *data, size_t length) {
+  if (length <= size_t(_limit - _cursor)) {
+    if (length) { // @a data can be @c nullptr if @a length is zero.
+      std::memcpy(_cursor, data, length);
+      _cursor += length;
+    }
+    return *this;
+  }
+  return this->overflow(data, length);
+}
+
+inline BufferWriter&
+BufferWriter::overflow(const void *data, size_t length) {
   const char *d = static_cast<const char *>(data);
 
   while (length--) {
@@ -475,26 +569,40 @@ inline FixedBufferWriter::FixedBufferWriter(char *buffer, size_t capacity)
   if (_capacity != 0 && buffer == nullptr) {
     throw (std::invalid_argument{"FixedBufferWriter created with null buffer and non-zero size."});
   };
+  this->reset_window(0);
 }
 
 inline FixedBufferWriter::FixedBufferWriter(MemSpan<void> const& span)
-    : _buffer{static_cast<char *>(span.data())}, _capacity{span.size()} {}
+    : _buffer{static_cast<char *>(span.data())}, _capacity{span.size()} {
+  this->reset_window(0);
+}
 
 inline FixedBufferWriter::FixedBufferWriter(MemSpan<char> const& span) : _buffer{span.begin()}
-                                                                         , _capacity{span.size()} {}
+                                                                         , _capacity{span.size()} {
+  this->reset_window(0);
+}
 
 inline FixedBufferWriter::FixedBufferWriter(std::nullptr_t) : _buffer(nullptr), _capacity(0) {}
 
+inline void
+FixedBufferWriter::reset_window(size_t n) {
+  _cursor = _buffer + n;
+  _limit  = _buffer + _capacity;
+}
+
 inline FixedBufferWriter::self_type&
 FixedBufferWriter::detach() {
   const_cast<char *&>(_buffer) = nullptr;
   _capacity = 0;
-  _attempted = 0;
+  _excess = 0;
+  this->reset_window(0);
   return *this;
 }
 
 inline FixedBufferWriter::FixedBufferWriter(FixedBufferWriter&& that)
-    : _buffer(that._buffer), _capacity(that._capacity), _attempted(that._attempted) {
+    : _buffer(that._buffer), _capacity(that._capacity), _excess(that._excess) {
+  _cursor = that._cursor;
+  _limit  = that._limit;
   that.detach();
 }
 
@@ -502,7 +610,8 @@ inline FixedBufferWriter::self_type&
 FixedBufferWriter::assign(MemSpan<char> const& span) {
   const_cast<char *&>(_buffer) = span.data();
   _capacity = span.size();
-  _attempted = 0;
+  _excess = 0;
+  this->reset_window(0);
   return *this;
 }
 
@@ -510,34 +619,37 @@ inline FixedBufferWriter&
 FixedBufferWriter::operator=(FixedBufferWriter&& that) {
   const_cast<char *&>(_buffer) = that._buffer;
   _capacity = that._capacity;
-  _attempted = that._attempted;
+  _excess = that._excess;
+  _cursor = that._cursor;
+  _limit = that._limit;
   that.detach();
   return *this;
 }
 
 inline FixedBufferWriter&
 FixedBufferWriter::write(char c) {
-  if (_attempted < _capacity) {
-    _buffer[_attempted] = c;
-  }
-  ++_attempted;
-
-  return *this;
+  return static_cast<self_type&>(this->super_type::write(c));
 }
 
 inline FixedBufferWriter&
 FixedBufferWriter::write(const void *data, size_t length) {
-  const size_t newSize = _attempted + length;
+  return static_cast<self_type&>(this->super_type::write(data, length));
+}
 
-  if (_buffer) {
-    if (newSize <= _capacity) {
-      std::memcpy(_buffer + _attempted, data, length);
-    } else if (_attempted < _capacity) {
-      std::memcpy(_buffer + _attempted, data, _capacity - _attempted);
-    }
-  }
-  _attempted = newSize;
+inline FixedBufferWriter&
+FixedBufferWriter::overflow(char) {
+  ++_excess;
+  return *this;
+}
 
+inline FixedBufferWriter&
+FixedBufferWriter::overflow(const void *data, size_t length) {
+  size_t n = std::min<size_t>(_limit - _cursor, length);
+  if (n) {
+    std::memcpy(_cursor, data, n);
+    _cursor += n;
+  }
+  _excess += length - n;
   return *this;
 }
 
@@ -549,17 +661,23 @@ FixedBufferWriter::data() const {
 
 inline bool
 FixedBufferWriter::error() const {
-  return _attempted > _capacity;
+  return _excess > 0;
 }
 
 inline char *
 FixedBufferWriter::aux_data() {
-  return error() ? nullptr : _buffer + _attempted;
+  return error() ? nullptr : _cursor;
 }
 
 inline bool
 FixedBufferWriter::commit(size_t n) {
-  _attempted += n;
+  size_t room = _limit - _cursor;
+  if (n <= room) {
+    _cursor += n;
+  } else {
+    _cursor = _limit;
+    _excess += n - room;
+  }
 
   return true;
 }
@@ -571,7 +689,7 @@ FixedBufferWriter::capacity() const {
 
 inline size_t
 FixedBufferWriter::extent() const {
-  return _attempted;
+  return (_cursor - _buffer) + _excess;
 }
 
 inline auto
@@ -580,33 +698,40 @@ FixedBufferWriter::restrict(size_t n) -> self_type& {
     throw (std::invalid_argument{"FixedBufferWriter restrict value more than capacity"});
   }
   _capacity -= n;
+  _limit = _buffer + _capacity;
+  if (_cursor > _limit) { // output past the new capacity is now discarded.
+    _excess += _cursor - _limit;
+    _cursor = _limit;
+  }
   return *this;
 }
 
 inline auto
 FixedBufferWriter::restore(size_t n) -> self_type& {
-  if (error()) {
-    _attempted = _capacity;
-  }
+  _excess = 0;
   _capacity += n;
+  _limit = _buffer + _capacity;
   return *this;
 }
 
 inline auto
 FixedBufferWriter::discard(size_t n) -> self_type& {
-  _attempted -= std::min(_attempted, n);
+  size_t k = std::min(_excess, n);
+  _excess -= k;
+  _cursor -= std::min<size_t>(_cursor - _buffer, n - k);
   return *this;
 }
 
 inline auto
 FixedBufferWriter::clear() -> self_type& {
-  _attempted = 0;
+  _excess = 0;
+  _cursor = _buffer;
   return *this;
 }
 
 inline auto
 FixedBufferWriter::copy(size_t dst, size_t src, size_t n) -> self_type& {
-  auto limit = std::min<size_t>(_capacity, _attempted); // max offset of region possible.
+  auto limit = std::min<size_t>(_capacity, this->extent()); // max offset of region possible.
   MemSpan<char> src_span{_buffer + src, std::min(limit, src + n)};
   MemSpan<char> dst_span{_buffer + dst, std::min(limit, dst + n)};
   std::memmove(dst_span.data(), src_span.data(), std::min(dst_span.size(), src_span.size()));
@@ -615,7 +740,7 @@ FixedBufferWriter::copy(size_t dst, size_t src, size_t n) -> self_type& {
 
 inline std::string_view
 FixedBufferWriter::view() const {
-  return {_buffer, size()};
+  return {_buffer, size_t(_cursor - _buffer)};
 }
 
 /// Provide a @c string_view of all successfully written characters as a user conversion.
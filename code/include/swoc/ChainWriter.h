@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+ * @c BufferWriter for a chain of segments in a @c MemArena.
+ */
+#pragma once
+
+#include <sys/uio.h>
+
+#include <vector>
+
+#include "swoc/swoc_version.h"
+#include "swoc/MemSpan.h"
+#include "swoc/bwf_base.h"
+#include "swoc/MemArena.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** Buffer writer for a chain of segments in a @c MemArena.
+ *
+ * Output is written to the remnant of the arena. When the remnant is full, the output in it is
+ * allocated from the arena as a segment and writing continues in a new block. Output is never
+ * copied once written, in contrast to @c ArenaWriter which copies all of the output each time
+ * its buffer grows. The output is therefore not contiguous - it is available as a list of
+ * segments, in a form that can be passed directly to @c writev or @c sendmsg.
+ *
+ * Segments are allocated from the arena and so remain valid until the arena is cleared or the
+ * generation is released. Output after the last segment is in the remnant and is allocated when
+ * the segments are retrieved. As with @c ArenaWriter the arena must not be used for other
+ * allocation while output is being written.
+ *
+ * @note There is no error state as the output is limited only by memory. @c data is the start of
+ * the first segment. @c copy works across segments, but it is much slower than the other methods.
+ */
+class ChainWriter : public BufferWriter {
+  using self_type  = ChainWriter;  ///< Self reference type.
+  using super_type = BufferWriter; ///< Parent type.
+public:
+  /// Default minimum size of a new segment.
+  static constexpr size_t DEFAULT_SEGMENT_SIZE = 16000;
+
+  /** Constructor.
+   *
+   * @param arena Arena to use for storage.
+   * @param segment_size Minimum size for new segments.
+   *
+   * Output starts in the current remnant of @a arena.
+   */
+  explicit ChainWriter(MemArena& arena, size_t segment_size = DEFAULT_SEGMENT_SIZE);
+
+  /// No copying.
+  ChainWriter(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  /// Write a single character @a c.
+  self_type& write(char c);
+
+  /** Write data.
+   *
+   * @param data Data to write.
+   * @param n Amount of data in bytes.
+   * @return @a this
+   */
+  self_type& write(void const *data, size_t n);
+
+  using super_type::write; // import super class write.
+
+  /// @return The start of the first segment.
+  const char *data() const override;
+
+  /// @return @c false - output is never discarded.
+  bool error() const override;
+
+  /// @return Address of the next output byte.
+  char *aux_data() override;
+
+  /// @return The output size plus the space remaining in the current segment.
+  size_t capacity() const override;
+
+  /// @return Number of bytes written.
+  size_t extent() const override;
+
+  /** Mark bytes in @c aux_data as in use.
+   *
+   * @param n Number of bytes to include in the output.
+   * @return @c true if successful, @c false if a new segment with space for @a n bytes was started.
+   */
+  bool commit(size_t n) override;
+
+  /// Remove @a n bytes from the end of the output.
+  self_type& discard(size_t n) override;
+
+  /** Reserve @a n more bytes at the end of each segment.
+   *
+   * @param n Number of bytes.
+   * @return @a this
+   *
+   * The reserved space is not used for output, in the current segment and in segments started
+   * later, until it is restored. If less than the reserved amount remains in the current segment
+   * the next write starts a new segment.
+   */
+  self_type& restrict(size_t n) override;
+
+  /// Restore @a n bytes of space reserved by @c restrict.
+  self_type& restore(size_t n) override;
+
+  /** Copy data from one part of the output to another.
+   *
+   * @param dst Offset of the first byte to copy onto.
+   * @param src Offset of the first byte to copy from.
+   * @param n Number of bytes to copy.
+   * @return @a this
+   *
+   * This is done a byte at a time unless both ranges are in the current segment.
+   */
+  self_type& copy(size_t dst, size_t src, size_t n) override;
+
+  /** Get the output.
+   *
+   * @return The segments of output, in order.
+   *
+   * Output not yet in a segment is allocated from the arena and added. Output can continue
+   * after this, the returned span is valid until the next write.
+   */
+  MemSpan<iovec const> iovecs();
+
+  /// @return The number of segments, including output not yet in a segment.
+  size_t count() const;
+
+  /** Get a segment.
+   *
+   * @param idx Segment index.
+   * @return The output in segment @a idx.
+   *
+   * The output not yet in a segment is treated as the last segment.
+   */
+  MemSpan<char const> segment(size_t idx) const;
+
+  /// Write all of the segments to @a stream.
+  std::ostream& operator>>(std::ostream& stream) const override;
+
+protected:
+  MemArena& _arena;            ///< Arena for the output.
+  size_t _segment_size;        ///< Minimum size for a new segment.
+  std::vector<iovec> _chain;   ///< Segments allocated from @a _arena.
+  size_t _chain_size = 0;      ///< Number of bytes in @a _chain.
+  char *_base        = nullptr; ///< Start of output in the remnant.
+  char *_end         = nullptr; ///< End of the remnant, @a _limit if not restricted.
+  size_t _restricted = 0;       ///< Bytes reserved at the end of each segment by @c restrict.
+
+  /// Continue in a new segment and write @a c.
+  self_type& overflow(char c) override;
+
+  /// Fill the current segment and continue in a new segment.
+  self_type& overflow(void const *data, size_t n) override;
+
+  /// Allocate the output in the remnant and add it to the chain.
+  void close_segment();
+
+  /** Start a new segment.
+   *
+   * @param n Minimum contiguous space required.
+   *
+   * The current segment is closed and the window set to a remnant of at least @a n bytes.
+   */
+  void next_segment(size_t n);
+
+  /// Set @a _limit for the reserved space in the current segment.
+  void apply_restriction();
+
+  /// @return The output byte at offset @a idx.
+  char& at(size_t idx);
+};
+
+// --- Implementation ---
+
+inline ChainWriter&
+ChainWriter::write(char c) {
+  return static_cast<self_type&>(this->super_type::write(c));
+}
+
+inline ChainWriter&
+ChainWriter::write(void const *data, size_t n) {
+  return static_cast<self_type&>(this->super_type::write(data, n));
+}
+
+inline const char *
+ChainWriter::data() const {
+  return _chain.empty() ? _base : static_cast<char const *>(_chain.front().iov_base);
+}
+
+inline bool
+ChainWriter::error() const {
+  return false;
+}
+
+inline char *
+ChainWriter::aux_data() {
+  return _cursor;
+}
+
+inline size_t
+ChainWriter::extent() const {
+  return _chain_size + (_cursor - _base);
+}
+
+inline size_t
+ChainWriter::capacity() const {
+  return this->extent() + (_limit - _cursor);
+}
+
+inline size_t
+ChainWriter::count() const {
+  return _chain.size() + (_cursor > _base);
+}
+
+}} // namespace swoc
@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Intrusive hash map for use by multiple threads.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "swoc/swoc_version.h"
+#include "swoc/IntrusiveHashMap.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** An intrusive hash map that can be used by multiple threads.
+ *
+ * The map is partitioned by hash in to a power of 2 number of shards, each an @c IntrusiveHashMap
+ * with its own lock, so that operations on different shards do not contend. As with
+ * @c IntrusiveHashMap no memory is allocated to insert or remove elements. The descriptor is the
+ * same as for @c IntrusiveHashMap.
+ *
+ * A plain mutex is used rather than a reader / writer lock because the critical sections are very
+ * short, and a shared lock still writes to the lock for every lookup. Contention is reduced by
+ * using more shards.
+ *
+ * Elements are not owned by the map. A pointer returned from @c find is valid only as long as the
+ * element is, which the map does not control - if other threads may remove and destroy elements,
+ * use @c find with a functor, which is invoked while the shard is locked.
+ *
+ * Iteration is done per shard by locking the shard with @c lock.
+ *
+ * @tparam H Descriptor, as for @c IntrusiveHashMap.
+ */
+template<typename H> class ConcurrentIntrusiveHashMap {
+  using self_type = ConcurrentIntrusiveHashMap; ///< Self reference type.
+public:
+  using map_type   = IntrusiveHashMap<H>;           ///< Shard map type.
+  using value_type = typename map_type::value_type; ///< Element type.
+  using key_type   = typename map_type::key_type;   ///< Key type.
+
+  /// Default number of shards.
+  static constexpr size_t DEFAULT_SHARD_COUNT = 16;
+
+  class Locked;
+
+  /** Construct with @a n shards.
+   *
+   * @param n Number of shards, rounded up to a power of 2.
+   */
+  explicit ConcurrentIntrusiveHashMap(size_t n = DEFAULT_SHARD_COUNT);
+
+  ConcurrentIntrusiveHashMap(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  /** Insert @a v.
+   *
+   * @param v Element to insert, which must not be in the map.
+   */
+  void insert(value_type *v);
+
+  /** Find an element with @a key.
+   *
+   * @param key Key to find.
+   * @return An element with @a key, or @c nullptr if not found.
+   */
+  value_type *find(key_type key) const;
+
+  /** Find an element with @a key and invoke @a f on it.
+   *
+   * @tparam F Functor taking <tt>value_type&</tt>.
+   * @param key Key to find.
+   * @param f Functor.
+   * @return @c true if an element was found, @c false if not.
+   *
+   * @a f is invoked with the shard locked, and so must not use this map.
+   */
+  template<typename F> bool find(key_type key, F&& f) const;
+
+  /** Invoke @a f on every element with @a key.
+   *
+   * @tparam F Functor taking <tt>value_type&</tt>.
+   * @param key Key to find.
+   * @param f Functor.
+   * @return The number of elements with @a key.
+   *
+   * Elements are visited in the order they were inserted. @a f is invoked with the shard locked,
+   * and so must not use this map.
+   */
+  template<typename F> size_t equal_range(key_type key, F&& f) const;
+
+  /** Remove @a v.
+   *
+   * @param v Element to remove.
+   * @return @c true if @a v was in the map and removed, @c false if not.
+   */
+  bool erase(value_type *v);
+
+  /** Remove and return an element with @a key.
+   *
+   * @param key Key to find.
+   * @return The removed element, or @c nullptr if there was no element with @a key.
+   *
+   * This is useful for pools, where one thread must be able to take an element without another
+   * thread taking the same one.
+   */
+  value_type *take(key_type key);
+
+  /// @return The number of elements in all shards.
+  size_t count() const;
+
+  /// @return The number of shards.
+  size_t shard_count() const;
+
+  /// @return The index of the shard for @a key.
+  size_t shard_for(key_type key) const;
+
+  /** Lock a shard for exclusive access.
+   *
+   * @param idx Shard index.
+   * @return A reference to the shard map which holds the lock while it exists.
+   *
+   * This must be used to iterate over the elements. Another shard must not be locked while the
+   * reference exists.
+   */
+  Locked lock(size_t idx);
+
+protected:
+  /// A shard, aligned so the locks for different shards are not in the same cache line.
+  struct alignas(64) Shard {
+    mutable std::mutex _mutex; ///< Lock for @a _map.
+    map_type _map;             ///< Elements in this shard.
+  };
+
+  std::unique_ptr<Shard[]> _shards; ///< Shards.
+  size_t _n_shards = 1;             ///< Number of shards.
+  unsigned _shift  = 0;             ///< Shift for the shard index, 0 if only one shard.
+
+  /// @return The shard for @a key.
+  Shard& shard(key_type key) const;
+};
+
+/// Exclusive access to a shard map.
+template<typename H> class ConcurrentIntrusiveHashMap<H>::Locked {
+  friend ConcurrentIntrusiveHashMap;
+
+public:
+  map_type& operator*() { return *_map; }
+  map_type *operator->() { return _map; }
+
+protected:
+  Locked(std::mutex& mutex, map_type& map) : _lock(mutex), _map(&map) {}
+
+  std::unique_lock<std::mutex> _lock; ///< Lock for the shard.
+  map_type *_map;                     ///< Shard map.
+};
+
+// --- Implementation ---
+
+template<typename H> ConcurrentIntrusiveHashMap<H>::ConcurrentIntrusiveHashMap(size_t n) {
+  unsigned bits = 0;
+  while (_n_shards < n) {
+    _n_shards <<= 1;
+    ++bits;
+  }
+  _shift  = bits ? 64 - bits : 0;
+  _shards = std::make_unique<Shard[]>(_n_shards);
+}
+
+template<typename H>
+size_t
+ConcurrentIntrusiveHashMap<H>::shard_for(key_type key) const {
+  if (_shift == 0) {
+    return 0;
+  }
+  // Mix the hash differently from the shard maps. A shard map with power of 2 buckets takes its
+  // bucket from the high bits of the hash multiplied by a constant, and if the shard came from the
+  // same bits all of the elements in a shard would be in a small fraction of its buckets.
+  uint64_t h = static_cast<uint64_t>(H::hash_of(key));
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h >> _shift;
+}
+
+template<typename H>
+auto
+ConcurrentIntrusiveHashMap<H>::shard(key_type key) const -> Shard& {
+  return _shards[this->shard_for(key)];
+}
+
+template<typename H>
+void
+ConcurrentIntrusiveHashMap<H>::insert(value_type *v) {
+  auto& s = this->shard(H::key_of(v));
+  std::lock_guard lock(s._mutex);
+  s._map.insert(v);
+}
+
+template<typename H>
+auto
+ConcurrentIntrusiveHashMap<H>::find(key_type key) const -> value_type * {
+  value_type *zret = nullptr;
+  this->find(key, [&](value_type& v) { zret = &v; });
+  return zret;
+}
+
+template<typename H>
+template<typename F>
+bool
+ConcurrentIntrusiveHashMap<H>::find(key_type key, F&& f) const {
+  auto& s = this->shard(key);
+  std::lock_guard lock(s._mutex);
+  map_type const& map = s._map;
+  if (auto spot = map.find(key); spot != map.end()) {
+    f(const_cast<value_type&>(*spot));
+    return true;
+  }
+  return false;
+}
+
+template<typename H>
+template<typename F>
+size_t
+ConcurrentIntrusiveHashMap<H>::equal_range(key_type key, F&& f) const {
+  auto& s = this->shard(key);
+  std::lock_guard lock(s._mutex);
+  map_type const& map = s._map;
+  size_t zret         = 0;
+  for (auto spot = map.find(key), limit = map.end(); spot != limit && H::equal(key, H::key_of(const_cast<value_type *>(&*spot)));
+       ++spot, ++zret) {
+    f(const_cast<value_type&>(*spot));
+  }
+  return zret;
+}
+
+template<typename H>
+bool
+ConcurrentIntrusiveHashMap<H>::erase(value_type *v) {
+  auto& s = this->shard(H::key_of(v));
+  std::lock_guard lock(s._mutex);
+  return s._map.erase(v);
+}
+
+template<typename H>
+auto
+ConcurrentIntrusiveHashMap<H>::take(key_type key) -> value_type * {
+  auto& s = this->shard(key);
+  std::lock_guard lock(s._mutex);
+  if (auto spot = s._map.find(key); spot != s._map.end()) {
+    value_type *zret = &*spot;
+    s._map.erase(spot);
+    return zret;
+  }
+  return nullptr;
+}
+
+template<typename H>
+size_t
+ConcurrentIntrusiveHashMap<H>::count() const {
+  size_t zret = 0;
+  for (size_t idx = 0; idx < _n_shards; ++idx) {
+    std::lock_guard lock(_shards[idx]._mutex);
+    zret += _shards[idx]._map.count();
+  }
+  return zret;
+}
+
+template<typename H>
+size_t
+ConcurrentIntrusiveHashMap<H>::shard_count() const {
+  return _n_shards;
+}
+
+template<typename H>
+auto
+ConcurrentIntrusiveHashMap<H>::lock(size_t idx) -> Locked {
+  return {_shards[idx]._mutex, _shards[idx]._map};
+}
+
+}} // namespace swoc
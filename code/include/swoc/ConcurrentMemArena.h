@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Memory arena for allocations from multiple threads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "swoc/MemArena.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** A memory arena that can be used by multiple threads.
+ *
+ * This has the same allocation and generation semantics as @c MemArena, but @c alloc and @c make
+ * can be called concurrently from different threads. Each thread allocates from its own current
+ * block so allocation does not lock and threads do not contend except when a thread needs a new
+ * block. Blocks are taken from a lock free @c MemArena::BlockPool and are returned to the pool,
+ * rather than freed, when the arena is thawed, discarded, or cleared. The pool can be private to
+ * the arena or shared.
+ *
+ * Allocations larger than the block size are put in their own, larger, block.
+ *
+ * Each thread remembers its state for the last @c N_BINDINGS arenas it used. Using an arena
+ * that is not among those locks the arena and does a hash lookup, so a thread that rotates
+ * allocations among more arenas than that will contend on the arena locks.
+ *
+ * @note Only allocation is thread safe. @c freeze, @c thaw, @c discard, @c clear, and the size and
+ * containment checks must not be called concurrently with allocation. State is kept for every
+ * thread that allocates from the arena until the arena is destroyed.
+ */
+class ConcurrentMemArena {
+  using self_type = ConcurrentMemArena; ///< Self reference type.
+
+public:
+  using Block     = MemArena::Block;
+  using BlockList = MemArena::BlockList;
+  using BlockPool = MemArena::BlockPool;
+
+  /// Default size of a block, chosen so the block and its header are 64K.
+  static constexpr size_t DEFAULT_BLOCK_SIZE = BlockPool::class_size(4);
+  /// Default maximum number of unused blocks of each size kept in the pool.
+  static constexpr size_t DEFAULT_POOL_SIZE = 256;
+  /// Number of arenas for which a thread can allocate without locking.
+  static constexpr unsigned N_BINDINGS = 4;
+
+  /** Construct with a block size and pool size.
+   *
+   * @param block_size Available storage in each block.
+   * @param pool_size Maximum number of unused blocks of each size to keep for reuse.
+   *
+   * The arena has its own pool. @a block_size is rounded up to a pool size class.
+   */
+  explicit ConcurrentMemArena(size_t block_size = DEFAULT_BLOCK_SIZE, size_t pool_size = DEFAULT_POOL_SIZE);
+
+  /** Construct with a shared pool.
+   *
+   * @param pool Pool for blocks.
+   * @param block_size Available storage in each block.
+   *
+   * @a block_size is rounded up to a pool size class.
+   */
+  explicit ConcurrentMemArena(BlockPool& pool, size_t block_size = DEFAULT_BLOCK_SIZE);
+
+  /// No copying.
+  ConcurrentMemArena(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  /// Destructor - all memory, including pooled blocks, is released.
+  ~ConcurrentMemArena();
+
+  /** Allocate @a n bytes of storage.
+   *
+   * @param n Number of bytes to allocate.
+   * @return A span of the allocated memory.
+   *
+   * This is thread safe.
+   */
+  MemSpan<void> alloc(size_t n);
+
+  /** Allocate a span of memory sufficient for @a n instances of @a T.
+   *
+   * @tparam T Element type.
+   * @param n Number of instances.
+   * @return A span large enough to hold @a n instances of @a T.
+   *
+   * The instances are @b not constructed. This is thread safe.
+   */
+  template <typename T> MemSpan<T> alloc_span(size_t n);
+
+  /** Allocate and construct an instance of @a T.
+   *
+   * @tparam T Type to create.
+   * @tparam Args Constructor argument types.
+   * @param args Constructor arguments.
+   * @return A pointer to the new instance.
+   *
+   * This is thread safe. See @c MemArena::make.
+   */
+  template <typename T, typename... Args> T *make(Args&&... args);
+
+  /** Freeze reserved memory.
+   *
+   * All current blocks are frozen and will not be used for future allocations. Previously frozen
+   * blocks are returned to the pool.
+   *
+   * @return @a this
+   */
+  self_type& freeze();
+
+  /** Unfreeze the arena.
+   *
+   * Frozen blocks are returned to the pool.
+   *
+   * @return @a this
+   */
+  self_type& thaw();
+
+  /** Discard all allocations.
+   *
+   * Each thread keeps its current block, reset to be empty. Other blocks are returned to the pool.
+   *
+   * @return @a this
+   */
+  self_type& discard();
+
+  /** Release all memory.
+   *
+   * All blocks, active and frozen, are returned to the pool.
+   *
+   * @return @a this
+   */
+  self_type& clear();
+
+  /// @return The amount of memory allocated in the active generation.
+  size_t size() const;
+
+  /// @return The total amount of memory allocated, active and frozen.
+  size_t allocated_size() const;
+
+  /// @return The total size of blocks in use by the arena, active and frozen.
+  size_t reserved_size() const;
+
+  /** Check if the byte at @a ptr is in memory owned by this arena.
+   *
+   * @param ptr Address of byte to check.
+   * @return @c true if the byte at @a ptr is in the arena, @c false if not.
+   */
+  bool contains(const void *ptr) const;
+
+  /// @return The size of blocks.
+  size_t block_size() const { return _block_size; }
+
+  /// @return The block pool.
+  BlockPool& pool() const { return *_pool; }
+
+protected:
+  /// Per thread allocation state.
+  struct Cache {
+    Block *_block = nullptr; ///< Current block for allocation.
+    BlockList _full;         ///< Other active blocks.
+    size_t _allocated = 0;   ///< Active allocated memory.
+    size_t _reserved  = 0;   ///< Active reserved memory.
+  };
+
+  /// An arena and the cache for a thread in that arena.
+  struct Binding {
+    uint64_t _serial = 0;       ///< Serial number of the arena.
+    Cache *_cache    = nullptr; ///< Cache for the thread in that arena.
+  };
+
+  /// @return The cache for the current thread.
+  Cache *cache();
+
+  /// Find or create the cache for the current thread when it is not the most recently used.
+  Cache *bind();
+
+  /// Allocate @a n bytes when the current block of @a cache does not have enough space.
+  MemSpan<void> alloc_slow(Cache *cache, size_t n);
+
+  /// Get a block with at least @a n bytes.
+  Block *make_block(size_t n);
+
+  /// Return the blocks in @a list to the pool and clear it.
+  void recycle(BlockList& list);
+
+  /// Return @a block to the pool.
+  void recycle(Block *block);
+
+  std::unique_ptr<BlockPool> _own_pool; ///< Pool if not shared.
+  BlockPool *_pool;                     ///< Source of blocks.
+  size_t _block_size;                   ///< Size of pooled blocks.
+  uint64_t _serial;                     ///< Unique serial number for thread binding.
+
+  std::mutex _mutex;                                            ///< Protects @a _caches.
+  std::unordered_map<std::thread::id, std::unique_ptr<Cache>> _caches; ///< Per thread state.
+
+  BlockList _frozen;            ///< Frozen blocks.
+  size_t _frozen_allocated = 0; ///< Frozen allocated memory.
+  size_t _frozen_reserved  = 0; ///< Frozen reserved memory.
+
+  static thread_local Binding _bindings[N_BINDINGS]; ///< Arenas used by the thread, most recent first.
+  static std::atomic<uint64_t> _next_serial;        ///< Source of arena serial numbers.
+};
+
+// --- Implementation ---
+
+inline auto
+ConcurrentMemArena::cache() -> Cache * {
+  return _bindings[0]._serial == _serial ? _bindings[0]._cache : this->bind();
+}
+
+inline MemSpan<void>
+ConcurrentMemArena::alloc(size_t n) {
+  Cache *cache = this->cache();
+  if (cache->_block && n <= cache->_block->remaining()) {
+    cache->_allocated += n;
+    return cache->_block->alloc(n);
+  }
+  return this->alloc_slow(cache, n);
+}
+
+template <typename T>
+MemSpan<T>
+ConcurrentMemArena::alloc_span(size_t n) {
+  return this->alloc(sizeof(T) * n).rebind<T>();
+}
+
+template <typename T, typename... Args>
+T *
+ConcurrentMemArena::make(Args&&... args) {
+  return new (this->alloc(sizeof(T)).data()) T(std::forward<Args>(args)...);
+}
+
+}} // namespace swoc
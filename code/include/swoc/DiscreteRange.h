@@ -8,8 +8,10 @@
  */
 
 #pragma once
+#include <cstring>
 #include <limits>
 #include <functional>
+#include <iterator>
 
 #include "swoc/swoc_version.h"
 #include "swoc/swoc_meta.h"
@@ -619,6 +621,9 @@ protected:
     /// @return The payload in the node.
     PAYLOAD& payload();
 
+    /// @return The payload in the node.
+    PAYLOAD const& payload() const { return _payload; }
+
     /** Set the @a range of a node.
      *
      * @param range Range to use.
@@ -657,7 +662,7 @@ protected:
      */
     self_type&
     dec_max() {
-      _range.dec_max();
+      _range.assign_max(--METRIC{_range.max()});
       this->ripple_structure_fixup();
       return *this;
     }
@@ -765,6 +770,84 @@ public:
    */
   self_type& fill(range_type const& range, PAYLOAD const& payload);
 
+  /** Load ranges in bulk.
+   *
+   * @tparam I Iterator type.
+   * @param first Iterator for the first element.
+   * @param last Iterator past the last element.
+   * @return @a this
+   *
+   * Each element must be a pair of a range and a payload. The result is the same as calling
+   * @c mark for each element in order. If the ranges are sorted, do not overlap, and are after any
+   * ranges already in the space, the nodes are appended to the list with adjacent ranges with
+   * equal payloads coalesced and the tree is built once in linear time. If an element is out of
+   * order or overlaps a previous range, the tree is built and that element and all following
+   * elements are loaded with @c mark.
+   */
+  template <typename I> self_type& load(I first, I last);
+
+  /** Load ranges in bulk.
+   *
+   * @tparam I Iterator type.
+   * @tparam F Projection functor type.
+   * @param first Iterator for the first element.
+   * @param last Iterator past the last element.
+   * @param proj Projection functor.
+   * @return @a this
+   *
+   * This is identical to the two argument @c load except @a proj is invoked on each element and
+   * must return a pair (or tuple) of the range and payload.
+   */
+  template <typename I, typename F> self_type& load(I first, I last, F&& proj);
+
+  /** Set @a this to the union of two spaces.
+   *
+   * @tparam U Payload type of @a rhs.
+   * @tparam F Blending functor type.
+   * @param lhs Left space.
+   * @param rhs Right space.
+   * @param blender Blending functor.
+   * @return @a this
+   *
+   * The result is the same as copying @a lhs and then blending every range in @a rhs with its
+   * payload as the color. Values only in @a lhs keep their payload, values only in @a rhs have a
+   * default constructed @c PAYLOAD blended with the @a rhs payload, and values in both have the
+   * @a lhs payload blended with the @a rhs payload. As with @c blend, if @a blender returns
+   * @c false the value is not in the result.
+   *
+   * Both spaces are walked in order at the same time and the result is built in linear time.
+   * @a this must not be @a lhs or @a rhs.
+   */
+  template <typename U, typename F>
+  self_type& unite(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs, F&& blender);
+
+  /** Set @a this to the intersection of two spaces.
+   *
+   * @tparam U Payload type of @a rhs.
+   * @tparam F Blending functor type.
+   * @param lhs Left space.
+   * @param rhs Right space.
+   * @param blender Blending functor.
+   * @return @a this
+   *
+   * Only values in both @a lhs and @a rhs are in the result, with the @a lhs payload blended with
+   * the @a rhs payload. See @c unite.
+   */
+  template <typename U, typename F>
+  self_type& intersect(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs, F&& blender);
+
+  /** Set @a this to the difference of two spaces.
+   *
+   * @tparam U Payload type of @a rhs.
+   * @param lhs Left space.
+   * @param rhs Right space.
+   * @return @a this
+   *
+   * Only values in @a lhs that are not in @a rhs are in the result, with the @a lhs payload.
+   * See @c unite.
+   */
+  template <typename U> self_type& difference(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs);
+
   /** Find the payload at @a metric.
    *
    * @param metric The metric for which to search.
@@ -772,6 +855,29 @@ public:
    */
   iterator find(METRIC const& metric);
 
+  /** Find the payload at @a metric.
+   *
+   * @param metric The metric for which to search.
+   * @return A constant iterator for the range containing @a metric, or @c end() if not found.
+   */
+  const_iterator find(METRIC const& metric) const;
+
+  /** Find the payloads for a batch of metrics.
+   *
+   * @param metrics The metrics for which to search.
+   * @param results Iterators for the results.
+   * @return The number of metrics found.
+   *
+   * Each element of @a results is set to the iterator for the corresponding element of
+   * @a metrics, or @c end() if that metric is not in the space. Only the first
+   * @c min(metrics.count(), results.count()) metrics are searched.
+   *
+   * The searches are interleaved in groups, advancing each search one tree level per pass and
+   * prefetching the next node. The memory latency of the searches in a group overlaps and for
+   * spaces larger than the cache this is much faster than repeated calls to @c find.
+   */
+  size_t find(MemSpan<METRIC const> metrics, MemSpan<iterator> results);
+
   /// @return The number of distinct ranges.
   size_t count() const;
 
@@ -779,6 +885,10 @@ public:
 
   iterator end() { return _list.end(); }
 
+  const_iterator begin() const { return _list.begin(); }
+
+  const_iterator end() const { return _list.end(); }
+
   /// Remove all ranges.
   void clear() {
     for (auto& node : _list) {
@@ -802,6 +912,13 @@ protected:
   /// @return The first node in the tree.
   Node *head();
 
+  /** Search the tree for @a metric.
+   *
+   * @param metric Search value.
+   * @return The node containing @a metric, or @c nullptr if not found.
+   */
+  Node *lookup(METRIC const& metric) const;
+
   /** Insert @a node before @a spot.
    *
    * @param spot Target node.
@@ -820,6 +937,40 @@ protected:
 
   void append(Node *node);
 
+  /** Append @a range with @a payload without updating the tree.
+   *
+   * @param range Range to append, which must be after all ranges in the space.
+   * @param payload Payload for @a range.
+   *
+   * If @a range is adjacent to the last range and the payloads are equal, the last range is
+   * extended instead of adding a node.
+   */
+  void extend(range_type const& range, PAYLOAD const& payload);
+
+  /** Merge two spaces in to @a this.
+   *
+   * @param lhs Left space.
+   * @param rhs Right space.
+   * @param blender Blending functor, applied where @a lhs and @a rhs overlap.
+   * @param lhs_p Keep values only in @a lhs.
+   * @param rhs_p Keep values only in @a rhs.
+   */
+  template <typename U, typename F>
+  void join(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs, F&& blender, bool lhs_p, bool rhs_p);
+
+  /// Rebuild the tree from the nodes in @a _list.
+  void rebuild_tree();
+
+  /** Build a balanced subtree.
+   *
+   * @param cursor Next node in the list, updated to the node after the subtree.
+   * @param n Number of nodes in the subtree.
+   * @param depth Depth of the subtree root.
+   * @param red_depth Depth of nodes to color red.
+   * @return The root of the subtree.
+   */
+  Node *build_tree(Node *&cursor, size_t n, unsigned depth, unsigned red_depth);
+
   void
   remove(Node *node) {
     _root = static_cast<Node *>(node->remove());
@@ -886,26 +1037,89 @@ DiscreteSpace<METRIC, PAYLOAD>::head() -> Node * {
 
 template<typename METRIC, typename PAYLOAD>
 auto
-DiscreteSpace<METRIC, PAYLOAD>::find(METRIC const& metric) -> iterator {
+DiscreteSpace<METRIC, PAYLOAD>::lookup(METRIC const& metric) const -> Node * {
   auto n = _root; // current node to test.
   while (n) {
     if (metric < n->min()) {
       if (n->_hull.contains(metric)) {
         n = n->left();
       } else {
-        return this->end();
+        return nullptr;
       }
     } else if (n->max() < metric) {
       if (n->_hull.contains(metric)) {
         n = n->right();
       } else {
-        return this->end();
+        return nullptr;
       }
     } else {
-      return _list.iterator_for(n);
+      return n;
+    }
+  }
+  return nullptr;
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::find(METRIC const& metric) -> iterator {
+  auto n = this->lookup(metric);
+  return n ? _list.iterator_for(n) : this->end();
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::find(METRIC const& metric) const -> const_iterator {
+  auto n = this->lookup(metric);
+  return n ? _list.iterator_for(n) : this->end();
+}
+
+template<typename METRIC, typename PAYLOAD>
+size_t
+DiscreteSpace<METRIC, PAYLOAD>::find(MemSpan<METRIC const> metrics, MemSpan<iterator> results) {
+  static constexpr size_t BATCH_WIDTH = 16; ///< # of searches interleaved.
+  Node *cursor[BATCH_WIDTH];                 ///< Current node for each search.
+  size_t zret = 0;
+  size_t n    = std::min(metrics.count(), results.count());
+
+  for (size_t base = 0; base < n; base += BATCH_WIDTH) {
+    auto width = std::min(BATCH_WIDTH, n - base);
+    auto keys  = metrics.data() + base;
+    auto spots = results.data() + base;
+    for (size_t idx = 0; idx < width; ++idx) {
+      cursor[idx] = _root;
+      spots[idx]  = this->end();
+    }
+    // Each pass advances every active search one level and prefetches the node it will check on
+    // the next pass, by which time the load should have completed.
+    for (size_t active = width; active > 0;) {
+      active = 0;
+      for (size_t idx = 0; idx < width; ++idx) {
+        Node *node = cursor[idx];
+        if (node == nullptr) {
+          continue;
+        }
+        auto const& metric = keys[idx];
+        if (!node->_hull.contains(metric)) {
+          node = nullptr;
+        } else if (metric < node->min()) {
+          node = node->left();
+        } else if (node->max() < metric) {
+          node = node->right();
+        } else {
+          spots[idx] = _list.iterator_for(node);
+          ++zret;
+          node = nullptr;
+        }
+        if (node) {
+          __builtin_prefetch(&node->_hull);
+          __builtin_prefetch(&node->_range);
+          ++active;
+        }
+        cursor[idx] = node;
+      }
     }
   }
-  return this->end();
+  return zret;
 }
 
 template<typename METRIC, typename PAYLOAD>
@@ -954,6 +1168,214 @@ void DiscreteSpace<METRIC, PAYLOAD>::append(DiscreteSpace::Node *node) {
   _list.append(node);
 }
 
+template<typename METRIC, typename PAYLOAD>
+template<typename I>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::load(I first, I last) -> self_type& {
+  return this->load(first, last, [](auto&& elt) -> decltype(auto) { return std::forward<decltype(elt)>(elt); });
+}
+
+template<typename METRIC, typename PAYLOAD>
+template<typename I, typename F>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::load(I first, I last, F&& proj) -> self_type& {
+  Node *tail   = static_cast<Node *>(_list.tail());
+  bool dirty_p = false; // Nodes were appended or changed without updating the tree.
+
+  // If the input can be counted, allocate the nodes in one block rather than many small ones.
+  if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<I>::iterator_category>) {
+    _arena.require(std::distance(first, last) * sizeof(Node));
+  }
+
+  for (; first != last; ++first) {
+    // Bind the element first - if the iterator yields a temporary it must outlive the projection.
+    auto&& elt          = *first;
+    auto&& [r, payload] = proj(elt);
+    range_type const& range = r;
+    // Anything not strictly after the current last range is handled by @c mark.
+    if (range.empty() || (tail && !(tail->max() < range.min()))) {
+      break;
+    }
+    this->extend(range, payload);
+    tail    = static_cast<Node *>(_list.tail());
+    dirty_p = true;
+  }
+
+  if (dirty_p) {
+    this->rebuild_tree();
+  }
+
+  for (; first != last; ++first) {
+    auto&& elt          = *first;
+    auto&& [r, payload] = proj(elt);
+    this->mark(r, payload);
+  }
+  return *this;
+}
+
+template<typename METRIC, typename PAYLOAD>
+template<typename U, typename F>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::unite(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs, F&& blender) -> self_type& {
+  this->join(lhs, rhs, blender, true, true);
+  return *this;
+}
+
+template<typename METRIC, typename PAYLOAD>
+template<typename U, typename F>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::intersect(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs, F&& blender) -> self_type& {
+  this->join(lhs, rhs, blender, false, false);
+  return *this;
+}
+
+template<typename METRIC, typename PAYLOAD>
+template<typename U>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::difference(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs) -> self_type& {
+  this->join(lhs, rhs, [](PAYLOAD&, U const&) { return false; }, true, false);
+  return *this;
+}
+
+template<typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD>::extend(range_type const& range, PAYLOAD const& payload) {
+  Node *tail = static_cast<Node *>(_list.tail());
+  if (tail && tail->payload() == payload && tail->_range.is_left_adjacent_to(range)) {
+    tail->_range.assign_max(range.max());
+  } else {
+    _list.append(_fa.make(range, payload));
+  }
+}
+
+template<typename METRIC, typename PAYLOAD>
+template<typename U, typename F>
+void
+DiscreteSpace<METRIC, PAYLOAD>::join(self_type const& lhs, DiscreteSpace<METRIC, U> const& rhs, F&& blender, bool lhs_p, bool rhs_p) {
+  this->clear();
+  _arena.require((lhs.count() + rhs.count()) * sizeof(Node));
+
+  // Emit the part of a range that is only in one space.
+  auto lhs_only = [&](range_type const& r, PAYLOAD const& payload) {
+    if (lhs_p) {
+      this->extend(r, payload);
+    }
+  };
+  auto rhs_only = [&](range_type const& r, U const& color) {
+    if (rhs_p) {
+      PAYLOAD payload{};
+      if (blender(payload, color)) {
+        this->extend(r, payload);
+      }
+    }
+  };
+
+  auto lspot = lhs.begin(), llimit = lhs.end();
+  auto rspot = rhs.begin(), rlimit = rhs.end();
+  // Parts of the current ranges not yet processed.
+  range_type lr, rr;
+  if (lspot != llimit) {
+    lr = lspot->range();
+  }
+  if (rspot != rlimit) {
+    rr = rspot->range();
+  }
+
+  while (lspot != llimit && rspot != rlimit) {
+    if (lr.max() < rr.min()) {
+      lhs_only(lr, lspot->payload());
+      if (++lspot != llimit) {
+        lr = lspot->range();
+      }
+    } else if (rr.max() < lr.min()) {
+      rhs_only(rr, rspot->payload());
+      if (++rspot != rlimit) {
+        rr = rspot->range();
+      }
+    } else if (lr.min() < rr.min()) { // overlap, left starts first.
+      lhs_only({lr.min(), --METRIC{rr.min()}}, lspot->payload());
+      lr.assign_min(rr.min());
+    } else if (rr.min() < lr.min()) { // overlap, right starts first.
+      rhs_only({rr.min(), --METRIC{lr.min()}}, rspot->payload());
+      rr.assign_min(lr.min());
+    } else { // overlap, same start.
+      METRIC max = std::min(lr.max(), rr.max());
+      PAYLOAD payload{lspot->payload()};
+      if (blender(payload, rspot->payload())) {
+        this->extend({lr.min(), max}, payload);
+      }
+      // Advance past @a max - @a max is not incremented unless it is less than the range max.
+      if (max == lr.max()) {
+        if (++lspot != llimit) {
+          lr = lspot->range();
+        }
+      } else {
+        lr.assign_min(++METRIC{max});
+      }
+      if (max == rr.max()) {
+        if (++rspot != rlimit) {
+          rr = rspot->range();
+        }
+      } else {
+        rr.assign_min(++METRIC{max});
+      }
+    }
+  }
+
+  // Only one of these can have ranges left and the first of those may be partially processed.
+  while (lspot != llimit) {
+    lhs_only(lr, lspot->payload());
+    if (++lspot != llimit) {
+      lr = lspot->range();
+    }
+  }
+  while (rspot != rlimit) {
+    rhs_only(rr, rspot->payload());
+    if (++rspot != rlimit) {
+      rr = rspot->range();
+    }
+  }
+
+  this->rebuild_tree();
+}
+
+template<typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD>::rebuild_tree() {
+  auto n = _list.count();
+  // Nodes on the deepest level are red, all others black. The tree is complete except possibly
+  // the deepest level so every path from the root has the same number of black nodes.
+  unsigned red_depth = 0;
+  while ((size_t(2) << red_depth) <= n) {
+    ++red_depth;
+  }
+  Node *cursor = this->head();
+  _root        = this->build_tree(cursor, n, 0, red_depth);
+  if (_root) {
+    _root->_parent = nullptr;
+    _root->_color  = Node::Color::BLACK;
+  }
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD>::build_tree(Node *&cursor, size_t n, unsigned depth, unsigned red_depth) -> Node * {
+  if (n == 0) {
+    return nullptr;
+  }
+  size_t n_left = (n - 1) / 2;
+  auto left     = this->build_tree(cursor, n_left, depth + 1, red_depth);
+  Node *node    = cursor;
+  cursor        = this->next(cursor);
+  auto right    = this->build_tree(cursor, n - 1 - n_left, depth + 1, red_depth);
+  node->_left = node->_right = nullptr;
+  node->set_child(left, Direction::LEFT);
+  node->set_child(right, Direction::RIGHT);
+  node->_color = depth == red_depth ? Node::Color::RED : Node::Color::BLACK;
+  node->structure_fixup();
+  return node;
+}
+
 template<typename METRIC, typename PAYLOAD>
 void
 DiscreteSpace<METRIC, PAYLOAD>::insert_before(DiscreteSpace::Node *spot
@@ -991,6 +1413,9 @@ template<typename METRIC, typename PAYLOAD>
 DiscreteSpace<METRIC, PAYLOAD>&
 DiscreteSpace<METRIC, PAYLOAD>::erase(DiscreteSpace::range_type const& range) {
   Node *n = this->lower_bound(range.min()); // current node.
+  if (nullptr == n) { // @a range starts before every node, but may still overlap some.
+    n = this->head();
+  }
   while (n) {
     auto nn = next(n); // cache in case @a n disappears.
     if (n->min() > range.max()) { // cleared the target range, done.
@@ -1144,7 +1569,7 @@ template<typename METRIC, typename PAYLOAD>
 DiscreteSpace<METRIC, PAYLOAD>&
 DiscreteSpace<METRIC, PAYLOAD>::fill(DiscreteSpace::range_type const& range
                                      , PAYLOAD const& payload) {
-  // Rightmost node of interest with n->_min <= min.
+  // Rightmost node of interest with n->min() <= min.
   Node *n = this->lower_bound(range.min());
   Node *x = nullptr; // New node (if any).
   // Need copies because we will modify these.
@@ -1154,14 +1579,14 @@ DiscreteSpace<METRIC, PAYLOAD>::fill(DiscreteSpace::range_type const& range
   // Handle cases involving a node of interest to the left of the
   // range.
   if (n) {
-    if (n->_min < min) {
+    if (n->min() < min) {
       auto min_1 = min;
       --min_1;               // dec is OK because min isn't zero.
       if (n->max() < min_1) { // no overlap, not adjacent.
         n = next(n);
       } else if (n->max() >= max) { // incoming range is covered, just discard.
         return *this;
-      } else if (n->payload != payload) { // different payload, clip range on left.
+      } else if (n->payload() != payload) { // different payload, clip range on left.
         min = n->max();
         ++min;
         n = next(n);
@@ -1188,14 +1613,14 @@ DiscreteSpace<METRIC, PAYLOAD>::fill(DiscreteSpace::range_type const& range
      - we must have either x != 0 or adjust min but not both for each loop iteration.
   */
   while (n) {
-    if (n->data() == payload) {
+    if (n->payload() == payload) {
       if (x) {
-        if (n->_max <= max) { // next range is covered, so we can remove and continue.
+        if (n->max() <= max) { // next range is covered, so we can remove and continue.
           this->remove(n);
           n = next(x);
-        } else if (n->_min <= max_plus1) {
+        } else if (n->min() <= max_plus1) {
           // Overlap or adjacent with larger max - absorb and finish.
-          x->assign_max(n->_max);
+          x->assign_max(n->max());
           this->remove(n);
           return *this;
         } else {
@@ -1204,11 +1629,11 @@ DiscreteSpace<METRIC, PAYLOAD>::fill(DiscreteSpace::range_type const& range
           return *this;
         }
       } else {                // not carrying a span.
-        if (n->_max <= max) { // next range is covered - use it.
+        if (n->max() <= max) { // next range is covered - use it.
           x = n;
           x->assign_min(min);
           n = next(n);
-        } else if (n->_min <= max_plus1) {
+        } else if (n->min() <= max_plus1) {
           n->assign_min(min);
           return *this;
         } else { // no overlap, space to complete range.
@@ -1218,33 +1643,33 @@ DiscreteSpace<METRIC, PAYLOAD>::fill(DiscreteSpace::range_type const& range
       }
     } else { // different payload
       if (x) {
-        if (max < n->_min) { // range ends before n starts, done.
+        if (max < n->min()) { // range ends before n starts, done.
           x->assign_max(max);
           return *this;
-        } else if (max <= n->_max) { // range ends before n, done.
-          x->assign_max(n->_min).dec_max();
+        } else if (max <= n->max()) { // range ends before n, done.
+          x->assign_max(n->min()).dec_max();
           return *this;
         } else { // n is contained in range, skip over it.
-          x->assign_max(n->_min).dec_max();
+          x->assign_max(n->min()).dec_max();
           x = nullptr;
-          min = n->_max;
-          ++min; // OK because n->_max maximal => next is null.
+          min = n->max();
+          ++min; // OK because n->max() maximal => next is null.
           n = next(n);
         }
       } else {               // no carry node.
-        if (max < n->_min) { // entirely before next span.
+        if (max < n->min()) { // entirely before next span.
           this->insert_before(n, _fa.make(min, max, payload));
           return *this;
         } else {
-          if (min < n->_min) { // leading section, need node.
-            auto y = _fa.make(min, n->_min, payload);
+          if (min < n->min()) { // leading section, need node.
+            auto y = _fa.make(min, n->min(), payload);
             y->dec_max();
             this->insert_before(n, y);
           }
-          if (max <= n->_max) { // nothing past node
+          if (max <= n->max()) { // nothing past node
             return *this;
           }
-          min = n->_max;
+          min = n->max();
           ++min;
           n = next(n);
         }
@@ -1378,30 +1803,28 @@ DiscreteSpace<METRIC, PAYLOAD>::blend(DiscreteSpace::range_type const& range, U
         pred->assign_max(remaining.max());
       } else if (!remaining.empty()) { // Must add new range.
         this->insert_before(n, _fa.make(remaining.min(), remaining.max(), plain_color));
+      } else if (pred && pred->payload() == n->payload() && pred->range().is_left_adjacent_to(n->range())) {
+        // Target range ended at @a n and the last blended range has the same color, collapse.
+        auto pred_min = pred->min();
+        this->remove(pred);
+        n->assign_min(pred_min);
       }
       return *this;
     }
 
     // Invariant: @n has right overlap with @a remaining
 
-    // If there's a gap on the left, fill from @a r.min to @a n.min - 1
+    // If there's a gap on the left, fill from @a r.min to @a n.min - 1. This is never merged in to
+    // @a n because @a n is blended below and the gap must not be. If the blended @a n ends up the
+    // same color as the gap, that is coalesced below.
     if (plain_color_p && remaining.min() < n->min()) {
-      if (n->payload() == plain_color) {
-        if (pred && pred->payload() == n->payload()) {
-          auto pred_min{pred->min()};
-          this->remove(pred);
-          n->assign_min(pred_min);
-        } else {
-          n->assign_min(remaining.min());
-        }
+      auto n_min_minus_1{n->min()};
+      --n_min_minus_1;
+      // @a pred can only be extended if it's adjacent to the gap.
+      if (pred && ++metric_type(pred->max()) == remaining.min() && pred->payload() == plain_color) {
+        pred->assign_max(n_min_minus_1);
       } else {
-        auto n_min_minus_1{n->min()};
-        --n_min_minus_1;
-        if (pred && pred->payload() == plain_color) {
-          pred->assign_max(n_min_minus_1);
-        } else {
-          this->insert_before(n, _fa.make(remaining.min(), n_min_minus_1, plain_color));
-        }
+        this->insert_before(n, _fa.make(remaining.min(), n_min_minus_1, plain_color));
       }
     }
 
@@ -1423,7 +1846,11 @@ DiscreteSpace<METRIC, PAYLOAD>::blend(DiscreteSpace::range_type const& range, U
 
       if (right_ext_p) {
         if (n->payload() == fill->payload()) {
-          n->assign_min(fill->min());
+          if (pred_adj_p) { // collapse @a pred in to @a n.
+            auto pred_min{pred->min()};
+            this->remove(pred);
+            n->assign_min(pred_min);
+          }
         } else {
           n->assign_min(range_max_plus_1);
           if (pred_adj_p) {
@@ -1470,4 +1897,371 @@ DiscreteSpace<METRIC, PAYLOAD>::blend(DiscreteSpace::range_type const& range, U
   return *this;
 }
 
+/** A read only, compact search structure for a @c DiscreteSpace.
+ *
+ * @tparam METRIC Value type for the space.
+ * @tparam PAYLOAD Data stored with values in the space.
+ *
+ * This is a "frozen" copy of a @c DiscreteSpace optimized for lookup. The ranges are stored in
+ * contiguous arrays in Eytzinger (breadth first) order, which makes a search access memory
+ * in a predictable pattern that is amenable to prefetching. The range maximums are kept in a
+ * separate array from the range minimums and payloads so that the search touches as few cache
+ * lines as possible. Because the ranges are disjoint, the range maximums are also ordered and
+ * therefore the only candidate range for a value is the first range with a maximum not less than
+ * the value.
+ *
+ * Iteration is supported and is in range order, the same as for @c DiscreteSpace.
+ *
+ * The arrays are indexed from 1 - the element at index 0 is unused and index 0 is used as the
+ * invalid / past the end index. Each array therefore has one more element than the number of
+ * ranges.
+ *
+ * @note The instance can either own its memory (if constructed from a @c DiscreteSpace) or refer
+ * to external memory. In the latter case, the external memory must outlive this instance.
+ */
+template<typename METRIC, typename PAYLOAD> class DiscreteFlatSpace {
+  using self_type = DiscreteFlatSpace;
+
+public:
+  using metric_type  = METRIC;  ///< Export.
+  using payload_type = PAYLOAD; ///< Export.
+  using range_type   = DiscreteRange<METRIC>;
+  using space_type   = DiscreteSpace<METRIC, PAYLOAD>; ///< Source space type.
+
+  /// Number of metrics per cache line, used to prefetch several levels ahead in the search.
+  static constexpr size_t PREFETCH_STRIDE = sizeof(METRIC) < 64 ? 64 / sizeof(METRIC) : 1;
+
+  /// Constant iterator, the only iterator as the space is read only.
+  class const_iterator {
+    using self_type = const_iterator;
+    friend DiscreteFlatSpace;
+
+  public:
+    /// Value type of iteration - the range and a reference to the payload.
+    using value_type        = std::tuple<range_type const, PAYLOAD const&>;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using pointer           = value_type *;
+    using reference         = value_type;
+    using difference_type   = int;
+
+    /// Default constructor - invalid iterator.
+    const_iterator() = default;
+
+    /// @return The range and payload for the current element.
+    value_type operator*() const { return {this->range(), this->payload()}; }
+
+    /// @return The range of the current element.
+    range_type range() const { return {_space->_min[_idx], _space->_max[_idx]}; }
+
+    /// @return The payload of the current element.
+    PAYLOAD const& payload() const { return _space->_payload[_idx]; }
+
+    /// Move to next element.
+    self_type& operator++();
+
+    /// Move to previous element.
+    self_type& operator--();
+
+    /// Post-increment.
+    self_type
+    operator++(int) {
+      self_type zret{*this};
+      ++*this;
+      return zret;
+    }
+
+    /// Post-decrement.
+    self_type
+    operator--(int) {
+      self_type zret{*this};
+      --*this;
+      return zret;
+    }
+
+    /// @return @c true if the iterator refers to an element.
+    bool has_next() const { return _idx != 0; }
+
+    /// @return @c true if decrementing would yield a valid element.
+    bool has_prev() const { return _idx != 0 ? _space->prev_idx(_idx) != 0 : _space->count() > 0; }
+
+    /// Equality.
+    bool operator==(self_type const& that) const { return _idx == that._idx && _space == that._space; }
+
+    /// Inequality.
+    bool operator!=(self_type const& that) const { return !(*this == that); }
+
+  protected:
+    /// Internal constructor.
+    const_iterator(DiscreteFlatSpace const *space, size_t idx) : _space(space), _idx(idx) {}
+
+    DiscreteFlatSpace const *_space = nullptr; ///< Container.
+    size_t _idx                     = 0;       ///< Array index, 0 is the end.
+  };
+
+  using iterator = const_iterator;
+
+  /// Construct an empty space.
+  DiscreteFlatSpace() = default;
+
+  /** Construct from a @a space.
+   *
+   * @param space Source space.
+   *
+   * All of the ranges and payloads are copied in to memory owned by this instance.
+   */
+  explicit DiscreteFlatSpace(space_type const& space);
+
+  /** Construct over external memory.
+   *
+   * @param min Range minimums.
+   * @param max Range maximums.
+   * @param payload Range payloads.
+   *
+   * All of the spans must be the same size and in the internal layout. These are generally
+   * obtained from another instance via the @c min_span, @c max_span, and @c payload_span methods.
+   * The memory is not copied and must outlive this instance.
+   */
+  DiscreteFlatSpace(MemSpan<METRIC const> min, MemSpan<METRIC const> max, MemSpan<PAYLOAD const> payload);
+
+  DiscreteFlatSpace(self_type const& that) = delete;
+  DiscreteFlatSpace(self_type&& that);
+  self_type& operator=(self_type const& that) = delete;
+  self_type& operator=(self_type&& that);
+
+  ~DiscreteFlatSpace();
+
+  /** Find the range containing @a metric.
+   *
+   * @param metric The metric for which to search.
+   * @return An iterator for the range containing @a metric, or @c end if not found.
+   */
+  const_iterator find(METRIC const& metric) const;
+
+  /// @return The number of distinct ranges.
+  size_t count() const { return _max.count() ? _max.count() - 1 : 0; }
+
+  /// @return @c true if there are no ranges.
+  bool empty() const { return this->count() == 0; }
+
+  const_iterator begin() const;
+
+  const_iterator end() const { return {this, 0}; }
+
+  /// @return The array of range minimums in internal layout.
+  MemSpan<METRIC const> min_span() const { return _min; }
+
+  /// @return The array of range maximums in internal layout.
+  MemSpan<METRIC const> max_span() const { return _max; }
+
+  /// @return The array of payloads in internal layout.
+  MemSpan<PAYLOAD const> payload_span() const { return _payload; }
+
+protected:
+  MemSpan<METRIC const> _min;      ///< Range minimums.
+  MemSpan<METRIC const> _max;      ///< Range maximums - search keys.
+  MemSpan<PAYLOAD const> _payload; ///< Range payloads.
+  MemArena _arena{0};              ///< Storage if the data is owned.
+
+  /** Search for @a metric.
+   *
+   * @param metric Search value.
+   * @return Index of the element containing @a metric, 0 if not found.
+   */
+  size_t search(METRIC const& metric) const;
+
+  /// @return Index of the in order successor of @a idx.
+  size_t next_idx(size_t idx) const;
+
+  /// @return Index of the in order predecessor of @a idx.
+  size_t prev_idx(size_t idx) const;
+
+  /// Destroy any owned payloads.
+  void destroy_payloads();
+
+  /** Copy a sorted sequence into the internal layout.
+   *
+   * @param spot Iterator for the source sequence, updated in place.
+   * @param idx Target index.
+   * @param n Number of elements.
+   * @param min Range minimums.
+   * @param max Range maximums.
+   * @param payload Payloads.
+   */
+  template<typename I>
+  static void fill(I& spot, size_t idx, size_t n, METRIC *min, METRIC *max, PAYLOAD *payload);
+};
+
+template<typename METRIC, typename PAYLOAD>
+DiscreteFlatSpace<METRIC, PAYLOAD>::DiscreteFlatSpace(space_type const& space) {
+  if (auto n = space.count(); n > 0) {
+    // Round the sizes to preserve alignment, as the arena does not.
+    auto round = [](size_t s) { return (s + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1); };
+    ++n; // slot 0 is unused.
+    _arena.require(round(sizeof(METRIC) * n) * 2 + round(sizeof(PAYLOAD) * n));
+    auto max     = static_cast<METRIC *>(_arena.alloc(round(sizeof(METRIC) * n)).data());
+    auto min     = static_cast<METRIC *>(_arena.alloc(round(sizeof(METRIC) * n)).data());
+    auto payload = static_cast<PAYLOAD *>(_arena.alloc(round(sizeof(PAYLOAD) * n)).data());
+    // Slot 0 is not used. The metrics are valid objects to keep the search simple, the payload
+    // is only zeroed so that @a PAYLOAD need not be default constructible.
+    new (max) METRIC{};
+    new (min) METRIC{};
+    memset(static_cast<void *>(payload), 0, sizeof(PAYLOAD));
+    auto spot = space.begin();
+    fill(spot, 1, n - 1, min, max, payload);
+    _min     = {min, n};
+    _max     = {max, n};
+    _payload = {payload, n};
+  }
+}
+
+template<typename METRIC, typename PAYLOAD>
+DiscreteFlatSpace<METRIC, PAYLOAD>::DiscreteFlatSpace(MemSpan<METRIC const> min, MemSpan<METRIC const> max
+                                                      , MemSpan<PAYLOAD const> payload)
+    : _min(min), _max(max), _payload(payload) {}
+
+template<typename METRIC, typename PAYLOAD>
+DiscreteFlatSpace<METRIC, PAYLOAD>::DiscreteFlatSpace(self_type&& that)
+    : _min(that._min), _max(that._max), _payload(that._payload), _arena(std::move(that._arena)) {
+  that._min.clear();
+  that._max.clear();
+  that._payload.clear();
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteFlatSpace<METRIC, PAYLOAD>::operator=(self_type&& that) -> self_type& {
+  if (this != &that) {
+    this->destroy_payloads();
+    _min     = that._min;
+    _max     = that._max;
+    _payload = that._payload;
+    _arena   = std::move(that._arena);
+    that._min.clear();
+    that._max.clear();
+    that._payload.clear();
+  }
+  return *this;
+}
+
+template<typename METRIC, typename PAYLOAD> DiscreteFlatSpace<METRIC, PAYLOAD>::~DiscreteFlatSpace() {
+  this->destroy_payloads();
+}
+
+template<typename METRIC, typename PAYLOAD>
+void
+DiscreteFlatSpace<METRIC, PAYLOAD>::destroy_payloads() {
+  if constexpr (!std::is_trivially_destructible_v<PAYLOAD>) {
+    // Only payloads that were constructed in the arena are owned.
+    if (_payload.count() && _arena.contains(_payload.data())) {
+      for (auto& p : _payload.subspan(1, _payload.count() - 1)) { // slot 0 was not constructed.
+        std::destroy_at(&p);
+      }
+    }
+  }
+}
+
+template<typename METRIC, typename PAYLOAD>
+template<typename I>
+void
+DiscreteFlatSpace<METRIC, PAYLOAD>::fill(I& spot, size_t idx, size_t n, METRIC *min, METRIC *max, PAYLOAD *payload) {
+  // In order traversal of the implicit tree, consuming the sorted source as each node is visited.
+  if (idx <= n) {
+    fill(spot, 2 * idx, n, min, max, payload);
+    new (min + idx) METRIC{spot->min()};
+    new (max + idx) METRIC{spot->max()};
+    new (payload + idx) PAYLOAD{spot->payload()};
+    ++spot;
+    fill(spot, 2 * idx + 1, n, min, max, payload);
+  }
+}
+
+template<typename METRIC, typename PAYLOAD>
+size_t
+DiscreteFlatSpace<METRIC, PAYLOAD>::search(METRIC const& metric) const {
+  auto const n   = this->count();
+  auto const max = _max.data();
+  size_t idx     = 1;
+  // Find the first range with a maximum not less than @a metric. The comparison result is used
+  // to select the child so that there is no data dependent branch in the loop. Prefetch the
+  // descendants several levels down, as they are adjacent in memory.
+  while (idx <= n) {
+    __builtin_prefetch(max + std::min(idx * PREFETCH_STRIDE, n));
+    idx = 2 * idx + (max[idx] < metric);
+  }
+  // Undo the right turns taken after the last left turn, which was the last element not less
+  // than @a metric. If there was no left turn, this yields 0.
+  idx >>= __builtin_ctzll(~idx) + 1;
+  return (idx != 0 && _min[idx] <= metric) ? idx : 0;
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteFlatSpace<METRIC, PAYLOAD>::find(METRIC const& metric) const -> const_iterator {
+  return {this, this->search(metric)};
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteFlatSpace<METRIC, PAYLOAD>::begin() const -> const_iterator {
+  size_t idx = 0;
+  if (auto n = this->count(); n > 0) {
+    for (idx = 1; 2 * idx <= n; idx *= 2)
+      ;
+  }
+  return {this, idx};
+}
+
+template<typename METRIC, typename PAYLOAD>
+size_t
+DiscreteFlatSpace<METRIC, PAYLOAD>::next_idx(size_t idx) const {
+  auto const n = this->count();
+  if (2 * idx + 1 <= n) { // left most descendant of the right child.
+    for (idx = 2 * idx + 1; 2 * idx <= n; idx *= 2)
+      ;
+    return idx;
+  }
+  // Climb while a right child, then the parent is next.
+  while (idx & 1) {
+    idx >>= 1;
+  }
+  return idx >> 1;
+}
+
+template<typename METRIC, typename PAYLOAD>
+size_t
+DiscreteFlatSpace<METRIC, PAYLOAD>::prev_idx(size_t idx) const {
+  auto const n = this->count();
+  if (2 * idx <= n) { // right most descendant of the left child.
+    for (idx = 2 * idx; 2 * idx + 1 <= n; idx = 2 * idx + 1)
+      ;
+    return idx;
+  }
+  // Climb while a left child, then the parent is previous.
+  while (idx && 0 == (idx & 1)) {
+    idx >>= 1;
+  }
+  return idx >> 1;
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteFlatSpace<METRIC, PAYLOAD>::const_iterator::operator++() -> self_type& {
+  _idx = _space->next_idx(_idx);
+  return *this;
+}
+
+template<typename METRIC, typename PAYLOAD>
+auto
+DiscreteFlatSpace<METRIC, PAYLOAD>::const_iterator::operator--() -> self_type& {
+  if (_idx == 0) { // end -> last element
+    if (auto n = _space->count(); n > 0) {
+      for (_idx = 1; 2 * _idx + 1 <= n; _idx = 2 * _idx + 1)
+        ;
+    }
+  } else {
+    _idx = _space->prev_idx(_idx);
+  }
+  return *this;
+}
+
 }} // namespace swoc
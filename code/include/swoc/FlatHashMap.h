@@ -0,0 +1,582 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Open addressing hash map.
+
+    A hash map of pointers to objects that does not require links in the objects. This uses the same
+    descriptors as @c IntrusiveHashMap.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "swoc/swoc_version.h"
+#include "swoc/MemArena.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+namespace detail {
+/// Deduce the value type from the argument type of a descriptor @c key_of.
+template<typename R, typename V> V FlatHashMapValueOf(R (*)(V *));
+} // namespace detail
+
+/** Open addressing hash map.
+
+    This stores pointers to values in a flat array of slots with a parallel array of control bytes, one per slot. The
+    control byte for a slot marks the slot as empty, deleted, or holding a value, and for a value contains 7 bits of
+    the hash. Slots are probed in groups of 16, comparing the control bytes for the group at once (with SSE2 if
+    available) so that a lookup compares keys only for slots with matching hash bits, and a miss is typically decided
+    by reading a single group of control bytes. Compared to @c IntrusiveHashMap this has far fewer cache misses per
+    lookup, especially for misses, and the values do not need link members. It is better suited for tables that are
+    mostly read.
+
+    The map is configured with a descriptor, which must have the members
+
+    - <tt>key_type key_of(value_type *)</tt> which returns the key for a value.
+    - <tt>hash_id hash_of(key_type)</tt> which computes the hash of a key.
+    - <tt>bool equal(key_type lhs, key_type rhs)</tt> which checks if two keys are the same.
+
+    These are a subset of the @c IntrusiveHashMap descriptor members and so a descriptor for that can be used. The value
+    type is deduced from @c key_of unless @c key_of is overloaded, in which case @a V must be specified.
+
+    Unlike @c IntrusiveHashMap, keys are unique. An attempt to insert a value with the same key as a value already in
+    the map fails. Inserting a value can invalidate iterators, erasing does not. The values are not owned by the map.
+
+    The slot storage can be allocated from a @c MemArena. In that case storage released when the map grows is not
+    reclaimed until the arena is, so this is best for maps that are sized once.
+
+    @tparam H Descriptor.
+    @tparam V Value type.
+ */
+template<typename H, typename V = std::remove_const_t<decltype(detail::FlatHashMapValueOf(&H::key_of))>> class FlatHashMap {
+  using self_type = FlatHashMap;
+
+public:
+  /// Type of values in the map.
+  using value_type = V;
+  /// Key type for the values.
+  using key_type = decltype(H::key_of(static_cast<value_type *>(nullptr)));
+  /// The numeric hash ID computed from a key.
+  using hash_id = decltype(H::hash_of(H::key_of(static_cast<value_type *>(nullptr))));
+
+  /// Number of slots in a probe group.
+  static constexpr size_t GROUP_SIZE = 16;
+
+protected:
+  /// Iterator implementation, @a T is @c value_type or @c value_type @c const.
+  template<typename T> class iterator_base {
+    friend class FlatHashMap;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = T;
+    using difference_type   = ptrdiff_t;
+    using pointer           = T *;
+    using reference         = T&;
+
+    iterator_base() = default;
+
+    /// Conversion from non-const to const iterator.
+    template<typename U, typename = std::enable_if_t<std::is_const_v<T> && !std::is_const_v<U>>>
+    iterator_base(iterator_base<U> const& that) : _map(that._map), _idx(that._idx) {}
+
+    reference operator*() const { return *_map->_slots[_idx]; }
+    pointer operator->() const { return _map->_slots[_idx]; }
+
+    iterator_base&
+    operator++() {
+      _idx = _map->next_full(_idx + 1);
+      return *this;
+    }
+
+    iterator_base
+    operator++(int) {
+      auto zret = *this;
+      ++*this;
+      return zret;
+    }
+
+    bool operator==(iterator_base const& that) const { return _idx == that._idx && _map == that._map; }
+    bool operator!=(iterator_base const& that) const { return !(*this == that); }
+
+  protected:
+    iterator_base(FlatHashMap const *map, size_t idx) : _map(map), _idx(idx) {}
+
+    FlatHashMap const *_map = nullptr; ///< Containing map.
+    size_t _idx             = 0;       ///< Slot index.
+
+    template<typename U> friend class iterator_base;
+  };
+
+public:
+  using iterator       = iterator_base<value_type>;
+  using const_iterator = iterator_base<value_type const>;
+
+  /** Construct with capacity for @a n values.
+   *
+   * @param n Number of values to reserve space for.
+   * @param arena Arena for storage, or @c nullptr to use the heap.
+   */
+  explicit FlatHashMap(size_t n = 0, MemArena *arena = nullptr);
+
+  FlatHashMap(self_type&& that);
+  self_type& operator=(self_type&& that);
+
+  FlatHashMap(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  ~FlatHashMap();
+
+  /** Insert @a v in to the map.
+   *
+   * @param v Value to insert.
+   * @return @c true if @a v was inserted, @c false if a value with the same key is already in the map.
+   *
+   * @note The value itself is put in the map, @b not a copy.
+   */
+  bool insert(value_type *v);
+
+  /** Find the value with a key equal to @a key.
+   *
+   * @return An iterator for the value, or the end iterator if not found.
+   */
+  iterator find(key_type key);
+  const_iterator find(key_type key) const;
+
+  /** Find @a v in the map.
+   *
+   * @return An iterator for @a v, or the end iterator if @a v is not in the map.
+   */
+  iterator find(value_type const *v);
+
+  /** Remove the value at @a loc.
+   *
+   * @return An iterator for the next value.
+   */
+  iterator erase(const_iterator const& loc);
+
+  /** Remove @a v from the map.
+   *
+   * @return @c true if @a v was in the map and removed, @c false if it was not in the map.
+   */
+  bool erase(value_type const *v);
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  /// @return The number of values in the map.
+  size_t count() const;
+
+  /// @return @c true if there are no values in the map.
+  bool empty() const;
+
+  /// @return The number of slots.
+  size_t capacity() const;
+
+  /** Ensure the map can hold @a n values without allocating.
+   *
+   * @param n Number of values.
+   * @return @a this
+   */
+  self_type& reserve(size_t n);
+
+  /** Remove all values.
+   *
+   * @return @a this
+   *
+   * The storage is retained.
+   */
+  self_type& clear();
+
+protected:
+  /// Control byte values. Values have a non-negative control byte.
+  enum : int8_t {
+    EMPTY   = -128, ///< Slot has never been used.
+    DELETED = -2,   ///< Slot had a value which was erased.
+  };
+
+  /// Match masks for a group of control bytes.
+  class Group {
+  public:
+    explicit Group(int8_t const *ctrl);
+
+    /// @return Mask of slots with control byte @a h2.
+    uint32_t match(int8_t h2) const;
+    /// @return Mask of slots that are empty.
+    uint32_t match_empty() const;
+    /// @return Mask of slots that do not have values.
+    uint32_t match_available() const;
+
+  protected:
+#if defined(__SSE2__)
+    __m128i _ctrl; ///< Control bytes.
+#else
+    int8_t const *_ctrl; ///< Control bytes.
+#endif
+  };
+
+  /// Location of a key in the table.
+  struct Probe {
+    int8_t _h2;    ///< Control byte value.
+    size_t _group; ///< Initial group.
+  };
+
+  /// Maximum number of used slots (values and deleted) for @a capacity slots.
+  static constexpr size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+  /// @return The probe start for @a key.
+  Probe probe_for(key_type key) const;
+
+  /// @return The slot index for @a key, or @a _capacity if not found.
+  size_t search(key_type key) const;
+
+  /// @return The index of the first slot with a value at or after @a idx, or @a _capacity if none.
+  size_t next_full(size_t idx) const;
+
+  /// Put @a v in the first available slot. There must be an available slot.
+  void place(value_type *v);
+
+  /// Change the number of slots to @a capacity and reinsert the values.
+  void resize(size_t capacity);
+
+  /// Remove the value in slot @a idx.
+  void erase_slot(size_t idx);
+
+  /// Release the storage.
+  void release();
+
+  value_type **_slots = nullptr; ///< Slots.
+  int8_t *_ctrl       = nullptr; ///< Control bytes, one per slot.
+  size_t _capacity    = 0;       ///< Number of slots, 0 or a power of 2 multiple of @c GROUP_SIZE.
+  size_t _count       = 0;       ///< Number of values.
+  size_t _deleted     = 0;       ///< Number of deleted slots.
+  MemArena *_arena    = nullptr; ///< Arena for storage, if any.
+};
+
+// --- Implementation ---
+
+template<typename H, typename V> FlatHashMap<H, V>::Group::Group(int8_t const *ctrl) {
+#if defined(__SSE2__)
+  _ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ctrl));
+#else
+  _ctrl = ctrl;
+#endif
+}
+
+template<typename H, typename V>
+uint32_t
+FlatHashMap<H, V>::Group::match(int8_t h2) const {
+#if defined(__SSE2__)
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(_ctrl, _mm_set1_epi8(h2)));
+#else
+  uint32_t zret = 0;
+  for (unsigned idx = 0; idx < GROUP_SIZE; ++idx) {
+    zret |= uint32_t(_ctrl[idx] == h2) << idx;
+  }
+  return zret;
+#endif
+}
+
+template<typename H, typename V>
+uint32_t
+FlatHashMap<H, V>::Group::match_empty() const {
+  return this->match(EMPTY);
+}
+
+template<typename H, typename V>
+uint32_t
+FlatHashMap<H, V>::Group::match_available() const {
+#if defined(__SSE2__)
+  return _mm_movemask_epi8(_ctrl); // high bit set for both EMPTY and DELETED.
+#else
+  uint32_t zret = 0;
+  for (unsigned idx = 0; idx < GROUP_SIZE; ++idx) {
+    zret |= uint32_t(_ctrl[idx] < 0) << idx;
+  }
+  return zret;
+#endif
+}
+
+template<typename H, typename V> FlatHashMap<H, V>::FlatHashMap(size_t n, MemArena *arena) : _arena(arena) {
+  this->reserve(n);
+}
+
+template<typename H, typename V>
+FlatHashMap<H, V>::FlatHashMap(self_type&& that)
+  : _slots(that._slots), _ctrl(that._ctrl), _capacity(that._capacity), _count(that._count), _deleted(that._deleted), _arena(that._arena) {
+  that._slots    = nullptr;
+  that._ctrl     = nullptr;
+  that._capacity = that._count = that._deleted = 0;
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::operator=(self_type&& that) -> self_type& {
+  if (this != &that) {
+    this->release();
+    _slots         = that._slots;
+    _ctrl          = that._ctrl;
+    _capacity      = that._capacity;
+    _count         = that._count;
+    _deleted       = that._deleted;
+    _arena         = that._arena;
+    that._slots    = nullptr;
+    that._ctrl     = nullptr;
+    that._capacity = that._count = that._deleted = 0;
+  }
+  return *this;
+}
+
+template<typename H, typename V> FlatHashMap<H, V>::~FlatHashMap() {
+  this->release();
+}
+
+template<typename H, typename V>
+void
+FlatHashMap<H, V>::release() {
+  if (nullptr == _arena) {
+    ::free(_slots);
+  }
+  _slots = nullptr;
+  _ctrl  = nullptr;
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::probe_for(key_type key) const -> Probe {
+  // Fibonacci hashing - the top bits of the product depend on every bit of the hash. The top
+  // log2(groups) bits select the group and the 7 bits below those are the control byte.
+  uint64_t mixed = static_cast<uint64_t>(H::hash_of(key)) * 0x9E3779B97F4A7C15ULL;
+  size_t groups  = _capacity / GROUP_SIZE;
+  unsigned bits  = groups > 1 ? __builtin_ctzll(groups) : 0;
+  return {static_cast<int8_t>((mixed >> (57 - bits)) & 0x7F), bits ? size_t(mixed >> (64 - bits)) : 0};
+}
+
+template<typename H, typename V>
+size_t
+FlatHashMap<H, V>::search(key_type key) const {
+  if (_count == 0) {
+    return _capacity;
+  }
+  auto [h2, group] = this->probe_for(key);
+  size_t mask      = _capacity / GROUP_SIZE - 1;
+  // Triangular probing visits every group because the number of groups is a power of 2.
+  for (size_t step = 1;; ++step) {
+    Group g(_ctrl + group * GROUP_SIZE);
+    for (auto m = g.match(h2); m; m &= m - 1) {
+      size_t idx = group * GROUP_SIZE + __builtin_ctz(m);
+      if (H::equal(key, H::key_of(_slots[idx]))) {
+        return idx;
+      }
+    }
+    if (g.match_empty()) { // key would have been put here if it was in the map.
+      return _capacity;
+    }
+    group = (group + step) & mask;
+  }
+}
+
+template<typename H, typename V>
+size_t
+FlatHashMap<H, V>::next_full(size_t idx) const {
+  while (idx < _capacity && _ctrl[idx] < 0) {
+    ++idx;
+  }
+  return idx;
+}
+
+template<typename H, typename V>
+void
+FlatHashMap<H, V>::place(value_type *v) {
+  auto [h2, group] = this->probe_for(H::key_of(v));
+  size_t mask      = _capacity / GROUP_SIZE - 1;
+  for (size_t step = 1;; ++step) {
+    if (auto m = Group(_ctrl + group * GROUP_SIZE).match_available(); m) {
+      size_t idx = group * GROUP_SIZE + __builtin_ctz(m);
+      if (_ctrl[idx] == DELETED) {
+        --_deleted;
+      }
+      _ctrl[idx]  = h2;
+      _slots[idx] = v;
+      ++_count;
+      return;
+    }
+    group = (group + step) & mask;
+  }
+}
+
+template<typename H, typename V>
+void
+FlatHashMap<H, V>::resize(size_t capacity) {
+  auto old_slots    = _slots;
+  auto old_ctrl     = _ctrl;
+  auto old_capacity = _capacity;
+
+  // Slots and control bytes are allocated together, slots first for alignment.
+  size_t n = capacity * (sizeof(value_type *) + 1);
+  void *mem;
+  if (_arena) {
+    auto span = _arena->alloc(n + alignof(value_type *) - 1);
+    auto addr = reinterpret_cast<uintptr_t>(span.data());
+    mem       = reinterpret_cast<void *>((addr + alignof(value_type *) - 1) & ~(uintptr_t(alignof(value_type *)) - 1));
+  } else {
+    mem = ::malloc(n);
+  }
+  _slots    = static_cast<value_type **>(mem);
+  _ctrl     = reinterpret_cast<int8_t *>(_slots + capacity);
+  _capacity = capacity;
+  _count = _deleted = 0;
+  memset(_ctrl, EMPTY, capacity);
+
+  for (size_t idx = 0; idx < old_capacity; ++idx) {
+    if (old_ctrl[idx] >= 0) {
+      this->place(old_slots[idx]);
+    }
+  }
+  if (nullptr == _arena) {
+    ::free(old_slots);
+  }
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::reserve(size_t n) -> self_type& {
+  size_t capacity = _capacity ? _capacity : GROUP_SIZE;
+  while (max_load(capacity) < n) {
+    capacity <<= 1;
+  }
+  if (n > 0 && capacity != _capacity) {
+    this->resize(capacity);
+  }
+  return *this;
+}
+
+template<typename H, typename V>
+bool
+FlatHashMap<H, V>::insert(value_type *v) {
+  if (this->search(H::key_of(v)) != _capacity) {
+    return false;
+  }
+  if (_count + _deleted + 1 > max_load(_capacity)) {
+    // If much of the load is deleted slots, clean up rather than grow.
+    this->resize(_capacity == 0 ? GROUP_SIZE : (_count + 1 > max_load(_capacity) / 2 ? _capacity * 2 : _capacity));
+  }
+  this->place(v);
+  return true;
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::find(key_type key) -> iterator {
+  return {this, this->search(key)};
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::find(key_type key) const -> const_iterator {
+  return {this, this->search(key)};
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::find(value_type const *v) -> iterator {
+  size_t idx = this->search(H::key_of(const_cast<value_type *>(v)));
+  return {this, (idx < _capacity && _slots[idx] == v) ? idx : _capacity};
+}
+
+template<typename H, typename V>
+void
+FlatHashMap<H, V>::erase_slot(size_t idx) {
+  // If the group has an empty slot a search for any key in the group stops there, so the slot can
+  // be made empty. Otherwise a search may need to continue past this group.
+  if (Group(_ctrl + (idx & ~(GROUP_SIZE - 1))).match_empty()) {
+    _ctrl[idx] = EMPTY;
+  } else {
+    _ctrl[idx] = DELETED;
+    ++_deleted;
+  }
+  --_count;
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::erase(const_iterator const& loc) -> iterator {
+  this->erase_slot(loc._idx);
+  return {this, this->next_full(loc._idx + 1)};
+}
+
+template<typename H, typename V>
+bool
+FlatHashMap<H, V>::erase(value_type const *v) {
+  if (auto spot = this->find(v); spot != this->end()) {
+    this->erase_slot(spot._idx);
+    return true;
+  }
+  return false;
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::begin() -> iterator {
+  return {this, this->next_full(0)};
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::end() -> iterator {
+  return {this, _capacity};
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::begin() const -> const_iterator {
+  return {this, this->next_full(0)};
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::end() const -> const_iterator {
+  return {this, _capacity};
+}
+
+template<typename H, typename V>
+size_t
+FlatHashMap<H, V>::count() const {
+  return _count;
+}
+
+template<typename H, typename V>
+bool
+FlatHashMap<H, V>::empty() const {
+  return _count == 0;
+}
+
+template<typename H, typename V>
+size_t
+FlatHashMap<H, V>::capacity() const {
+  return _capacity;
+}
+
+template<typename H, typename V>
+auto
+FlatHashMap<H, V>::clear() -> self_type& {
+  if (_capacity) {
+    memset(_ctrl, EMPTY, _capacity);
+  }
+  _count = _deleted = 0;
+  return *this;
+}
+
+}} // namespace swoc
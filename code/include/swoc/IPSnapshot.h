@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Persistent, memory mappable snapshots of IP spaces.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "swoc/swoc_version.h"
+#include "swoc/MemSpan.h"
+#include "swoc/MemArena.h"
+#include "swoc/TextView.h"
+#include "swoc/Errata.h"
+#include "swoc/swoc_file.h"
+#include "swoc/swoc_ip.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+/** Reference to data in the blob table of an IP snapshot.
+ *
+ * This is used as (or in) a snapshot payload for data of variable size, such as strings. It is
+ * an offset and size in to the blob table and is therefore valid in any process that maps the
+ * snapshot.
+ */
+struct IPBlobRef {
+  uint32_t _offset = 0; ///< Offset of the data in the blob table.
+  uint32_t _size   = 0; ///< Size of the data in bytes.
+
+  /// Equality.
+  bool operator==(IPBlobRef const& that) const { return _offset == that._offset && _size == that._size; }
+
+  /// Inequality.
+  bool operator!=(IPBlobRef const& that) const { return !(*this == that); }
+};
+
+/** Builder for the blob table of an IP snapshot.
+ *
+ * Data added to the table is copied and a reference to the copy in the table is returned.
+ * Identical data is stored only once, so that, e.g., a small set of strings used as payloads for
+ * a large number of ranges consumes only the space for the distinct strings.
+ */
+class IPBlobTable {
+  using self_type = IPBlobTable; ///< Self reference type.
+
+public:
+  IPBlobTable() = default;
+
+  /** Add @a data to the table.
+   *
+   * @param data Data to add.
+   * @return A reference to the data in the table.
+   *
+   * @throw std::length_error if the table would be larger than a reference can address (4GB).
+   */
+  IPBlobRef add(std::string_view data);
+
+  /// @return The size of the table in bytes.
+  size_t size() const { return _size; }
+
+  /// @return The items in the table, in order.
+  std::vector<std::string_view> const& items() const { return _items; }
+
+protected:
+  MemArena _arena;                                   ///< Storage for the data.
+  std::vector<std::string_view> _items;              ///< Data in table order.
+  std::unordered_map<std::string_view, IPBlobRef> _map; ///< Data to reference, for duplicate detection.
+  size_t _size = 0;                                  ///< Size of table.
+};
+
+/** A persistent IP space file.
+ *
+ * This handles the file format, independent of the payload type. The file is a header followed by
+ * sections. Each section is aligned to a cache line and is the in memory layout of a
+ * @c DiscreteFlatSpace array or the blob table. The file can therefore be memory mapped read only
+ * and used directly without parsing, which means processes that map the same file share a single
+ * copy in the page cache.
+ *
+ * Data is stored in host order, the file is rejected if the byte order of the writer was
+ * different. The header and each section are checksummed. The header checksum is always verified
+ * but section verification is optional as it requires reading the entire file.
+ *
+ * @see IPSnapshot
+ */
+class IPSnapshotFile {
+  using self_type = IPSnapshotFile; ///< Self reference type.
+
+public:
+  static constexpr uint32_t MAGIC      = 0x53504943; ///< Identify the file type ("CIPS").
+  static constexpr uint32_t VERSION    = 1;          ///< Format version.
+  static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304; ///< Byte order mark.
+  static constexpr size_t ALIGN        = 64;         ///< Section alignment.
+
+  /// File sections.
+  enum Section : unsigned {
+    IP4_MAX,     ///< IPv4 range maximums.
+    IP4_MIN,     ///< IPv4 range minimums.
+    IP4_PAYLOAD, ///< IPv4 range payloads.
+    IP6_MAX,     ///< IPv6 range maximums.
+    IP6_MIN,     ///< IPv6 range minimums.
+    IP6_PAYLOAD, ///< IPv6 range payloads.
+    BLOB,        ///< Blob table.
+    N_SECTIONS   ///< Number of sections.
+  };
+
+  /// Location of a section in the file.
+  struct SectionInfo {
+    uint64_t _offset   = 0; ///< Offset from the start of the file.
+    uint64_t _size     = 0; ///< Size in bytes.
+    uint64_t _checksum = 0; ///< Checksum of the section data.
+  };
+
+  /// File header.
+  struct Header {
+    uint32_t _magic         = MAGIC;      ///< File type identifier.
+    uint32_t _version       = VERSION;    ///< Format version.
+    uint32_t _byte_order    = BYTE_ORDER_MARK; ///< Byte order mark, in writer host order.
+    uint32_t _header_size   = sizeof(Header); ///< Size of this header.
+    uint32_t _payload_size  = 0; ///< Size of a payload instance.
+    uint32_t _payload_align = 0; ///< Alignment of payload type.
+    uint64_t _ip4_count     = 0; ///< Number of IPv4 ranges.
+    uint64_t _ip6_count     = 0; ///< Number of IPv6 ranges.
+    SectionInfo _sections[N_SECTIONS]; ///< Section locations.
+    uint64_t _checksum = 0; ///< Checksum of the header, computed with this member set to zero.
+  };
+
+  IPSnapshotFile() = default;
+  IPSnapshotFile(self_type const& that) = delete;
+  IPSnapshotFile(self_type&& that);
+  self_type& operator=(self_type const& that) = delete;
+  self_type& operator=(self_type&& that);
+
+  /// Unmap / release the content.
+  ~IPSnapshotFile();
+
+  /** Memory map the file at @a path.
+   *
+   * @param path File to map.
+   * @param verify_p Verify the section checksums.
+   * @return Errors, if any.
+   *
+   * The file is mapped read only and shared.
+   */
+  Errata map(file::path const& path, bool verify_p = true);
+
+  /** Load the file at @a path in to memory.
+   *
+   * @param path File to load.
+   * @param verify_p Verify the section checksums.
+   * @return Errors, if any.
+   *
+   * This reads the file in to memory owned by this instance, for cases where mapping is not
+   * possible or not desirable.
+   */
+  Errata load(file::path const& path, bool verify_p = true);
+
+  /// Release the content.
+  self_type& clear();
+
+  /// @return The file header. Valid only if a file was successfully mapped or loaded.
+  Header const& header() const { return *reinterpret_cast<Header const *>(_content.data()); }
+
+  /** Access a section.
+   *
+   * @param idx Section index.
+   * @return The section content.
+   */
+  MemSpan<char const> section(Section idx) const;
+
+  /** Access blob data.
+   *
+   * @param ref Reference to the data.
+   * @return A view of the data.
+   *
+   * @a ref is assumed to be valid for the blob table.
+   */
+  TextView blob(IPBlobRef const& ref) const;
+
+  /** Write a snapshot file.
+   *
+   * @param path Destination path.
+   * @param hdr Header. The sections sizes, counts, and payload properties must be set.
+   * @param sections Section data, in section order.
+   * @return Errors, if any.
+   *
+   * The offsets and checksums in @a hdr are updated.
+   */
+  static Errata store(file::path const& path, Header& hdr, MemSpan<char const> const (&sections)[N_SECTIONS]);
+
+  /** Compute the checksum of @a data.
+   *
+   * @param data Data to check.
+   * @return The checksum.
+   */
+  static uint64_t checksum(std::string_view data);
+
+protected:
+  MemSpan<char const> _content; ///< File content.
+  std::string _text;            ///< Content storage if loaded, not mapped.
+  bool _mapped_p = false;       ///< Content was mapped.
+
+  /** Validate the content.
+   *
+   * @param path File path, for error messages.
+   * @param verify_p Verify the section checksums.
+   * @return Errors, if any.
+   */
+  Errata validate(file::path const& path, bool verify_p);
+};
+
+/** A persistent, memory mappable snapshot of an IP space.
+ *
+ * @tparam PAYLOAD Payload type. This must be trivially copyable.
+ *
+ * A snapshot is a @c IPFlatSpace stored in a file such that it can be memory mapped and used in
+ * place. Payloads that are not trivially copyable are not supported directly, but data of variable
+ * size can be stored in the blob table via @c IPBlobTable and referenced by @c IPBlobRef values in
+ * the payload.
+ *
+ * @code
+ * IPSpace<std::string> src; // ... load ...
+ * IPBlobTable blobs;
+ * IPSpace<IPBlobRef> space;
+ * for ( auto && [ range, payload ] : src ) {
+ *   space.mark(range, blobs.add(payload));
+ * }
+ * IPSnapshot<IPBlobRef>::store(path, IPFlatSpace<IPBlobRef>{space}, &blobs);
+ * // ... and then, in another process ...
+ * IPSnapshot<IPBlobRef> snap;
+ * snap.map(path);
+ * if (auto spot = snap.space().find(addr) ; spot != snap.space().end()) {
+ *   TextView text = snap.blob(std::get<1>(*spot));
+ * }
+ * @endcode
+ */
+template<typename PAYLOAD> class IPSnapshot : public IPSnapshotFile {
+  using self_type  = IPSnapshot;     ///< Self reference type.
+  using super_type = IPSnapshotFile; ///< Parent type.
+  static_assert(std::is_trivially_copyable_v<PAYLOAD>, "IPSnapshot payloads must be trivially copyable");
+
+public:
+  using space_type = IPFlatSpace<PAYLOAD>; ///< Type of mapped space.
+
+  IPSnapshot() = default;
+
+  /** Memory map the snapshot at @a path.
+   *
+   * @param path File to map.
+   * @param verify_p Verify the section checksums.
+   * @return Errors, if any.
+   */
+  Errata map(file::path const& path, bool verify_p = true);
+
+  /** Load the snapshot at @a path in to memory.
+   *
+   * @param path File to load.
+   * @param verify_p Verify the section checksums.
+   * @return Errors, if any.
+   */
+  Errata load(file::path const& path, bool verify_p = true);
+
+  /// Release the content.
+  self_type& clear();
+
+  /// @return The IP space in the snapshot.
+  space_type const& space() const { return _space; }
+
+  /** Write a snapshot.
+   *
+   * @param path Destination path.
+   * @param space Source space.
+   * @param blobs Blob table, if any.
+   * @return Errors, if any.
+   */
+  static Errata store(file::path const& path, space_type const& space, IPBlobTable const *blobs = nullptr);
+
+protected:
+  space_type _space; ///< Space over the snapshot content.
+
+  /// Check the payload properties and set up the space.
+  Errata attach(file::path const& path);
+
+  /// Rebind section @a idx as an array of @a T.
+  template<typename T>
+  MemSpan<T const>
+  span_of(Section idx) const {
+    auto span = this->section(idx);
+    return {reinterpret_cast<T const *>(span.data()), span.size() / sizeof(T)};
+  }
+};
+
+template<typename PAYLOAD>
+auto
+IPSnapshot<PAYLOAD>::clear() -> self_type& {
+  _space = space_type{}; // drop references to the content before releasing it.
+  this->super_type::clear();
+  return *this;
+}
+
+template<typename PAYLOAD>
+Errata
+IPSnapshot<PAYLOAD>::map(file::path const& path, bool verify_p) {
+  _space = space_type{};
+  auto zret = this->super_type::map(path, verify_p);
+  return zret.is_ok() ? this->attach(path) : zret;
+}
+
+template<typename PAYLOAD>
+Errata
+IPSnapshot<PAYLOAD>::load(file::path const& path, bool verify_p) {
+  _space = space_type{};
+  auto zret = this->super_type::load(path, verify_p);
+  return zret.is_ok() ? this->attach(path) : zret;
+}
+
+template<typename PAYLOAD>
+Errata
+IPSnapshot<PAYLOAD>::attach(file::path const& path) {
+  auto const& hdr = this->header();
+  if (hdr._payload_size != sizeof(PAYLOAD) || hdr._payload_align != alignof(PAYLOAD)) {
+    auto zret = Errata().error(R"(IP snapshot "{}" payload size {} align {} does not match expected size {} align {}.)", path
+                               , hdr._payload_size, hdr._payload_align, sizeof(PAYLOAD), alignof(PAYLOAD));
+    this->clear();
+    return zret;
+  }
+  // The arrays have an unused element at index 0.
+  auto n4 = hdr._ip4_count ? hdr._ip4_count + 1 : 0;
+  auto n6 = hdr._ip6_count ? hdr._ip6_count + 1 : 0;
+  typename space_type::IP4Space ip4{this->span_of<IP4Addr>(IP4_MIN), this->span_of<IP4Addr>(IP4_MAX)
+                                    , this->span_of<PAYLOAD>(IP4_PAYLOAD)};
+  typename space_type::IP6Space ip6{this->span_of<IP6Addr>(IP6_MIN), this->span_of<IP6Addr>(IP6_MAX)
+                                    , this->span_of<PAYLOAD>(IP6_PAYLOAD)};
+  if (ip4.min_span().count() != n4 || ip4.max_span().count() != n4 || ip4.payload_span().count() != n4 ||
+      ip6.min_span().count() != n6 || ip6.max_span().count() != n6 || ip6.payload_span().count() != n6) {
+    this->clear();
+    return Errata().error(R"(IP snapshot "{}" section sizes do not match the range counts.)", path);
+  }
+  _space = space_type{std::move(ip4), std::move(ip6)};
+  return {};
+}
+
+template<typename PAYLOAD>
+Errata
+IPSnapshot<PAYLOAD>::store(file::path const& path, space_type const& space, IPBlobTable const *blobs) {
+  Header hdr;
+  hdr._payload_size  = sizeof(PAYLOAD);
+  hdr._payload_align = alignof(PAYLOAD);
+  hdr._ip4_count     = space.count_ip4();
+  hdr._ip6_count     = space.count_ip6();
+
+  // Blobs are kept in separate chunks while building, they must be made contiguous to write.
+  std::string blob_data;
+  if (blobs) {
+    blob_data.reserve(blobs->size());
+    for (auto const& item : blobs->items()) {
+      blob_data.append(item);
+    }
+  }
+
+  auto bytes_of = [](auto span) -> MemSpan<char const> {
+    return {reinterpret_cast<char const *>(span.data()), span.size()};
+  };
+  MemSpan<char const> const sections[N_SECTIONS] = {
+    bytes_of(space.ip4().max_span()), bytes_of(space.ip4().min_span()), bytes_of(space.ip4().payload_span()),
+    bytes_of(space.ip6().max_span()), bytes_of(space.ip6().min_span()), bytes_of(space.ip6().payload_span()),
+    {blob_data.data(), blob_data.size()}};
+
+  return super_type::store(path, hdr, sections);
+}
+
+}} // namespace swoc
@@ -0,0 +1,391 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Parallel construction of discrete and IP spaces.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "swoc/swoc_version.h"
+#include "swoc/DiscreteRange.h"
+#include "swoc/swoc_ip.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+/** Parallel builder for a @c DiscreteSpace.
+ *
+ * @tparam METRIC Metric type of the space.
+ * @tparam PAYLOAD Payload type of the space.
+ * @tparam U Color type for blending.
+ *
+ * Operations are recorded and then applied by @c build. The metric domain is split in to
+ * partitions at quantiles of the operation ranges, each operation is clipped to the partitions it
+ * touches, and each partition is built in its own space by a pool of threads. The partitions are
+ * then bulk loaded in order in to the target space, which coalesces ranges across partition
+ * boundaries.
+ *
+ * Every operation on a space acts on each metric value independently, so applying the clipped
+ * operations in order in each partition yields exactly the same ranges and payloads as applying
+ * the operations in order to a single space.
+ */
+template <typename METRIC, typename PAYLOAD, typename U = PAYLOAD> class DiscreteSpaceBuilder {
+  using self_type = DiscreteSpaceBuilder; ///< Self reference type.
+public:
+  using space_type = DiscreteSpace<METRIC, PAYLOAD>; ///< Target space type.
+  using range_type = DiscreteRange<METRIC>;          ///< Range type.
+
+  /// Number of partitions per thread, so threads that finish early can take more work.
+  static constexpr unsigned PARTITIONS_PER_THREAD = 8;
+
+  /// Record a @c mark of @a range with @a payload.
+  self_type& mark(range_type const& range, PAYLOAD const& payload);
+
+  /// Record a @c fill of @a range with @a payload.
+  self_type& fill(range_type const& range, PAYLOAD const& payload);
+
+  /// Record an @c erase of @a range.
+  self_type& erase(range_type const& range);
+
+  /** Record a @c blend of @a color in to @a range.
+   *
+   * The blending functor is provided to @c build.
+   */
+  self_type& blend(range_type const& range, U const& color);
+
+  /// @return The number of recorded operations.
+  size_t count() const { return _ops.size(); }
+
+  /// Discard all recorded operations.
+  self_type& clear();
+
+  /** Apply the recorded operations to @a space.
+   *
+   * @tparam F Blending functor type.
+   * @param space Target space.
+   * @param blender Functor for @c blend operations, as for @c DiscreteSpace::blend.
+   * @param n_threads Number of threads to use, 0 for the hardware concurrency.
+   * @return @a space
+   *
+   * The result is identical to applying the operations in order to @a space. Existing content in
+   * @a space is kept and the operations are applied on top of it. The recorded operations are
+   * kept and @a blender must be safe to call concurrently.
+   */
+  template <typename F> space_type& build(space_type& space, F&& blender, unsigned n_threads = 0) const;
+
+  /** Apply the recorded operations to @a space.
+   *
+   * @param space Target space.
+   * @param n_threads Number of threads to use, 0 for the hardware concurrency.
+   * @return @a space
+   *
+   * There must be no @c blend operations.
+   */
+  space_type& build(space_type& space, unsigned n_threads = 0) const;
+
+protected:
+  /// Type of operation.
+  enum class OpType : uint8_t { MARK, FILL, ERASE, BLEND };
+
+  /// A recorded operation.
+  struct Op {
+    OpType _type;      ///< Operation.
+    range_type _range; ///< Target range.
+    PAYLOAD _payload;  ///< Payload for @c MARK and @c FILL.
+    U _color;          ///< Color for @c BLEND.
+  };
+
+  /// An operation clipped to a partition.
+  struct Clip {
+    range_type _range; ///< Clipped range.
+    size_t _idx;       ///< Index of the operation.
+  };
+
+  std::vector<Op> _ops; ///< Recorded operations.
+
+  /// Choose the partition split points for @a n_parts partitions.
+  std::vector<METRIC> split_points(size_t n_parts) const;
+};
+
+/** Parallel builder for an @c IPSpace.
+ *
+ * @tparam PAYLOAD Payload type of the space.
+ * @tparam U Color type for blending.
+ *
+ * This records operations with the same signatures as @c IPSpace and applies them in parallel. The
+ * IPv4 and IPv6 operations are built separately, each with a @c DiscreteSpaceBuilder.
+ *
+ * @code
+ *   IPSpaceBuilder<Bits, unsigned> builder;
+ *   for (auto const& [range, bit] : feed) {
+ *     builder.blend(range, bit);
+ *   }
+ *   builder.build(space, [](Bits& bits, unsigned bit) { bits[bit] = true; return true; });
+ * @endcode
+ */
+template <typename PAYLOAD, typename U = PAYLOAD> class IPSpaceBuilder {
+  using self_type = IPSpaceBuilder; ///< Self reference type.
+public:
+  using space_type = IPSpace<PAYLOAD>; ///< Target space type.
+
+  /// Record a @c mark of @a range with @a payload.
+  self_type& mark(IPRange const& range, PAYLOAD const& payload);
+
+  /// Record a @c fill of @a range with @a payload.
+  self_type& fill(IPRange const& range, PAYLOAD const& payload);
+
+  /// Record an @c erase of @a range.
+  self_type& erase(IPRange const& range);
+
+  /// Record a @c blend of @a color in to @a range.
+  self_type& blend(IPRange const& range, U const& color);
+
+  /// @return The number of recorded operations.
+  size_t count() const { return _ip4.count() + _ip6.count(); }
+
+  /// Discard all recorded operations.
+  self_type& clear();
+
+  /** Apply the recorded operations to @a space.
+   *
+   * @see DiscreteSpaceBuilder::build
+   */
+  template <typename F> space_type& build(space_type& space, F&& blender, unsigned n_threads = 0) const;
+
+  /** Apply the recorded operations to @a space.
+   *
+   * @see DiscreteSpaceBuilder::build
+   */
+  space_type& build(space_type& space, unsigned n_threads = 0) const;
+
+protected:
+  DiscreteSpaceBuilder<IP4Addr, PAYLOAD, U> _ip4; ///< IPv4 operations.
+  DiscreteSpaceBuilder<IP6Addr, PAYLOAD, U> _ip6; ///< IPv6 operations.
+};
+
+// --- Implementation
+
+template <typename METRIC, typename PAYLOAD, typename U>
+auto
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::mark(range_type const& range, PAYLOAD const& payload) -> self_type& {
+  _ops.push_back(Op{OpType::MARK, range, payload, U{}});
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD, typename U>
+auto
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::fill(range_type const& range, PAYLOAD const& payload) -> self_type& {
+  _ops.push_back(Op{OpType::FILL, range, payload, U{}});
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD, typename U>
+auto
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::erase(range_type const& range) -> self_type& {
+  _ops.push_back(Op{OpType::ERASE, range, PAYLOAD{}, U{}});
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD, typename U>
+auto
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::blend(range_type const& range, U const& color) -> self_type& {
+  _ops.push_back(Op{OpType::BLEND, range, PAYLOAD{}, color});
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD, typename U>
+auto
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::clear() -> self_type& {
+  _ops.clear();
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD, typename U>
+std::vector<METRIC>
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::split_points(size_t n_parts) const {
+  static constexpr size_t MAX_SAMPLES = 1 << 16;
+  std::vector<METRIC> samples;
+  size_t stride = std::max<size_t>(1, _ops.size() / MAX_SAMPLES);
+  for (size_t idx = 0; idx < _ops.size(); idx += stride) {
+    samples.push_back(_ops[idx]._range.min());
+  }
+  std::sort(samples.begin(), samples.end());
+  // Each split point is the minimum of the partition it starts, so it can't be the first sample.
+  std::vector<METRIC> zret;
+  for (size_t part = 1; part < n_parts; ++part) {
+    auto const& m = samples[part * samples.size() / n_parts];
+    if (m != samples.front() && (zret.empty() || zret.back() < m)) {
+      zret.push_back(m);
+    }
+  }
+  return zret;
+}
+
+template <typename METRIC, typename PAYLOAD, typename U>
+template <typename F>
+auto
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::build(space_type& space, F&& blender, unsigned n_threads) const -> space_type& {
+  if (_ops.empty()) {
+    return space;
+  }
+  if (n_threads == 0) {
+    n_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  // Existing content is treated as a leading sequence of marks.
+  std::vector<Op> seeds;
+  for (auto const& node : space) {
+    seeds.push_back(Op{OpType::MARK, node.range(), node.payload(), U{}});
+  }
+  auto op = [&](size_t idx) -> Op const& { return idx < seeds.size() ? seeds[idx] : _ops[idx - seeds.size()]; };
+  size_t n_ops = seeds.size() + _ops.size();
+
+  // Distribute the operations, clipped, to the partitions in order.
+  auto splits = this->split_points(size_t(n_threads) * PARTITIONS_PER_THREAD);
+  std::vector<std::vector<Clip>> clips(splits.size() + 1);
+  for (size_t idx = 0; idx < n_ops; ++idx) {
+    auto const& r = op(idx)._range;
+    if (r.empty()) {
+      continue;
+    }
+    size_t part = std::upper_bound(splits.begin(), splits.end(), r.min()) - splits.begin();
+    for (; part < clips.size() && (part == 0 || !(r.max() < splits[part - 1])); ++part) {
+      range_type clip{r};
+      if (part > 0 && clip.min() < splits[part - 1]) {
+        clip.assign_min(splits[part - 1]);
+      }
+      if (part < splits.size() && !(clip.max() < splits[part])) {
+        clip.assign_max(--METRIC{splits[part]});
+      }
+      clips[part].push_back(Clip{clip, idx});
+    }
+  }
+
+  // Build the partitions.
+  std::vector<std::unique_ptr<space_type>> parts(clips.size());
+  std::atomic<size_t> next{0};
+  auto worker = [&]() -> void {
+    for (size_t part; (part = next.fetch_add(1, std::memory_order_relaxed)) < clips.size();) {
+      auto s = std::make_unique<space_type>();
+      for (auto const& [range, idx] : clips[part]) {
+        auto const& item = op(idx);
+        switch (item._type) {
+        case OpType::MARK:
+          s->mark(range, item._payload);
+          break;
+        case OpType::FILL:
+          s->fill(range, item._payload);
+          break;
+        case OpType::ERASE:
+          s->erase(range);
+          break;
+        case OpType::BLEND:
+          s->blend(range, item._color, blender);
+          break;
+        }
+      }
+      parts[part] = std::move(s);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < std::min<size_t>(n_threads, clips.size()); ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Stitch the partitions together. The bulk load coalesces adjacent ranges at the boundaries.
+  space.clear();
+  auto proj = [](auto const& node) { return std::pair<range_type const&, PAYLOAD const&>{node.range(), node.payload()}; };
+  for (auto& part : parts) {
+    space.load(part->begin(), part->end(), proj);
+    part.reset();
+  }
+  return space;
+}
+
+template <typename METRIC, typename PAYLOAD, typename U>
+auto
+DiscreteSpaceBuilder<METRIC, PAYLOAD, U>::build(space_type& space, unsigned n_threads) const -> space_type& {
+  return this->build(
+    space, [](PAYLOAD&, U const&) -> bool { return true; }, n_threads);
+}
+
+template <typename PAYLOAD, typename U>
+auto
+IPSpaceBuilder<PAYLOAD, U>::mark(IPRange const& range, PAYLOAD const& payload) -> self_type& {
+  if (range.is(AF_INET)) {
+    _ip4.mark(range.ip4(), payload);
+  } else if (range.is(AF_INET6)) {
+    _ip6.mark(range.ip6(), payload);
+  }
+  return *this;
+}
+
+template <typename PAYLOAD, typename U>
+auto
+IPSpaceBuilder<PAYLOAD, U>::fill(IPRange const& range, PAYLOAD const& payload) -> self_type& {
+  if (range.is(AF_INET)) {
+    _ip4.fill(range.ip4(), payload);
+  } else if (range.is(AF_INET6)) {
+    _ip6.fill(range.ip6(), payload);
+  }
+  return *this;
+}
+
+template <typename PAYLOAD, typename U>
+auto
+IPSpaceBuilder<PAYLOAD, U>::erase(IPRange const& range) -> self_type& {
+  if (range.is(AF_INET)) {
+    _ip4.erase(range.ip4());
+  } else if (range.is(AF_INET6)) {
+    _ip6.erase(range.ip6());
+  }
+  return *this;
+}
+
+template <typename PAYLOAD, typename U>
+auto
+IPSpaceBuilder<PAYLOAD, U>::blend(IPRange const& range, U const& color) -> self_type& {
+  if (range.is(AF_INET)) {
+    _ip4.blend(range.ip4(), color);
+  } else if (range.is(AF_INET6)) {
+    _ip6.blend(range.ip6(), color);
+  }
+  return *this;
+}
+
+template <typename PAYLOAD, typename U>
+auto
+IPSpaceBuilder<PAYLOAD, U>::clear() -> self_type& {
+  _ip4.clear();
+  _ip6.clear();
+  return *this;
+}
+
+template <typename PAYLOAD, typename U>
+template <typename F>
+auto
+IPSpaceBuilder<PAYLOAD, U>::build(space_type& space, F&& blender, unsigned n_threads) const -> space_type& {
+  _ip4.build(space._ip4, blender, n_threads);
+  _ip6.build(space._ip6, blender, n_threads);
+  return space;
+}
+
+template <typename PAYLOAD, typename U>
+auto
+IPSpaceBuilder<PAYLOAD, U>::build(space_type& space, unsigned n_threads) const -> space_type& {
+  _ip4.build(space._ip4, n_threads);
+  _ip6.build(space._ip6, n_threads);
+  return space;
+}
+
+}} // namespace swoc
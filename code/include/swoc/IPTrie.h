@@ -0,0 +1,442 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Longest prefix match tries for IP networks.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "swoc/swoc_version.h"
+#include "swoc/MemSpan.h"
+#include "swoc/swoc_ip.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+/** Longest prefix match trie for networks of a single family.
+ *
+ * @tparam NET Network type (@c IP4Net or @c IP6Net).
+ * @tparam PAYLOAD Data associated with each network.
+ *
+ * Unlike @c IPSpace, networks are kept distinct - a lookup finds the most specific network that
+ * contains the address, along with its payload. The trie is read only, it is built in bulk from a
+ * list of networks.
+ *
+ * The structure is a Poptrie. The root table is indexed directly by the top @c ROOT_BITS bits of
+ * the address, each slot containing either a network or a node. Below the root each node covers
+ * @c STRIDE bits of the address with two bit vectors, one marking which of the slots are child
+ * nodes and the other marking the slots where the network changes. The children of a node are
+ * contiguous, as are its networks, so the index of either is a population count of the relevant
+ * vector. Each node is 24 bytes regardless of the number of networks below it, and a lookup is
+ * one dependent load per level.
+ */
+template <typename NET, typename PAYLOAD> class IPStrideTrie {
+  using self_type = IPStrideTrie; ///< Self reference type.
+public:
+  using net_type   = NET;                                                        ///< Network type.
+  using addr_type  = std::decay_t<decltype(std::declval<NET>().lower_bound())>; ///< Address type.
+  using value_type = std::pair<NET const, PAYLOAD>;                             ///< Stored network.
+
+  /// Bits of the address used to index the root table.
+  /// For IPv4 this leaves exactly two levels of nodes.
+  static constexpr unsigned ROOT_BITS = addr_type::WIDTH == IP4Addr::WIDTH ? 20 : 16;
+  /// Bits of the address used to index a node.
+  static constexpr unsigned STRIDE = 6;
+
+  using iterator       = typename std::vector<value_type>::const_iterator;
+  using const_iterator = iterator;
+
+  /// Construct an empty trie.
+  IPStrideTrie() = default;
+
+  /** Construct from a list of networks.
+   *
+   * @param nets Networks and payloads.
+   *
+   * If a network is in @a nets more than once, the last payload is used. The list does not need
+   * to be sorted but the build is faster if it is sorted by address.
+   */
+  explicit IPStrideTrie(MemSpan<std::pair<net_type, PAYLOAD> const> nets);
+
+  /// Move constructor.
+  IPStrideTrie(self_type&& that) = default;
+
+  /// Move assignment.
+  self_type& operator=(self_type&& that) = default;
+
+  /** Find the most specific network containing @a addr.
+   *
+   * @param addr Search address.
+   * @return A pointer to the network and payload, or @c nullptr if no network contains @a addr.
+   */
+  value_type const *find(addr_type const& addr) const;
+
+  /// @return The number of networks.
+  size_t count() const { return _entries.size(); }
+
+  /// @return @c true if there are no networks, @c false if not.
+  bool empty() const { return _entries.empty(); }
+
+  /// @return The number of nodes below the root table.
+  size_t node_count() const { return _nodes.size(); }
+
+  /// @return Iterator to the first network, in address order.
+  const_iterator begin() const { return _entries.begin(); }
+  /// @return Iterator past the last network.
+  const_iterator end() const { return _entries.end(); }
+
+protected:
+  /// Network reference - 0 is no network, otherwise an index in to @a _entries + 1.
+  using leaf_type = uint32_t;
+  /// Mark for a root slot that refers to a node.
+  static constexpr leaf_type NODE_FLAG = leaf_type{1} << 31;
+
+  /// Trie node, covers @c STRIDE bits.
+  struct Node {
+    uint64_t _vector  = 0; ///< Bit set for each slot that is a child node.
+    uint64_t _leafvec = 0; ///< Bit set for each slot where a run of the same network starts.
+    uint32_t _base0   = 0; ///< Index in @a _leaves of the first network.
+    uint32_t _base1   = 0; ///< Index in @a _nodes of the first child.
+  };
+
+  std::vector<leaf_type> _root;     ///< Root table, empty if there are no networks.
+  std::vector<Node> _nodes;         ///< Nodes below the root.
+  std::vector<leaf_type> _leaves;   ///< Network references for the nodes.
+  std::vector<value_type> _entries; ///< Networks and payloads, in address order.
+
+  /// @return The number of bits set in @a n.
+  static unsigned popcount(uint64_t n);
+
+  /// @return @a n bits of @a addr starting at bit @a offset from the most significant bit.
+  static unsigned bits(IP4Addr const& addr, unsigned offset, unsigned n);
+  /// @return @a n bits of @a addr starting at bit @a offset from the most significant bit.
+  static unsigned bits(IP6Addr const& addr, unsigned offset, unsigned n);
+
+  /** Compute the slot networks and child lists for a table.
+   *
+   * @param offset Bit offset of the table in the address.
+   * @param n Number of bits in the table index.
+   * @param dflt Network for slots not covered by a network in @a nets.
+   * @param nets Networks under the table, in address order. Each is more specific than @a offset.
+   * @param leaves [out] Network for each slot.
+   * @param deep [out] Networks more specific than the table, in address order.
+   * @param spans [out] For each slot the end of the networks for that slot in @a deep.
+   */
+  void fill(unsigned offset, unsigned n, leaf_type dflt, MemSpan<leaf_type const> nets, MemSpan<leaf_type> leaves,
+            std::vector<leaf_type>& deep, MemSpan<uint32_t> spans) const;
+
+  /** Build a node.
+   *
+   * @param idx Index of the node in @a _nodes.
+   * @param offset Bit offset of the node in the address.
+   * @param dflt Network that covers the entire node.
+   * @param nets Networks under the node.
+   */
+  void build(size_t idx, unsigned offset, leaf_type dflt, MemSpan<leaf_type const> nets);
+};
+
+/** Longest prefix match trie for IPv4 and IPv6 networks.
+ *
+ * @tparam PAYLOAD Data associated with each network.
+ *
+ * @see IPStrideTrie
+ */
+template <typename PAYLOAD> class IPTrie {
+  using self_type = IPTrie; ///< Self reference type.
+public:
+  using IP4Trie = IPStrideTrie<IP4Net, PAYLOAD>; ///< IPv4 trie.
+  using IP6Trie = IPStrideTrie<IP6Net, PAYLOAD>; ///< IPv6 trie.
+
+  /// Result of a search - the network and a pointer to its payload, or @c nullptr if not found.
+  using match_type = std::tuple<IPNet, PAYLOAD const *>;
+
+  /// Construct an empty trie.
+  IPTrie() = default;
+
+  /** Construct from a list of networks.
+   *
+   * @param nets Networks and payloads.
+   *
+   * @see IPStrideTrie::IPStrideTrie
+   */
+  explicit IPTrie(MemSpan<std::pair<IPNet, PAYLOAD> const> nets);
+
+  /** Construct from the ranges in @a space.
+   *
+   * @param space Source space.
+   *
+   * Each range is converted to its minimal set of covering networks. The ranges in an @c IPSpace
+   * are disjoint so every address has at most one matching network and the trie is a fast lookup
+   * index for the space.
+   */
+  explicit IPTrie(IPSpace<PAYLOAD> const& space);
+
+  /** Find the most specific network containing @a addr.
+   *
+   * @param addr Search address.
+   * @return The network and a pointer to its payload, or an invalid network and @c nullptr.
+   */
+  match_type find(IPAddr const& addr) const;
+
+  /// Find the most specific IPv4 network containing @a addr.
+  match_type find(IP4Addr const& addr) const;
+
+  /// Find the most specific IPv6 network containing @a addr.
+  match_type find(IP6Addr const& addr) const;
+
+  /// @return The number of networks.
+  size_t count() const { return _ip4.count() + _ip6.count(); }
+  /// @return The number of IPv4 networks.
+  size_t count_ip4() const { return _ip4.count(); }
+  /// @return The number of IPv6 networks.
+  size_t count_ip6() const { return _ip6.count(); }
+
+  /// @return @c true if there are no networks, @c false if not.
+  bool empty() const { return _ip4.empty() && _ip6.empty(); }
+
+  /// @return The IPv4 trie.
+  IP4Trie const& ip4() const { return _ip4; }
+  /// @return The IPv6 trie.
+  IP6Trie const& ip6() const { return _ip6; }
+
+protected:
+  IP4Trie _ip4; ///< IPv4 networks.
+  IP6Trie _ip6; ///< IPv6 networks.
+
+  /// Build the family tries from lists of networks.
+  void build(std::vector<std::pair<IP4Net, PAYLOAD>> const& nets4, std::vector<std::pair<IP6Net, PAYLOAD>> const& nets6);
+};
+
+// --- Implementation
+
+template <typename NET, typename PAYLOAD>
+unsigned
+IPStrideTrie<NET, PAYLOAD>::popcount(uint64_t n) {
+  // The builtin is a library call unless the target is known to have a population count
+  // instruction, this is faster in that case and not much slower otherwise.
+  n = n - ((n >> 1) & 0x5555555555555555);
+  n = (n & 0x3333333333333333) + ((n >> 2) & 0x3333333333333333);
+  n = (n + (n >> 4)) & 0x0F0F0F0F0F0F0F0F;
+  return (n * 0x0101010101010101) >> 56;
+}
+
+template <typename NET, typename PAYLOAD>
+unsigned
+IPStrideTrie<NET, PAYLOAD>::bits(IP4Addr const& addr, unsigned offset, unsigned n) {
+  return (uint64_t{addr.host_order()} >> (IP4Addr::WIDTH - offset - n)) & ((uint64_t{1} << n) - 1);
+}
+
+template <typename NET, typename PAYLOAD>
+unsigned
+IPStrideTrie<NET, PAYLOAD>::bits(IP6Addr const& addr, unsigned offset, unsigned n) {
+  static constexpr int WORD_WIDTH = IP6Addr::WORD_WIDTH;
+  auto const& store = addr._addr._store;
+  auto idx          = offset / WORD_WIDTH;
+  int shift         = WORD_WIDTH - int(offset % WORD_WIDTH) - int(n);
+  // If the bits span the words, combine the end of the first word with the start of the second.
+  uint64_t zret = shift >= 0 ? store[idx] >> shift : (store[idx] << -shift) | (store[idx + 1] >> (WORD_WIDTH + shift));
+  return zret & ((uint64_t{1} << n) - 1);
+}
+
+template <typename NET, typename PAYLOAD>
+void
+IPStrideTrie<NET, PAYLOAD>::fill(unsigned offset, unsigned n, leaf_type dflt, MemSpan<leaf_type const> nets,
+                                 MemSpan<leaf_type> leaves, std::vector<leaf_type>& deep, MemSpan<uint32_t> spans) const {
+  std::fill(leaves.begin(), leaves.end(), dflt);
+  std::fill(spans.begin(), spans.end(), 0);
+  deep.clear();
+  // In address order a network comes before any network it contains, so painting in order leaves
+  // each slot with the most specific network that covers it.
+  for (auto leaf : nets) {
+    auto const& net = _entries[leaf - 1].first;
+    auto width      = net.mask().width();
+    auto slot       = bits(net.lower_bound(), offset, n);
+    if (width <= offset + n) {
+      auto span = size_t{1} << (offset + n - width);
+      std::fill(leaves.data() + slot, leaves.data() + slot + span, leaf);
+    } else {
+      deep.push_back(leaf);
+      spans[slot] = deep.size();
+    }
+  }
+  // Carry the ends forward so a slot without networks has an empty span.
+  for (size_t slot = 1; slot < spans.count(); ++slot) {
+    spans[slot] = std::max(spans[slot], spans[slot - 1]);
+  }
+}
+
+template <typename NET, typename PAYLOAD>
+void
+IPStrideTrie<NET, PAYLOAD>::build(size_t idx, unsigned offset, leaf_type dflt, MemSpan<leaf_type const> nets) {
+  unsigned n     = std::min(STRIDE, unsigned(addr_type::WIDTH) - offset);
+  size_t n_slots = size_t{1} << n;
+  leaf_type leaves[size_t{1} << STRIDE];
+  uint32_t spans[size_t{1} << STRIDE];
+  std::vector<leaf_type> deep;
+  this->fill(offset, n, dflt, nets, MemSpan<leaf_type>{leaves, n_slots}, deep, MemSpan<uint32_t>{spans, n_slots});
+
+  Node node;
+  node._base0    = _leaves.size();
+  node._base1    = _nodes.size();
+  leaf_type prev = 0;
+  bool first_p   = true;
+  for (size_t slot = 0, start = 0; slot < n_slots; start = spans[slot++]) {
+    if (spans[slot] > start) {
+      node._vector |= uint64_t{1} << slot;
+    } else if (first_p || leaves[slot] != prev) {
+      node._leafvec |= uint64_t{1} << slot;
+      _leaves.push_back(leaves[slot]);
+      prev    = leaves[slot];
+      first_p = false;
+    }
+  }
+  // Children are allocated together so they are contiguous, then built depth first.
+  _nodes.resize(_nodes.size() + popcount(node._vector));
+  _nodes[idx] = node;
+  auto child  = node._base1;
+  for (size_t slot = 0, start = 0; slot < n_slots; start = spans[slot++]) {
+    if (spans[slot] > start) {
+      this->build(child++, offset + n, leaves[slot], MemSpan<leaf_type const>{deep.data() + start, spans[slot] - start});
+    }
+  }
+}
+
+template <typename NET, typename PAYLOAD>
+IPStrideTrie<NET, PAYLOAD>::IPStrideTrie(MemSpan<std::pair<net_type, PAYLOAD> const> nets) {
+  if (nets.empty()) {
+    return;
+  }
+
+  // Sort by address and then by increasing width, so that a network is before the networks it
+  // contains. Stable so that for duplicates the last one in @a nets is last.
+  std::vector<uint32_t> order(nets.count());
+  std::iota(order.begin(), order.end(), 0);
+  auto before = [&](uint32_t lhs, uint32_t rhs) -> bool {
+    auto const& l = nets[lhs].first;
+    auto const& r = nets[rhs].first;
+    return l.lower_bound() < r.lower_bound() || (l.lower_bound() == r.lower_bound() && l.mask().width() < r.mask().width());
+  };
+  if (!std::is_sorted(order.begin(), order.end(), before)) {
+    std::stable_sort(order.begin(), order.end(), before);
+  }
+  _entries.reserve(order.size());
+  for (size_t idx = 0; idx < order.size(); ++idx) {
+    if (idx + 1 < order.size() && nets[order[idx]].first == nets[order[idx + 1]].first) {
+      continue; // duplicate, use the later one.
+    }
+    _entries.emplace_back(nets[order[idx]].first, nets[order[idx]].second);
+  }
+
+  std::vector<leaf_type> all(_entries.size());
+  std::iota(all.begin(), all.end(), 1);
+  std::vector<uint32_t> spans(size_t{1} << ROOT_BITS);
+  std::vector<leaf_type> deep;
+  _root.resize(size_t{1} << ROOT_BITS);
+  this->fill(0, ROOT_BITS, 0, MemSpan<leaf_type const>{all.data(), all.size()}, MemSpan<leaf_type>{_root.data(), _root.size()},
+             deep, MemSpan<uint32_t>{spans.data(), spans.size()});
+  for (size_t slot = 0, start = 0; slot < _root.size(); start = spans[slot++]) {
+    if (spans[slot] > start) {
+      auto idx = _nodes.size();
+      _nodes.emplace_back();
+      this->build(idx, ROOT_BITS, _root[slot], MemSpan<leaf_type const>{deep.data() + start, spans[slot] - start});
+      _root[slot] = leaf_type(idx) | NODE_FLAG;
+    }
+  }
+}
+
+template <typename NET, typename PAYLOAD>
+auto
+IPStrideTrie<NET, PAYLOAD>::find(addr_type const& addr) const -> value_type const * {
+  if (_root.empty()) {
+    return nullptr;
+  }
+  leaf_type leaf = _root[bits(addr, 0, ROOT_BITS)];
+  if (leaf & NODE_FLAG) {
+    Node const *node = &_nodes[leaf & ~NODE_FLAG];
+    for (unsigned offset = ROOT_BITS;; offset += STRIDE) {
+      auto slot     = bits(addr, offset, std::min(STRIDE, unsigned(addr_type::WIDTH) - offset));
+      uint64_t mask = (uint64_t{2} << slot) - 1; // bits up to and including @a slot.
+      if (node->_vector & (uint64_t{1} << slot)) {
+        node = &_nodes[node->_base1 + popcount(node->_vector & mask) - 1];
+      } else {
+        leaf = _leaves[node->_base0 + popcount(node->_leafvec & mask) - 1];
+        break;
+      }
+    }
+  }
+  return leaf ? &_entries[leaf - 1] : nullptr;
+}
+
+template <typename PAYLOAD>
+void
+IPTrie<PAYLOAD>::build(std::vector<std::pair<IP4Net, PAYLOAD>> const& nets4, std::vector<std::pair<IP6Net, PAYLOAD>> const& nets6) {
+  _ip4 = IP4Trie{MemSpan<std::pair<IP4Net, PAYLOAD> const>{nets4.data(), nets4.size()}};
+  _ip6 = IP6Trie{MemSpan<std::pair<IP6Net, PAYLOAD> const>{nets6.data(), nets6.size()}};
+}
+
+template <typename PAYLOAD> IPTrie<PAYLOAD>::IPTrie(MemSpan<std::pair<IPNet, PAYLOAD> const> nets) {
+  std::vector<std::pair<IP4Net, PAYLOAD>> nets4;
+  std::vector<std::pair<IP6Net, PAYLOAD>> nets6;
+  for (auto const& [net, payload] : nets) {
+    if (net.is_ip4()) {
+      nets4.emplace_back(net.ip4(), payload);
+    } else if (net.is_ip6()) {
+      nets6.emplace_back(net.ip6(), payload);
+    }
+  }
+  this->build(nets4, nets6);
+}
+
+template <typename PAYLOAD> IPTrie<PAYLOAD>::IPTrie(IPSpace<PAYLOAD> const& space) {
+  std::vector<std::pair<IP4Net, PAYLOAD>> nets4;
+  std::vector<std::pair<IP6Net, PAYLOAD>> nets6;
+  for (auto const& [range, payload] : space) {
+    for (auto const& net : range.networks()) {
+      if (net.is_ip4()) {
+        nets4.emplace_back(net.ip4(), payload);
+      } else {
+        nets6.emplace_back(net.ip6(), payload);
+      }
+    }
+  }
+  this->build(nets4, nets6);
+}
+
+template <typename PAYLOAD>
+auto
+IPTrie<PAYLOAD>::find(IPAddr const& addr) const -> match_type {
+  if (addr.is_ip4()) {
+    return this->find(addr.ip4());
+  } else if (addr.is_ip6()) {
+    return this->find(addr.ip6());
+  }
+  return {};
+}
+
+template <typename PAYLOAD>
+auto
+IPTrie<PAYLOAD>::find(IP4Addr const& addr) const -> match_type {
+  if (auto spot = _ip4.find(addr); spot) {
+    return {IPNet{spot->first.lower_bound(), spot->first.mask()}, &spot->second};
+  }
+  return {};
+}
+
+template <typename PAYLOAD>
+auto
+IPTrie<PAYLOAD>::find(IP6Addr const& addr) const -> match_type {
+  if (auto spot = _ip6.find(addr); spot) {
+    return {IPNet{spot->first.lower_bound(), spot->first.mask()}, &spot->second};
+  }
+  return {};
+}
+
+}} // namespace swoc
@@ -10,14 +10,43 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <array>
 #include <algorithm>
 
 #include "swoc/swoc_version.h"
+#include "swoc/swoc_meta.h"
 #include "swoc/IntrusiveDList.h"
 
 namespace swoc { inline namespace SWOC_VERSION_NS {
+/// How hash values are mapped to buckets in an @c IntrusiveHashMap.
+enum class IntrusiveHashMapping {
+  PRIME,     ///< Prime number of buckets, bucket is the hash modulo the number of buckets.
+  POWER_OF_2 ///< Power of 2 number of buckets, bucket is from the bits of a multiplied hash.
+};
+
+namespace detail {
+/// Default if the descriptor does not specify the mapping.
+template<typename H>
+constexpr auto
+IntrusiveHashMappingOf(meta::CaseTag<0>) -> IntrusiveHashMapping {
+  return IntrusiveHashMapping::PRIME;
+}
+
+/// Mapping specified by the descriptor.
+template<typename H>
+constexpr auto
+IntrusiveHashMappingOf(meta::CaseTag<1>) -> decltype(H::BUCKET_MAPPING, IntrusiveHashMapping()) {
+  return H::BUCKET_MAPPING;
+}
+} // namespace detail
+
 /** Intrusive Hash Table.
 
     Values stored in this container are not destroyed when the container is destroyed or removed from the container.
@@ -27,7 +56,9 @@ namespace swoc { inline namespace SWOC_VERSION_NS {
     @see @c Location::operator++()
 
     By default the table automatically expands to limit the average chain length. This can be tuned. If set
-    to @c MANUAL then the table will expand @b only when explicitly requested to do so by the client.
+    to @c MANUAL then the table will expand @b only when explicitly requested to do so by the client. If set to
+    @c INCREMENTAL the table expands as for @c AVERAGE but elements are moved to the new buckets a few buckets at a
+    time during later operations, rather than all at once.
     @see @c ExpansionPolicy
     @see @c setExpansionPolicy()
     @see @c setExpansionLimit()
@@ -48,6 +79,13 @@ namespace swoc { inline namespace SWOC_VERSION_NS {
     These are the required members, it is permitted to have other methods (if the descriptor is used for other purposes)
     or to provide overloads of the methods. Note this is compatible with @c IntrusiveDList.
 
+    The descriptor may also have the member <tt>static constexpr IntrusiveHashMapping BUCKET_MAPPING</tt> to select
+    how hash values are mapped to buckets. The default, @c IntrusiveHashMapping::PRIME, uses a prime number of buckets
+    and the remainder of the hash divided by the number of buckets. @c IntrusiveHashMapping::POWER_OF_2 uses a power of
+    2 number of buckets and takes the bucket index from the high bits of the hash multiplied by a constant (Fibonacci
+    hashing), which avoids an integer division for each lookup. Every bit of the hash contributes to the index so this
+    works for hashes with poorly distributed low bits, but keys with equal hash values still collide.
+
     Several internal types are deduced from these arguments.
 
     @a Key is the return type of @a key_of and represents the key that distinguishes instances of @a value_type. Two
@@ -86,7 +124,8 @@ public:
   enum ExpansionPolicy {
     MANUAL,  ///< Client must explicitly expand the table.
     AVERAGE, ///< Table expands if average chain length exceeds limit. [default]
-    MAXIMUM  ///< Table expands if any chain length exceeds limit.
+    MAXIMUM, ///< Table expands if any chain length exceeds limit.
+    INCREMENTAL ///< As @c AVERAGE, but elements are moved to the new buckets incrementally.
   };
 
 protected:
@@ -133,6 +172,10 @@ public:
   static size_t constexpr DEFAULT_EXPANSION_LIMIT = 4; ///< Value from previous version.
   /// Expansion policy if not specified in constructor.
   static ExpansionPolicy constexpr DEFAULT_EXPANSION_POLICY = AVERAGE;
+  /// Number of old buckets moved per operation during an @c INCREMENTAL expansion.
+  static size_t constexpr INCREMENTAL_STEP = 2;
+  /// Mapping of hash values to buckets.
+  static IntrusiveHashMapping constexpr BUCKET_MAPPING = detail::IntrusiveHashMappingOf<H>(meta::CaseArg);
 
   using iterator       = typename List::iterator;
   using const_iterator = typename List::const_iterator;
@@ -193,12 +236,19 @@ public:
   /** Insert a value in to the table.
       The @a value must @b NOT already be in a table of this type.
       @note The value itself is put in the table, @b not a copy.
+
+      During an incremental expansion this moves some elements to the new buckets, which can change the
+      iteration order of the elements.
   */
   void insert(value_type *v);
 
   /** Find an element with a key equal to @a key.
 
       @return A element with a matching key, or the end iterator if not found.
+
+      During an incremental expansion the non-const overload moves some elements to the new buckets, which can change
+      the iteration order of the elements. The const overload searches both the old and new buckets and does not
+      change the table.
   */
   const_iterator find(key_type key) const;
 
@@ -262,10 +312,14 @@ public:
 
   /** Expand the hash if needed.
 
-      Useful primarily when the expansion policy is set to @c MANUAL.
+      Useful primarily when the expansion policy is set to @c MANUAL. This completes any incremental expansion in
+      progress and then expands the table.
    */
   void expand();
 
+  /// @return @c true if an incremental expansion is in progress.
+  bool is_expanding() const;
+
   /// Number of elements in the map.
   size_t count() const;
 
@@ -285,17 +339,78 @@ public:
   size_t get_expansion_limit() const;
 
 protected:
-  /// The type of storage for the buckets.
-  using Table = std::vector<Bucket>;
+  /** Storage for the buckets.
+   *
+   * A @c Bucket in its initial state is all zero bits, so buckets are allocated with @c calloc rather than
+   * constructed. A large table is then zero pages from the system that are not touched until used, which
+   * keeps starting an @c INCREMENTAL expansion from initializing the entire new table.
+   */
+  class Table {
+  public:
+    Table() = default;
+    /// Construct with @a n buckets in the initial state.
+    explicit Table(size_t n);
+    Table(Table&& that) noexcept : _buckets(std::move(that._buckets)), _n(std::exchange(that._n, 0)) {}
+    Table& operator=(Table&& that) noexcept;
+
+    size_t size() const { return _n; }
+    bool empty() const { return _n == 0; }
+    Bucket& operator[](size_t idx) { return _buckets[idx]; }
+    Bucket const& operator[](size_t idx) const { return _buckets[idx]; }
+    Bucket *begin() { return _buckets.get(); }
+    Bucket *end() { return _buckets.get() + _n; }
+
+  protected:
+    /// Release memory from @c calloc.
+    struct Free {
+      void operator()(Bucket *b) const { ::free(b); }
+    };
+    std::unique_ptr<Bucket[], Free> _buckets; ///< Bucket storage.
+    size_t _n = 0;                            ///< Number of buckets.
+  };
 
   List _list;   ///< Elements in the table.
   Table _table; ///< Array of buckets.
 
-  /// List of non-empty buckets.
+  /** List of non-empty buckets.
+   *
+   * During an incremental expansion, the buckets in @a _table precede those in @a _old_table, starting with
+   * @a _old_head, and the elements of the list are in the same order.
+   */
   IntrusiveDList<typename Bucket::Linkage> _active_buckets;
 
+  Table _old_table;            ///< Buckets being emptied by an incremental expansion.
+  Bucket *_old_head = nullptr; ///< First active bucket in @a _old_table.
+
   Bucket *bucket_for(key_type key);
 
+  /// @return The index of the bucket for @a key in a table of @a n buckets.
+  static size_t index_of(key_type key, size_t n);
+
+  /// @return The smallest valid number of buckets that is at least @a n.
+  static size_t table_size_for(size_t n);
+
+  /// @return The bucket in @a _old_table for @a key, or @c nullptr if there is none or it is empty.
+  Bucket *old_bucket_for(key_type key) const;
+
+  /// @return The first element in @a bucket with @a key, or @c nullptr if not found.
+  static value_type *search(Bucket const *bucket, key_type key);
+
+  /// @return The first element with @a key in either table, or @c nullptr if not found.
+  value_type *lookup(key_type key) const;
+
+  /// Insert @a v in to its bucket in @a _table.
+  Bucket *insert_in_table(value_type *v);
+
+  /// Start an incremental expansion.
+  void start_expansion();
+
+  /// Move the elements of @a bucket in @a _old_table to @a _table.
+  void migrate(Bucket *bucket);
+
+  /// Move at most @a n old buckets, releasing the old table if that finishes the expansion.
+  void migrate(size_t n);
+
   ExpansionPolicy _expansion_policy{DEFAULT_EXPANSION_POLICY}; ///< When to exand the table.
   size_t _expansion_limit{DEFAULT_EXPANSION_LIMIT};            ///< Limit value for expansion.
 
@@ -377,16 +492,62 @@ IntrusiveHashMap<H>::const_range::end() const -> const_iterator const& {
 
 // ---------------------
 
+template<typename H> IntrusiveHashMap<H>::Table::Table(size_t n) : _n(n) {
+  static_assert(std::is_trivially_destructible_v<Bucket>, "Buckets are released without destruction.");
+  if (n) {
+    _buckets.reset(static_cast<Bucket *>(::calloc(n, sizeof(Bucket))));
+    if (!_buckets) {
+      throw std::bad_alloc();
+    }
+  }
+}
+
+template<typename H>
+auto
+IntrusiveHashMap<H>::Table::operator=(Table&& that) noexcept -> Table& {
+  _buckets = std::move(that._buckets);
+  _n       = std::exchange(that._n, 0);
+  return *this;
+}
+
 template<typename H> IntrusiveHashMap<H>::IntrusiveHashMap(size_t n) {
   if (n) {
-    _table.resize(*std::lower_bound(PRIME.begin(), PRIME.end(), n));
+    _table = Table(table_size_for(n));
+  }
+}
+
+template<typename H>
+size_t
+IntrusiveHashMap<H>::index_of(key_type key, size_t n) {
+  if constexpr (BUCKET_MAPPING == IntrusiveHashMapping::POWER_OF_2) {
+    // Fibonacci hashing - the top log2(n) bits of the product depend on every bit of the hash.
+    if (n <= 1) {
+      return 0; // A shift of 64 is undefined.
+    }
+    return (static_cast<uint64_t>(H::hash_of(key)) * 0x9E3779B97F4A7C15ULL) >> (64 - __builtin_ctzll(n));
+  } else {
+    return H::hash_of(key) % n;
+  }
+}
+
+template<typename H>
+size_t
+IntrusiveHashMap<H>::table_size_for(size_t n) {
+  if constexpr (BUCKET_MAPPING == IntrusiveHashMapping::POWER_OF_2) {
+    size_t zret = 1;
+    while (zret < n) {
+      zret <<= 1;
+    }
+    return zret;
+  } else {
+    return *std::lower_bound(PRIME.begin(), PRIME.end(), n);
   }
 }
 
 template<typename H>
 auto
 IntrusiveHashMap<H>::bucket_for(key_type key) -> Bucket * {
-  return &_table[H::hash_of(key) % _table.size()];
+  return &_table[index_of(key, _table.size())];
 }
 
 template<typename H>
@@ -422,25 +583,59 @@ IntrusiveHashMap<H>::clear() -> self_type& {
   // Clear container data.
   _list.clear();
   _active_buckets.clear();
+  _old_table = Table{};
+  _old_head  = nullptr;
   return *this;
 }
 
 template<typename H>
 auto
-IntrusiveHashMap<H>::find(key_type key) -> iterator {
-  Bucket *b = this->bucket_for(key);
+IntrusiveHashMap<H>::search(Bucket const *b, key_type key) -> value_type * {
   value_type *v = b->_v;
   value_type *limit = b->limit();
   while (v != limit && !H::equal(key, H::key_of(v))) {
     v = H::next_ptr(v);
   }
-  return v == limit ? _list.end() : _list.iterator_for(v);
+  return v == limit ? nullptr : v;
+}
+
+template<typename H>
+auto
+IntrusiveHashMap<H>::find(key_type key) -> iterator {
+  if (_old_head) {
+    this->migrate(INCREMENTAL_STEP);
+  }
+  value_type *v = this->lookup(key);
+  return v ? _list.iterator_for(v) : _list.end();
 }
 
 template<typename H>
 auto
 IntrusiveHashMap<H>::find(key_type key) const -> const_iterator {
-  return const_cast<self_type *>(this)->find(key);
+  value_type *v = this->lookup(key);
+  return v ? _list.iterator_for(v) : _list.end();
+}
+
+template<typename H>
+auto
+IntrusiveHashMap<H>::lookup(key_type key) const -> value_type * {
+  value_type *v = search(&_table[index_of(key, _table.size())], key);
+  if (nullptr == v && _old_head) {
+    if (Bucket *b = this->old_bucket_for(key); b) {
+      v = search(b, key);
+    }
+  }
+  return v;
+}
+
+template<typename H>
+auto
+IntrusiveHashMap<H>::old_bucket_for(key_type key) const -> Bucket * {
+  if (_old_table.empty()) {
+    return nullptr;
+  }
+  Bucket *b = const_cast<Bucket *>(&_old_table[index_of(key, _old_table.size())]);
+  return b->_v ? b : nullptr;
 }
 
 template<typename H>
@@ -478,8 +673,15 @@ IntrusiveHashMap<H>::iterator_for(value_type *v) -> iterator {
 template<typename H>
 auto
 IntrusiveHashMap<H>::find(value_type *v) -> iterator {
-  Bucket *b = this->bucket_for(H::key_of(v));
-  return b->contains(v) ? _list.iterator_for(v) : this->end();
+  auto key = H::key_of(v);
+  Bucket *b = this->bucket_for(key);
+  if (b->contains(v)) {
+    return _list.iterator_for(v);
+  }
+  if (Bucket *ob = this->old_bucket_for(key); ob && ob->contains(v)) {
+    return _list.iterator_for(v);
+  }
+  return this->end();
 }
 
 template<typename H>
@@ -491,15 +693,43 @@ IntrusiveHashMap<H>::find(value_type const *v) const -> const_iterator {
 template<typename H>
 void
 IntrusiveHashMap<H>::insert(value_type *v) {
+  if (_old_head) {
+    // Equal keys must be in the same bucket, so move any with this key before inserting.
+    if (Bucket *b = this->old_bucket_for(H::key_of(v)); b) {
+      this->migrate(b);
+    }
+    this->migrate(INCREMENTAL_STEP);
+  }
+
+  Bucket *bucket = this->insert_in_table(v);
+
+  // auto expand if appropriate.
+  if ((AVERAGE == _expansion_policy && (_list.count() / _table.size()) > _expansion_limit) ||
+      (MAXIMUM == _expansion_policy && bucket->_count > _expansion_limit && bucket->_mixed_p)) {
+    this->expand();
+  } else if (INCREMENTAL == _expansion_policy && nullptr == _old_head && (_list.count() / _table.size()) > _expansion_limit) {
+    this->start_expansion();
+  }
+}
+
+template<typename H>
+auto
+IntrusiveHashMap<H>::insert_in_table(value_type *v) -> Bucket * {
   auto key = H::key_of(v);
   Bucket *bucket = this->bucket_for(key);
   value_type *spot = bucket->_v;
   bool mixed_p = false; // Found a different key in the bucket.
 
   if (nullptr == spot) { // currently empty bucket, set it and add to active list.
-    _list.append(v);
+    // Buckets in the current table go before any in the old table.
+    if (_old_head) {
+      _list.insert_before(_old_head->_v, v);
+      _active_buckets.insert_before(_old_head, bucket);
+    } else {
+      _list.append(v);
+      _active_buckets.append(bucket);
+    }
     bucket->_v = v;
-    _active_buckets.append(bucket);
   } else {
     value_type *limit = bucket->limit();
 
@@ -525,12 +755,7 @@ IntrusiveHashMap<H>::insert(value_type *v) {
     bucket->_mixed_p = mixed_p;
   }
   ++bucket->_count;
-
-  // auto expand if appropriate.
-  if ((AVERAGE == _expansion_policy && (_list.count() / _table.size()) > _expansion_limit) ||
-      (MAXIMUM == _expansion_policy && bucket->_count > _expansion_limit && bucket->_mixed_p)) {
-    this->expand();
-  }
+  return bucket;
 }
 
 template<typename H>
@@ -539,16 +764,28 @@ IntrusiveHashMap<H>::erase(iterator const& loc) -> iterator {
   value_type *v = loc;
   iterator zret = ++(this->iterator_for(v)); // get around no const_iterator -> iterator.
   Bucket *b = this->bucket_for(H::key_of(v));
+  // During expansion @a v may still be in the old table. Buckets work the same in either table.
+  if (_old_head && !b->contains(v)) {
+    b = this->old_bucket_for(H::key_of(v));
+  }
   value_type *nv = H::next_ptr(v);
   value_type *limit = b->limit();
   if (b->_v == v) { // removed first element in bucket, update bucket
     if (limit == nv) { // that was also the only element, deactivate bucket
+      if (b == _old_head) {
+        _old_head = b->_link._next;
+      }
       _active_buckets.erase(b);
       b->clear();
+      if (nullptr == _old_head && !_old_table.empty()) { // that was the last old bucket.
+        _old_table = Table{};
+      }
     } else {
       b->_v = nv;
       --b->_count;
     }
+  } else {
+    --b->_count;
   }
   _list.erase(loc);
   return zret;
@@ -568,6 +805,9 @@ IntrusiveHashMap<H>::erase(value_type *value) {
 template<typename H>
 auto
 IntrusiveHashMap<H>::erase(iterator const& start, iterator const& limit) -> iterator {
+  while (_old_head) {
+    this->migrate(_old_table.size());
+  }
   auto spot{start};
   Bucket *bucket{this->bucket_for(spot)};
   while (spot != limit) {
@@ -626,16 +866,70 @@ IntrusiveHashMap<H>::apply(F&& f) -> self_type& {
   return detail::IntrusiveHashMapApply(*this, f);
 };
 
+template<typename H>
+void
+IntrusiveHashMap<H>::start_expansion() {
+  _old_table = std::move(_table);
+  _table     = Table(table_size_for(_old_table.size() + 1));
+  // All current buckets are now old, and already in the correct order.
+  _old_head = _active_buckets.head();
+  if (nullptr == _old_head) {
+    _old_table = Table{};
+  }
+}
+
+template<typename H>
+void
+IntrusiveHashMap<H>::migrate(Bucket *bucket) {
+  value_type *v     = bucket->_v;
+  value_type *limit = bucket->limit();
+  // Elements are moved to buckets in @a _table, which precede @a _old_head. @a bucket is kept as the
+  // remaining elements so that those are never inside the range of another bucket. Elements with
+  // equal keys are moved in order and so stay in order.
+  while (v != limit) {
+    value_type *next = H::next_ptr(v);
+    bucket->_v       = next;
+    _list.erase(v);
+    this->insert_in_table(v);
+    v = next;
+  }
+  if (bucket == _old_head) {
+    _old_head = bucket->_link._next;
+  }
+  _active_buckets.erase(bucket);
+  bucket->clear();
+}
+
+template<typename H>
+void
+IntrusiveHashMap<H>::migrate(size_t n) {
+  while (n-- > 0 && _old_head) {
+    this->migrate(_old_head);
+  }
+  if (nullptr == _old_head) {
+    _old_table = Table{};
+  }
+}
+
+template<typename H>
+bool
+IntrusiveHashMap<H>::is_expanding() const {
+  return _old_head != nullptr;
+}
+
 template<typename H>
 void
 IntrusiveHashMap<H>::expand() {
+  while (_old_head) {
+    this->migrate(_old_table.size());
+  }
   ExpansionPolicy org_expansion_policy = _expansion_policy; // save for restore.
   value_type *old = _list.head();      // save for repopulating.
   auto old_size = _table.size();
 
   // Reset to empty state.
   this->clear();
-  _table.resize(*std::lower_bound(PRIME.begin(), PRIME.end(), old_size + 1));
+  _table = Table(table_size_for(old_size + 1));
 
   _expansion_policy = MANUAL; // disable any auto expand while we're expanding.
   while (old) {
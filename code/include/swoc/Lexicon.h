@@ -13,6 +13,8 @@
 #include <functional>
 #include <array>
 #include <variant>
+#include <vector>
+#include <algorithm>
 
 #include "swoc/swoc_version.h"
 #include "swoc/IntrusiveHashMap.h"
@@ -58,6 +60,10 @@ what(std::string_view const& fmt, Args&& ... args) {
     entirely of calls to @c define and @c set_default, the only difference is these methods can
     be called on a @c const instance from there.
 
+    A @c Lexicon that will not change can be frozen with @c freeze. This builds a minimal perfect
+    hash of the names and, if the values are reasonably dense, an array of primary names indexed by
+    value, so that lookups in either direction do not search a hash table.
+
     @note All names and value must be unique across the Lexicon. All name comparisons are case
     insensitive.
  */
@@ -222,6 +228,31 @@ public:
   /// Get the number of values with definitions.
   size_t count() const;
 
+  /** Freeze the lexicon for faster lookup.
+   *
+   * @return @a this.
+   *
+   * This builds a minimal perfect hash for the names, and an array of names indexed by value if the
+   * values are dense enough. This is intended for lexicons that are defined once, e.g. during
+   * process start up. If more names are defined, the lexicon is no longer frozen and must be frozen
+   * again for fast lookup.
+   */
+  self_type& freeze() &;
+
+  /** Freeze a temporary lexicon.
+   *
+   * @return @a this as an r-value.
+   *
+   * This enables initializing a constant frozen instance.
+   * @code
+   * static Lexicon<E> const Names = Lexicon<E>{ ... }.freeze();
+   * @endcode
+   */
+  self_type&& freeze() &&;
+
+  /// @return @c true if the lexicon is frozen.
+  bool is_frozen() const;
+
   /** Iterator over pairs of values and primary name pairs.
    * Value is a 2-tuple of the enumeration type and the primary name.
    */
@@ -388,6 +419,35 @@ protected:
   /// Copy @a name in to local storage.
   std::string_view localize(std::string_view const& name);
 
+  /** Lookup tables for a frozen lexicon.
+   *
+   * The name table is a hash and displace perfect hash. The hash of a name selects a displacement,
+   * which is mixed with the hash to select a slot. The displacements are chosen so that every name
+   * has a different slot and there is exactly one slot per name.
+   */
+  struct Frozen {
+    /// Name lookup slot.
+    struct Slot {
+      std::string_view _name; ///< Name.
+      E _value;               ///< Value for @a _name.
+    };
+
+    uint64_t _seed = 0;                   ///< Seed for name hash.
+    std::vector<uint32_t> _disp;          ///< Displacements, size is a power of 2.
+    std::vector<Slot> _slots;             ///< Names, one slot per name unless that failed.
+    intmax_t _min = 0;                    ///< Smallest value.
+    std::vector<std::string_view> _names; ///< Primary names indexed by value - @a _min.
+
+    /// @return The case insensitive hash of @a name.
+    static uint64_t hash_of(std::string_view name, uint64_t seed);
+    /// @return The slot for hash @a h with displacement @a d in @a n slots.
+    static size_t slot_of(uint64_t h, uint32_t d, size_t n);
+    /// @return The slot index for @a name, which may not be the slot for that name.
+    size_t find(std::string_view name) const;
+    /// Build the name table with @a seed and @a n_slots, returning @c false if that fails.
+    bool build(std::vector<std::pair<std::string_view, E>> const& names, uint64_t seed, size_t n_slots);
+  };
+
   /// Storage for names.
   MemArena _arena{1024};
   /// Access by name.
@@ -396,6 +456,7 @@ protected:
   IntrusiveHashMap<typename Item::ValueLinkage> _by_value;
   NameDefault _name_default;   ///< Name to return if no value not found.
   ValueDefault _value_default; ///< Value to return if name not found.
+  Frozen _frozen;              ///< Lookup tables, if frozen.
 };
 
 // ==============
@@ -513,6 +574,15 @@ Lexicon<E>::localize(std::string_view const& name) {
 }
 
 template<typename E> std::string_view Lexicon<E>::operator[](E value) const {
+  if (!_frozen._names.empty()) {
+    // Unsigned compare checks both bounds.
+    if (size_t idx = static_cast<intmax_t>(value) - _frozen._min; idx < _frozen._names.size()) {
+      if (auto name = _frozen._names[idx]; name.data()) {
+        return name;
+      }
+    }
+    return std::visit(NameDefaultVisitor{value}, _name_default);
+  }
   auto spot = _by_value.find(value);
   if (spot != _by_value.end()) {
     return spot->_name;
@@ -521,6 +591,13 @@ template<typename E> std::string_view Lexicon<E>::operator[](E value) const {
 }
 
 template<typename E> E Lexicon<E>::operator[](std::string_view const& name) const {
+  if (!_frozen._slots.empty()) {
+    // Unused slots have a null name, and so never match.
+    if (auto const& slot = _frozen._slots[_frozen.find(name)]; slot._name.data() && 0 == strcasecmp(slot._name, name)) {
+      return slot._value;
+    }
+    return std::visit(ValueDefaultVisitor{name}, _value_default);
+  }
   auto spot = _by_name.find(name);
   if (spot != _by_name.end()) {
     return spot->_value;
@@ -534,10 +611,15 @@ Lexicon<E>::define(E value, const std::initializer_list<std::string_view>& names
   if (names.size() < 1) {
     throw std::invalid_argument("A defined value must have at least a primary name");
   }
-  for (auto name : names) {
-    if (_by_name.find(name) != _by_name.end()) {
-      throw std::invalid_argument(detail::what("Duplicate name '{}' in Lexicon", name));
+  // Check all the names first so a failed define leaves the lexicon unchanged.
+  for (auto spot = names.begin(); spot != names.end(); ++spot) {
+    auto same_p = [=](std::string_view n) { return 0 == strcasecmp(n, *spot); };
+    if (_by_name.find(*spot) != _by_name.end() || std::any_of(names.begin(), spot, same_p)) {
+      throw std::invalid_argument(detail::what("Duplicate name '{}' in Lexicon", *spot));
     }
+  }
+  _frozen = Frozen{}; // no longer valid.
+  for (auto name : names) {
     auto i = new Item(value, this->localize(name));
     _by_name.insert(i);
     // Only put primary names in the value table.
@@ -591,6 +673,141 @@ Lexicon<E>::count() const {
   return _by_value.count();
 }
 
+template<typename E>
+uint64_t
+Lexicon<E>::Frozen::hash_of(std::string_view name, uint64_t seed) {
+  // FNV-1a of the upper case name, so names that differ only in case have the same hash.
+  uint64_t zret = 0xcbf29ce484222325ULL ^ seed;
+  for (unsigned char c : name) {
+    c ^= (unsigned(c - 'a') < 26) << 5;
+    zret = (zret ^ c) * 0x100000001b3ULL;
+  }
+  return zret;
+}
+
+template<typename E>
+size_t
+Lexicon<E>::Frozen::slot_of(uint64_t h, uint32_t d, size_t n) {
+  uint64_t x = h ^ (d * 0x9E3779B97F4A7C15ULL);
+  x          = (x ^ (x >> 31)) * 0xBF58476D1CE4E5B9ULL;
+  // Multiply and shift to reduce to [0, n) rather than divide.
+  return ((x >> 32) * n) >> 32;
+}
+
+template<typename E>
+size_t
+Lexicon<E>::Frozen::find(std::string_view name) const {
+  auto h = hash_of(name, _seed);
+  return slot_of(h, _disp[h & (_disp.size() - 1)], _slots.size());
+}
+
+template<typename E>
+bool
+Lexicon<E>::Frozen::build(std::vector<std::pair<std::string_view, E>> const& names, uint64_t seed, size_t n_slots) {
+  static constexpr uint32_t MAX_DISP = 1 << 16; ///< Limit on displacement search per bucket.
+  size_t n_buckets                   = 1;
+  while (n_buckets < names.size() / 2) {
+    n_buckets <<= 1;
+  }
+
+  _seed = seed;
+  _disp.assign(n_buckets, 0);
+  _slots.assign(n_slots, Slot{std::string_view{}, E{}});
+  std::vector<bool> used(n_slots);
+
+  // Hash and bucket the names, and place the largest buckets first.
+  std::vector<std::vector<std::pair<uint64_t, size_t>>> buckets(n_buckets);
+  for (size_t idx = 0; idx < names.size(); ++idx) {
+    auto h = hash_of(names[idx].first, seed);
+    buckets[h & (n_buckets - 1)].emplace_back(h, idx);
+  }
+  std::vector<size_t> order(n_buckets);
+  for (size_t idx = 0; idx < n_buckets; ++idx) {
+    order[idx] = idx;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+  std::vector<size_t> spots;
+  for (auto b : order) {
+    auto const& bucket = buckets[b];
+    if (bucket.empty()) {
+      break;
+    }
+    uint32_t d = 0;
+    for (; d < MAX_DISP; ++d) {
+      spots.clear();
+      for (auto const& [h, idx] : bucket) {
+        auto spot = slot_of(h, d, n_slots);
+        if (used[spot] || std::find(spots.begin(), spots.end(), spot) != spots.end()) {
+          break;
+        }
+        spots.push_back(spot);
+      }
+      if (spots.size() == bucket.size()) {
+        break;
+      }
+    }
+    if (d == MAX_DISP) {
+      return false;
+    }
+    _disp[b] = d;
+    for (size_t k = 0; k < spots.size(); ++k) {
+      auto const& [name, value] = names[bucket[k].second];
+      used[spots[k]]            = true;
+      _slots[spots[k]]          = {name, value};
+    }
+  }
+  return true;
+}
+
+template<typename E>
+auto
+Lexicon<E>::freeze() && -> self_type&& {
+  return std::move(this->freeze());
+}
+
+template<typename E>
+auto
+Lexicon<E>::freeze() & -> self_type& {
+  if (_by_name.count() == 0) {
+    _frozen = Frozen{};
+    return *this;
+  }
+  // Build to the side so the current tables are kept if this throws.
+  Frozen frozen;
+
+  std::vector<std::pair<std::string_view, E>> names;
+  for (auto const& item : _by_name) {
+    // Use a non-null view for empty names so it is not treated as missing.
+    names.emplace_back(item._name.data() ? item._name : std::string_view{""}, item._value);
+  }
+  // A minimal table should succeed on the first seed or two. If not, allow a few more slots.
+  for (uint64_t seed = 0; !frozen.build(names, seed * 0x9E3779B97F4A7C15ULL, names.size() + names.size() * seed / 8); ++seed)
+    ;
+
+  // Array of names by value, if it's not mostly empty.
+  auto [min, max] = std::minmax_element(_by_value.begin(), _by_value.end(), [](Item const& lhs, Item const& rhs) {
+    return static_cast<intmax_t>(lhs._value) < static_cast<intmax_t>(rhs._value);
+  });
+  size_t range = static_cast<intmax_t>(max->_value) - static_cast<intmax_t>(min->_value) + 1;
+  if (range <= std::max<size_t>(64, 4 * _by_value.count())) {
+    frozen._min = static_cast<intmax_t>(min->_value);
+    frozen._names.resize(range);
+    for (auto const& item : _by_value) {
+      // Use a non-null view for empty names so it is not treated as missing.
+      frozen._names[static_cast<intmax_t>(item._value) - frozen._min] = item._name.data() ? item._name : std::string_view{""};
+    }
+  }
+  _frozen = std::move(frozen);
+  return *this;
+}
+
+template<typename E>
+bool
+Lexicon<E>::is_frozen() const {
+  return !_frozen._slots.empty();
+}
+
 template<typename E>
 auto
 Lexicon<E>::begin() const -> const_iterator {
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <new>
+#include <atomic>
 #include <mutex>
 #include <memory>
 #include <utility>
@@ -75,6 +76,7 @@ public:
 
   protected:
     friend MemArena;
+    friend class ConcurrentMemArena;
 
     /** Override @c operator @c delete.
      *
@@ -126,6 +128,8 @@ public:
 
   using BlockList = IntrusiveDList<Block::Linkage>;
 
+  class BlockPool;
+
   /** Construct with reservation hint.
    *
    * No memory is initially reserved, but when memory is needed this will be done so at least
@@ -138,8 +142,12 @@ public:
    * @endcode
    *
    * @param n Minimum number of available bytes in the first internally reserved block.
+   * @param pool Block pool.
+   *
+   * If @a pool is not @c nullptr blocks are taken from and returned to @a pool instead of being
+   * allocated and freed. Block sizes are then rounded up to the pool size classes.
    */
-  explicit MemArena(size_t n = DEFAULT_BLOCK_SIZE);
+  explicit MemArena(size_t n = DEFAULT_BLOCK_SIZE, BlockPool *pool = nullptr);
 
   /// no copying
   MemArena(self_type const& that) = delete;
@@ -242,7 +250,8 @@ public:
 
   /** Release all memory.
 
-      Empties the entire arena and deallocates all underlying memory. The hint for the next reserved
+      Empties the entire arena and deallocates all underlying memory, or returns it to the block
+      pool if there is one. The hint for the next reserved
       block size will be @a n if @a n is not zero, otherwise it will be the sum of all allocations
       when this method was called.
 
@@ -313,6 +322,9 @@ public:
 
   const_iterator frozen_end() const;
 
+  /// @return The block pool, or @c nullptr if blocks are not pooled.
+  BlockPool *pool() const;
+
 protected:
   /** Internally allocates a new block of memory of size @a n bytes.
    *
@@ -327,6 +339,9 @@ protected:
   /// Clean up the active list
   void destroy_active();
 
+  /// Free @a block or return it to @a pool.
+  static void release(BlockPool *pool, Block *block);
+
   using Page      = Scalar<4096>; ///< Size for rounding block sizes.
   using Paragraph = Scalar<16>;   ///< Minimum unit of memory allocation.
 
@@ -349,11 +364,128 @@ protected:
   BlockList _frozen; ///< Previous generation, frozen memory.
   BlockList _active; ///< Current generation. Allocate here.
 
+  BlockPool *_pool = nullptr; ///< Source of blocks, if not @c nullptr.
+
   // Note on _active block list - blocks that become full are moved to the end of the list.
   // This means that when searching for a block with space, the first full block encountered
   // marks the last block to check. This keeps the set of blocks to check short.
 };
 
+/** A pool of memory blocks for reuse by arenas.
+ *
+ * Blocks are grouped in size classes, each a power of two number of pages. A block taken from the
+ * pool is the smallest class large enough for the request, and blocks returned to the pool are
+ * kept for reuse rather than freed. Each class keeps at most a fixed number of blocks and the pool
+ * as a whole keeps at most a fixed amount of memory, beyond which returned blocks are freed.
+ *
+ * The pool is thread safe and lock free, so a pool can be shared by arenas in different threads.
+ * Each class is a pair of stacks of slot indices, one of slots with a block and one of empty slots.
+ * A stack head is the index of the top slot and a tag which is incremented on every change, so that
+ * a slot popped and pushed back between another thread reading the head and updating it does not
+ * corrupt the stack.
+ */
+class MemArena::BlockPool {
+  using self_type = BlockPool; ///< Self reference type.
+
+public:
+  /// Number of size classes.
+  static constexpr unsigned N_CLASSES = 12;
+  /// Default maximum number of blocks kept in each class.
+  static constexpr size_t DEFAULT_MAX_BLOCKS = 64;
+  /// Default maximum memory kept in the pool.
+  static constexpr size_t DEFAULT_MAX_BYTES = size_t(64) << 20;
+
+  /// Pool statistics.
+  struct Stats {
+    size_t _hits    = 0; ///< Blocks taken from the pool.
+    size_t _misses  = 0; ///< Blocks allocated because the class was empty.
+    size_t _returns = 0; ///< Blocks returned to the pool.
+    size_t _drops   = 0; ///< Blocks freed because the pool was full or the block was not pooled.
+    size_t _blocks  = 0; ///< Blocks in the pool.
+    size_t _bytes   = 0; ///< Memory in the pool.
+  };
+
+  /** Construct with limits.
+   *
+   * @param max_blocks Maximum number of blocks kept in each class.
+   * @param max_bytes Maximum memory kept in the pool.
+   */
+  explicit BlockPool(size_t max_blocks = DEFAULT_MAX_BLOCKS, size_t max_bytes = DEFAULT_MAX_BYTES);
+
+  /// No copying.
+  BlockPool(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  /// Destructor - pooled blocks are freed.
+  ~BlockPool();
+
+  /** A process wide pool.
+   *
+   * @return The global pool.
+   *
+   * This is never destroyed so it is safe to use from arenas with static storage.
+   */
+  static self_type& global();
+
+  /** Size of the block storage for a class.
+   *
+   * @param c Class index.
+   * @return The available storage of blocks in class @a c.
+   */
+  static constexpr size_t class_size(unsigned c) {
+    return (Page::SCALE << c) - ALLOC_HEADER_SIZE - sizeof(Block);
+  }
+
+  /** Get a block.
+   *
+   * @param n Minimum storage size.
+   * @return A block with at least @a n bytes, or @c nullptr if @a n is larger than any class.
+   *
+   * If the class for @a n is empty a new block is allocated.
+   */
+  Block *take(size_t n);
+
+  /** Return a block.
+   *
+   * @param block Block to return.
+   *
+   * The block is kept if it is the size of a class and there is room, otherwise it is freed.
+   */
+  void give(Block *block);
+
+  /// @return Current statistics.
+  Stats stats() const;
+
+  /// Free all pooled blocks.
+  void clear();
+
+protected:
+  static constexpr uint32_t NIL = ~uint32_t{0}; ///< Invalid slot index.
+
+  /// Blocks for a size class.
+  struct Bin {
+    std::unique_ptr<Block *[]> _blocks;             ///< Block in each slot.
+    std::unique_ptr<std::atomic<uint32_t>[]> _next; ///< Next slot in the same stack.
+    std::atomic<uint64_t> _full{NIL};               ///< Stack of slots with blocks.
+    std::atomic<uint64_t> _empty{NIL};              ///< Stack of empty slots.
+  };
+
+  /// Pop a slot from the stack @a head in @a bin.
+  static uint32_t pop(Bin& bin, std::atomic<uint64_t>& head);
+  /// Push slot @a idx on the stack @a head in @a bin.
+  static void push(Bin& bin, std::atomic<uint64_t>& head, uint32_t idx);
+
+  size_t _max_bytes; ///< Memory limit.
+  Bin _bins[N_CLASSES];
+
+  std::atomic<size_t> _bytes{0};   ///< Pooled memory.
+  std::atomic<size_t> _cleared{0}; ///< Blocks freed by @c clear.
+  std::atomic<size_t> _hits{0};    ///< @see Stats
+  std::atomic<size_t> _misses{0};  ///< @see Stats
+  std::atomic<size_t> _returns{0}; ///< @see Stats
+  std::atomic<size_t> _drops{0};   ///< @see Stats
+};
+
 /** Arena of a specific type on top of a @c MemArena.
  *
  * @tparam T Type in the arena.
@@ -449,7 +581,7 @@ template<typename T, typename... Args> T *MemArena::make(Args&& ... args) {
   return new(this->alloc(sizeof(T)).data()) T(std::forward<Args>(args)...);
 }
 
-inline MemArena::MemArena(size_t n) : _reserve_hint(n) {}
+inline MemArena::MemArena(size_t n, BlockPool *pool) : _reserve_hint(n), _pool(pool) {}
 
 inline MemSpan<void> MemArena::Block::remnant() {
   return {this->data() + allocated, this->remaining()};
@@ -499,6 +631,10 @@ inline auto MemArena::frozen_end() const -> const_iterator {
   return _frozen.end();
 }
 
+inline auto MemArena::pool() const -> BlockPool * {
+  return _pool;
+}
+
 template<typename T> FixedArena<T>::FixedArena(MemArena& arena) : _arena(arena) {
   static_assert(sizeof(T) >= sizeof(T *));
 }
@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    IP space shared between threads, with lock free reads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "swoc/swoc_version.h"
+#include "swoc/swoc_ip.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+/** An @c IPSpace shared by reader and writer threads.
+ *
+ * @tparam PAYLOAD Payload type for the space.
+ *
+ * Readers never block and never write to shared memory other than their own slot. Writers build a
+ * new version of the space to the side and publish it atomically, after which new readers see the
+ * new version. Readers already in progress continue to use the version they started with.
+ *
+ * Each reading thread must register by creating a @c Reader, which is used to enter a read
+ * section with @c Reader::lock. The section is tracked by storing the current epoch in the slot
+ * for the reader. A version that was replaced in epoch @a E is reclaimed once every active reader
+ * slot has an epoch after @a E. Reclamation is done by writers, so a version is never freed by a
+ * reader.
+ *
+ * @code
+ *   SharedIPSpace<unsigned> shared;
+ *   // writer
+ *   shared.update([](IPSpace<unsigned> & space) { space.mark(range, 1); });
+ *   // reader thread
+ *   SharedIPSpace<unsigned>::Reader reader{shared};
+ *   // ...
+ *   if (auto ref = reader.lock() ; ref->find(addr) != ref->end()) { ... }
+ * @endcode
+ */
+template <typename PAYLOAD> class SharedIPSpace {
+  using self_type = SharedIPSpace; ///< Self reference type.
+public:
+  using space_type = IPSpace<PAYLOAD>; ///< Shared space type.
+
+  class Reader;
+  class ReadRef;
+
+  /// Construct with an empty space.
+  SharedIPSpace();
+
+  SharedIPSpace(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  /** Destructor.
+   *
+   * All @c Reader instances must have been destroyed.
+   */
+  ~SharedIPSpace();
+
+  /** Update the space.
+   *
+   * @tparam F Functor to update the space.
+   * @param f Update functor, invoked with a @c space_type reference.
+   * @return @a this
+   *
+   * The current space is copied and @a f invoked on the copy, which is then published. Writers are
+   * serialized, concurrent updates are applied in turn.
+   */
+  template <typename F> self_type& update(F&& f);
+
+  /** Replace the space.
+   *
+   * @tparam F Functor to fill the space.
+   * @param f Fill functor, invoked with a @c space_type reference.
+   * @return @a this
+   *
+   * @a f is invoked on an empty space, which is then published. This is faster than @c update if
+   * the space is reloaded from scratch as the current space is not copied.
+   */
+  template <typename F> self_type& rebuild(F&& f);
+
+  /** Reclaim versions no longer in use.
+   *
+   * @return The number of versions still pending reclamation.
+   *
+   * This is done automatically on every update but can be called to release memory sooner after
+   * readers have moved on to a new version.
+   */
+  size_t reclaim();
+
+  /// @return The current epoch, which increases by one each time a version is published.
+  uint64_t epoch() const { return _epoch.load(std::memory_order_acquire); }
+
+protected:
+  /// A published version of the space.
+  struct Version {
+    space_type _space;     ///< Content.
+    uint64_t _retired = 0; ///< Epoch in which this version was replaced.
+  };
+
+  /// Per reader state. Aligned so each reader has its own cache line.
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> _epoch{0}; ///< Epoch of the active read section, 0 if none.
+    bool _in_use_p = false;          ///< Slot is assigned to a @c Reader.
+  };
+
+  std::atomic<Version *> _current{nullptr}; ///< Current version.
+  std::atomic<uint64_t> _epoch{1};          ///< Current epoch.
+
+  std::mutex _write_mutex;         ///< Serialize writers.
+  std::vector<Version *> _retired; ///< Replaced versions waiting for readers to finish.
+  std::unique_ptr<Version> _spare; ///< A reclaimed version kept for reuse.
+
+  std::mutex _slot_mutex;                    ///< Protects @a _slots.
+  std::vector<std::unique_ptr<Slot>> _slots; ///< Reader slots.
+
+  /// @return A version with an empty space, reusing the spare if available.
+  std::unique_ptr<Version> make_version();
+
+  /// Publish @a v as the current version. @a _write_mutex must be held.
+  void publish(std::unique_ptr<Version> v);
+
+  /// Reclaim versions. @a _write_mutex must be held.
+  size_t reclaim_locked();
+
+  /// Assign a slot to a new reader.
+  Slot *acquire_slot();
+
+  /// Release a slot from a reader.
+  void release_slot(Slot *slot);
+};
+
+/** Registration of a reader thread.
+ *
+ * Create one for each thread that reads the space. An instance must not be used concurrently by
+ * multiple threads.
+ */
+template <typename PAYLOAD> class SharedIPSpace<PAYLOAD>::Reader {
+  using self_type = Reader; ///< Self reference type.
+public:
+  /// Register a reader for @a shared.
+  explicit Reader(SharedIPSpace& shared);
+
+  Reader(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  /// Unregister.
+  ~Reader();
+
+  /** Enter a read section.
+   *
+   * @return A reference to the current space, valid as long as the returned object.
+   *
+   * Read sections for the same reader must not be nested.
+   */
+  ReadRef lock();
+
+protected:
+  SharedIPSpace *_shared; ///< Shared space.
+  Slot *_slot;            ///< Slot for this reader.
+};
+
+/** A read section.
+ *
+ * This provides access to the space that was current when the section was entered.
+ */
+template <typename PAYLOAD> class SharedIPSpace<PAYLOAD>::ReadRef {
+  using self_type = ReadRef; ///< Self reference type.
+  friend class Reader;
+public:
+  ReadRef(self_type const& that) = delete;
+  self_type& operator=(self_type const& that) = delete;
+
+  /// Move constructor.
+  ReadRef(self_type&& that) : _slot(that._slot), _space(that._space) { that._slot = nullptr; }
+
+  /// Leave the read section.
+  ~ReadRef() {
+    if (_slot) {
+      _slot->_epoch.store(0, std::memory_order_release);
+    }
+  }
+
+  /// @return The space.
+  space_type const& operator*() const { return *_space; }
+
+  /// @return The space.
+  space_type const *operator->() const { return _space; }
+
+protected:
+  Slot *_slot;              ///< Reader slot.
+  space_type const *_space; ///< Space for this section.
+
+  ReadRef(Slot *slot, space_type const *space) : _slot(slot), _space(space) {}
+};
+
+// --- Implementation
+
+template <typename PAYLOAD> SharedIPSpace<PAYLOAD>::SharedIPSpace() {
+  _current.store(new Version, std::memory_order_release);
+}
+
+template <typename PAYLOAD> SharedIPSpace<PAYLOAD>::~SharedIPSpace() {
+  delete _current.load(std::memory_order_acquire);
+  for (auto v : _retired) {
+    delete v;
+  }
+}
+
+template <typename PAYLOAD>
+auto
+SharedIPSpace<PAYLOAD>::make_version() -> std::unique_ptr<Version> {
+  if (_spare) {
+    return std::move(_spare);
+  }
+  return std::make_unique<Version>();
+}
+
+template <typename PAYLOAD>
+template <typename F>
+auto
+SharedIPSpace<PAYLOAD>::update(F&& f) -> self_type& {
+  std::lock_guard lock(_write_mutex);
+  auto v = this->make_version();
+  // Writers are serialized so the current version can't be reclaimed during the copy. The ranges
+  // are in order so the copy is a linear bulk load.
+  auto const& current = _current.load(std::memory_order_acquire)->_space;
+  v->_space.load(current.begin(), current.end());
+  f(v->_space); // if this throws @a v is released, the current version is unchanged.
+  this->publish(std::move(v));
+  return *this;
+}
+
+template <typename PAYLOAD>
+template <typename F>
+auto
+SharedIPSpace<PAYLOAD>::rebuild(F&& f) -> self_type& {
+  std::lock_guard lock(_write_mutex);
+  auto v = this->make_version();
+  f(v->_space);
+  this->publish(std::move(v));
+  return *this;
+}
+
+template <typename PAYLOAD>
+void
+SharedIPSpace<PAYLOAD>::publish(std::unique_ptr<Version> v) {
+  // Make room first so that nothing can throw after the swap.
+  _retired.reserve(_retired.size() + 1);
+  // The epoch is advanced after the swap - a reader that sees the new epoch must see @a v.
+  auto old      = _current.exchange(v.release(), std::memory_order_seq_cst);
+  old->_retired = _epoch.fetch_add(1, std::memory_order_seq_cst);
+  _retired.push_back(old);
+  this->reclaim_locked();
+}
+
+template <typename PAYLOAD>
+size_t
+SharedIPSpace<PAYLOAD>::reclaim() {
+  std::lock_guard lock(_write_mutex);
+  return this->reclaim_locked();
+}
+
+template <typename PAYLOAD>
+size_t
+SharedIPSpace<PAYLOAD>::reclaim_locked() {
+  // Find the oldest epoch of any active reader - versions retired before that are not in use.
+  auto oldest = std::numeric_limits<uint64_t>::max();
+  {
+    std::lock_guard lock(_slot_mutex);
+    for (auto const& slot : _slots) {
+      if (auto e = slot->_epoch.load(std::memory_order_seq_cst); e != 0 && e < oldest) {
+        oldest = e;
+      }
+    }
+  }
+
+  auto spot = _retired.begin();
+  for (auto v : _retired) {
+    if (v->_retired < oldest) {
+      if (_spare) {
+        delete v;
+      } else {
+        // The arena reserve hint is kept so the next version is allocated in a single block.
+        v->_space.clear();
+        _spare.reset(v);
+      }
+    } else {
+      *spot++ = v;
+    }
+  }
+  _retired.erase(spot, _retired.end());
+  return _retired.size();
+}
+
+template <typename PAYLOAD>
+auto
+SharedIPSpace<PAYLOAD>::acquire_slot() -> Slot * {
+  std::lock_guard lock(_slot_mutex);
+  for (auto& slot : _slots) {
+    if (!slot->_in_use_p) {
+      slot->_in_use_p = true;
+      return slot.get();
+    }
+  }
+  _slots.emplace_back(new Slot);
+  _slots.back()->_in_use_p = true;
+  return _slots.back().get();
+}
+
+template <typename PAYLOAD>
+void
+SharedIPSpace<PAYLOAD>::release_slot(Slot *slot) {
+  std::lock_guard lock(_slot_mutex);
+  slot->_epoch.store(0, std::memory_order_release);
+  slot->_in_use_p = false;
+}
+
+template <typename PAYLOAD> SharedIPSpace<PAYLOAD>::Reader::Reader(SharedIPSpace& shared) : _shared(&shared) {
+  _slot = _shared->acquire_slot();
+}
+
+template <typename PAYLOAD> SharedIPSpace<PAYLOAD>::Reader::~Reader() {
+  _shared->release_slot(_slot);
+}
+
+template <typename PAYLOAD>
+auto
+SharedIPSpace<PAYLOAD>::Reader::lock() -> ReadRef {
+  // The slot store must be visible before the version is loaded, otherwise a writer could miss
+  // this reader and reclaim the version. Both are sequentially consistent to order them with the
+  // writer's swap and slot scan.
+  _slot->_epoch.store(_shared->_epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+  return ReadRef{_slot, &_shared->_current.load(std::memory_order_seq_cst)->_space};
+}
+
+}} // namespace swoc
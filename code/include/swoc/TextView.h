@@ -13,11 +13,13 @@
 
 #pragma once
 #include <bitset>
+#include <cstdint>
 #include <iosfwd>
 #include <memory.h>
 #include <string>
 #include <string_view>
 #include <limits>
+#include <system_error>
 
 #include "swoc/swoc_version.h"
 
@@ -76,6 +78,55 @@ namespace swoc { inline namespace SWOC_VERSION_NS {
 
 class TextView;
 
+/** A set of characters.
+ *
+ * This is intended to be constructed once, usually as a @c constexpr or @c static value, and then
+ * used repeatedly to search or trim views. It can be passed to @c TextView methods in place of a
+ * string of delimiters, which avoids building the set on every call and enables vectorized
+ * searching for sets of any size. It is also a character predicate and so can be used with the
+ * "if" methods, e.g. @c TextView::ltrim_if.
+ *
+ * @code
+ * static constexpr swoc::CharSet Whitespace{" \t\r\n"};
+ * auto token = text.ltrim(Whitespace).take_prefix_at(Whitespace);
+ * @endcode
+ */
+class CharSet {
+  using self_type = CharSet; ///< Self reference type.
+  friend TextView;
+
+public:
+  /// Construct an empty set.
+  constexpr CharSet() = default;
+
+  /** Construct a set containing the characters in @a chars.
+   *
+   * @param chars Characters for the set.
+   */
+  explicit constexpr CharSet(std::string_view chars) noexcept;
+
+  /** Add @a c to the set.
+   *
+   * @param c Character.
+   * @return @a this
+   */
+  constexpr self_type &add(char c) noexcept;
+
+  /// @return @c true if @a c is in the set, @c false if not.
+  constexpr bool contains(char c) const noexcept;
+
+  /// @return @c true if @a c is in the set, @c false if not.
+  constexpr bool operator()(char c) const noexcept;
+
+protected:
+  uint64_t _bits[4] = {0, 0, 0, 0}; ///< Bit map of characters.
+  /** Vectorized lookup tables, indexed by the low nibble of a character, with a bit for each value
+   * of the high nibble. The first 16 bytes are for characters less than 0x80, and the second 16
+   * bytes for the rest.
+   */
+  uint8_t _nibbles[32] = {0};
+};
+
 /** A read only view of a contiguous piece of memory.
 
     A @c TextView does not own the memory to which it refers, it is simply a view of part of some
@@ -218,8 +269,12 @@ public:
 
   /// Get the offset of the first character for which @a pred is @c true.
   template <typename F> size_t find_if(F const &pred) const;
+  /// Get the offset of the first character in @a set.
+  size_t find_if(CharSet const &set) const;
   /// Get the offset of the last character for which @a pred is @c true.
   template <typename F> size_t rfind_if(F const &pred) const;
+  /// Get the offset of the last character in @a set.
+  size_t rfind_if(CharSet const &set) const;
 
   /** Remove bytes that match @a c from the start of the view.
    *
@@ -241,6 +296,12 @@ public:
    */
   self_type &ltrim(const char *delimiters);
 
+  /** Remove bytes from the start of the view that are in @a set.
+   *
+   * @return @a this
+   */
+  self_type &ltrim(CharSet const &set);
+
   /** Remove bytes from the start of the view for which @a pred is @c true.
       @a pred must be a functor taking a @c char argument and returning @c bool.
       @return @c *this
@@ -258,6 +319,12 @@ public:
    */
   self_type &rtrim(std::string_view const &delimiters);
 
+  /** Remove bytes from the end of the view that are in @a set.
+   *
+   * @return @a this
+   */
+  self_type &rtrim(CharSet const &set);
+
   /** Remove bytes from the end of the view for which @a pred is @c true.
    *
    * @a pred must be a functor taking a @c char argument and returning @c bool.
@@ -283,6 +350,12 @@ public:
   */
   self_type &trim(const char *delimiters);
 
+  /** Remove bytes from the start and end of the view that are in @a set.
+   *
+   * @return @a this
+   */
+  self_type &trim(CharSet const &set);
+
   /** Remove bytes from the start and end of the view for which @a pred is @c true.
       @a pred must be a functor taking a @c char argument and returning @c bool.
       @return @c *this
@@ -315,6 +388,13 @@ public:
    */
   self_type prefix_at(std::string_view const &delimiters) const;
 
+  /** Get a view of a prefix bounded by a character in @a set.
+   *
+   * @param set Delimiter characters.
+   * @return A view of the prefix bounded by any character in @a set, or empty if none are found.
+   */
+  self_type prefix_at(CharSet const &set) const;
+
   /** Get a view of a prefix bounded by a character predicate @a pred.
    *
    * @a pred must be a functor which takes a @c char argument and returns @c bool. Each character in
@@ -362,6 +442,13 @@ public:
    */
   self_type &remove_prefix_at(std::string_view const &delimiters);
 
+  /** Remove the leading characters of @a this up to and including the first character in @a set.
+   *
+   * @param set Characters to match.
+   * @return @a this
+   */
+  self_type &remove_prefix_at(CharSet const &set);
+
   /** Remove the leading characters up to and including the character selected by @a pred.
    *
    * @tparam F Predicate function type.
@@ -410,6 +497,13 @@ public:
    */
   self_type split_prefix_at(std::string_view const &delimiters);
 
+  /** Remove and return a prefix bounded by the first character in @a set.
+   *
+   * @param set The characters to match.
+   * @return The prefix bounded by a character in @a set if one is found, otherwise an empty view.
+   */
+  self_type split_prefix_at(CharSet const &set);
+
   /** Remove and return a prefix bounded by the first character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -467,6 +561,13 @@ public:
    */
   self_type take_prefix_at(std::string_view const &delimiters);
 
+  /** Remove and return a prefix bounded by the first character in @a set.
+   *
+   * @param set The characters to match.
+   * @return The prefix bounded by a character in @a set if one is found, otherwise all of @a this.
+   */
+  self_type take_prefix_at(CharSet const &set);
+
   /** Remove and return a prefix bounded by the first character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -509,6 +610,13 @@ public:
    */
   self_type suffix_at(std::string_view const &delimiters) const;
 
+  /** Get a view of a suffix bounded by a character in @a set.
+   *
+   * @param set Delimiter characters.
+   * @return A view of the suffix bounded by any character in @a set, or empty if none are found.
+   */
+  self_type suffix_at(CharSet const &set) const;
+
   /** Get a view of a suffix bounded by a character predicate @a pred.
    *
    * @a pred must be a functor which takes a @c char argument and returns @c bool. Each character in
@@ -543,6 +651,13 @@ public:
    */
   self_type &remove_suffix_at(std::string_view const &delimiters);
 
+  /** Remove the trailing characters of @a this up to and including the last character in @a set.
+   *
+   * @param set Characters to match.
+   * @return @a this
+   */
+  self_type &remove_suffix_at(CharSet const &set);
+
   /** Remove the trailing characters up to and including the character selected by @a pred.
    *
    * @tparam F Predicate function type.
@@ -591,6 +706,13 @@ public:
    */
   self_type split_suffix_at(std::string_view const &delimiters);
 
+  /** Remove and return a suffix bounded by the last character in @a set.
+   *
+   * @param set The characters to match.
+   * @return The suffix bounded by a character in @a set if one is found, otherwise an empty view.
+   */
+  self_type split_suffix_at(CharSet const &set);
+
   /** Remove and return a suffix bounded by the last character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -640,6 +762,13 @@ public:
    */
   self_type take_suffix_at(std::string_view const &delimiters);
 
+  /** Remove and return a suffix bounded by the last character in @a set.
+   *
+   * @param set The characters to match.
+   * @return The suffix bounded by a character in @a set if one is found, otherwise all of @a this.
+   */
+  self_type take_suffix_at(CharSet const &set);
+
   /** Remove and return a suffix bounded by the last character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -746,12 +875,57 @@ public:
 protected:
   /// Initialize a bit mask to mark which characters are in this view.
   static void init_delimiter_set(std::string_view const &delimiters, std::bitset<256> &set);
+
+  /** Find the first byte in @a src that is, or is not, in @a delimiters.
+   *
+   * @param src Text to search.
+   * @param delimiters Set of characters.
+   * @param in_p @c true to find a byte in @a delimiters, @c false to find a byte not in @a delimiters.
+   * @return The offset of the byte, or @c npos if not found.
+   *
+   * This is vectorized where the CPU supports it, for small sets of @a delimiters.
+   */
+  static size_t find_first_in(std::string_view const &src, std::string_view const &delimiters, bool in_p);
+
+  /** Find the last byte in @a src that is, or is not, in @a delimiters.
+   *
+   * @param src Text to search.
+   * @param delimiters Set of characters.
+   * @param in_p @c true to find a byte in @a delimiters, @c false to find a byte not in @a delimiters.
+   * @return The offset of the byte, or @c npos if not found.
+   *
+   * This is vectorized where the CPU supports it, for small sets of @a delimiters.
+   */
+  static size_t find_last_in(std::string_view const &src, std::string_view const &delimiters, bool in_p);
+
+  /// Find the first byte in @a src that is, or is not, in @a set.
+  static size_t find_first_in(std::string_view const &src, CharSet const &set, bool in_p);
+
+  /// Find the last byte in @a src that is, or is not, in @a set.
+  static size_t find_last_in(std::string_view const &src, CharSet const &set, bool in_p);
 };
 
 /// Internal table of digit values for characters.
 /// This is -1 for characters that are not valid digits.
 extern const int8_t svtoi_convert[256];
 
+/** Result of a checked numeric conversion.
+ *
+ * @tparam T Numeric type.
+ *
+ * On overflow all of the digits are parsed, @a value is the limit of @a T in the direction of the
+ * overflow, and @a error is @c std::errc::result_out_of_range. If there are no digits, @a parsed
+ * is empty and @a error is @c std::errc::invalid_argument.
+ */
+template <typename T> struct ParsedNumber {
+  T value{0};        ///< Converted value.
+  TextView parsed;   ///< Text that was parsed.
+  std::errc error{}; ///< Conversion error, if any.
+
+  /// @return @c true if the conversion succeeded, @c false if not.
+  explicit operator bool() const { return error == std::errc{}; }
+};
+
 /** Convert the text in @c TextView @a src to a signed numeric value.
 
     If @a parsed is non-null then the part of the string actually parsed is placed there.
@@ -760,10 +934,21 @@ extern const int8_t svtoi_convert[256];
     - If the number starts with a literal '0' then it is treated as base 8.
     - If the number starts with the literal characters '0x' or '0X' then it is treated as base 16.
 
-    If @a base is explicitly set then any leading radix indicator is not supported.
+    If @a base is explicitly set then any leading radix indicator is not supported. On overflow the
+    value is clamped to the range of @c intmax_t.
 */
 intmax_t svtoi(TextView src, TextView *parsed = nullptr, int base = 0);
 
+/** Convert the text in @a src to a signed numeric value, with error checking.
+ *
+ * @param src Text to convert.
+ * @param base Conversion base, as for @c svtoi.
+ * @return The conversion result.
+ *
+ * Leading whitespace is skipped.
+ */
+ParsedNumber<intmax_t> svtoi_checked(TextView src, int base = 0);
+
 /** Convert the text in @c TextView @a src to an unsigned numeric value.
 
     If @a parsed is non-null then the part of the string actually parsed is placed there.
@@ -772,10 +957,37 @@ intmax_t svtoi(TextView src, TextView *parsed = nullptr, int base = 0);
     - If the number starts with a literal '0' then it is treated as base 8.
     - If the number starts with the literal characters '0x' or '0X' then it is treated as base 16.
 
-    If @a base is explicitly set then any leading radix indicator is not supported.
+    If @a base is explicitly set then any leading radix indicator is not supported. On overflow the
+    maximum value is returned.
 */
 uintmax_t svtou(TextView src, TextView *parsed = nullptr, int base = 0);
 
+/** Convert the text in @a src to an unsigned numeric value, with error checking.
+ *
+ * @param src Text to convert.
+ * @param base Conversion base, as for @c svtou.
+ * @return The conversion result.
+ *
+ * Leading whitespace is skipped.
+ */
+ParsedNumber<uintmax_t> svtou_checked(TextView src, int base = 0);
+
+/** Convert the text in @c src to an unsigned numeric value, with error checking.
+ *
+ * @tparam N The radix (must be 1..36)
+ * @param src The source text.
+ * @return The conversion result.
+ *
+ * Parsing stops on the first invalid digit, so any leading non-digit characters must already be
+ * removed. Radix 10 and 16 are converted up to 8 digits at a time.
+ */
+template <int N> ParsedNumber<uintmax_t> svto_radix_checked(TextView src);
+
+/// @cond INTERNAL_DETAIL
+template <> ParsedNumber<uintmax_t> svto_radix_checked<10>(TextView src);
+template <> ParsedNumber<uintmax_t> svto_radix_checked<16>(TextView src);
+/// @endcond
+
 /** Convert the text in @c src to an unsigned numeric value.
  *
  * @tparam N The radix (must be  1..36)
@@ -794,28 +1006,39 @@ uintmax_t svtou(TextView src, TextView *parsed = nullptr, int base = 0);
  * only positive values are parsed. If determining the radix from the text or signed value parsing
  * is needed, used @c svtoi.
  *
- * @a src is updated in place to indicate what characters were parsed. Parsing stops on the first
- * invalid digit, so any leading non-digit characters (e.g. whitespace) must already be removed.
  * @a src is updated in place by removing parsed characters. Parsing stops on the first invalid
  * digit, so any leading non-digit characters (e.g. whitespace) must already be removed. Overflow
- * is detected and the first digit that would overflow is not parsed, and the maximum value is
- * returned.
+ * is detected, in which case all of the digits are parsed and the maximum value is returned.
+ *
+ * @see svto_radix_checked
  */
 template <int N>
 uintmax_t
 svto_radix(swoc::TextView &src) {
+  auto zret = svto_radix_checked<N>(src);
+  src.remove_prefix(zret.parsed.size());
+  return zret.value;
+}
+
+template <int N>
+ParsedNumber<uintmax_t>
+svto_radix_checked(TextView src) {
   static_assert(0 < N && N <= 36, "Radix must be in the range 1..36");
-  uintmax_t zret{0};
+  ParsedNumber<uintmax_t> zret;
+  bool overflow_p   = false;
+  char const *spot  = src.data();
+  char const *limit = src.data_end();
   int8_t v;
-  while (src.size() && (0 <= (v = swoc::svtoi_convert[uint8_t(*src)])) && v < N)
-  {
-    auto n = zret * N + v;
-    if (n < zret)
-    { // overflow / wrap
-      return std::numeric_limits<uintmax_t>::max();
-    }
-    zret = n;
-    ++src;
+  for (; spot < limit && 0 <= (v = svtoi_convert[uint8_t(*spot)]) && v < N; ++spot) {
+    overflow_p |= __builtin_mul_overflow(zret.value, uintmax_t(N), &zret.value);
+    overflow_p |= __builtin_add_overflow(zret.value, uintmax_t(v), &zret.value);
+  }
+  zret.parsed.assign(src.data(), spot);
+  if (overflow_p) {
+    zret.value = std::numeric_limits<uintmax_t>::max();
+    zret.error = std::errc::result_out_of_range;
+  } else if (zret.parsed.empty()) {
+    zret.error = std::errc::invalid_argument;
   }
   return zret;
 }
@@ -837,17 +1060,55 @@ svto_radix(swoc::TextView &&src) {
  * If @a parsed is not @a nullptr then the span of characters parsed is put there. This can be
  * used to check if the parse was scuccesful - on a failed parse, it will be empty.
  *
- * @note This should be within 1 epsilon of correct, although it doesn't guarantee picking
- * the closest epsilon. It's more than sufficient for use in configurations, but possibly
- * not for high precision work.
+ * The accepted format is an optional sign, decimal digits with an optional decimal point, and an
+ * optional exponent. The result is correctly rounded, the same as @c strtod in the "C" locale,
+ * and does not depend on the current locale. No memory is allocated.
+ */
+double svtod(swoc::TextView text, swoc::TextView *parsed = nullptr);
+
+/** Parse @a text as a floating point number, with error checking.
+ *
+ * @param text The input text.
+ * @return The conversion result.
+ *
+ * The format is the same as for @c svtod. If there are no digits the error is
+ * @c std::errc::invalid_argument. If the value is too large the value is infinity, and if it is
+ * too small but not zero the value is zero, and in both cases the error is
+ * @c std::errc::result_out_of_range.
  */
-double svtod(swoc::TextView text, swoc::TextView * parsed = nullptr);
+ParsedNumber<double> svtod_checked(TextView text);
 // ----------------------------------------------------------
 // Inline implementations.
 // Note: Why, you may ask, do I use @c TextView::self_type for return type instead of the
 // simpler plain @c TextView ? Because otherwise Doxygen can't match up the declaration and
 // definition and the reference documentation is messed up. Sigh.
 
+// === CharSet Implementation ===
+inline constexpr CharSet::CharSet(std::string_view chars) noexcept {
+  for (char c : chars) {
+    this->add(c);
+  }
+}
+
+inline constexpr CharSet &
+CharSet::add(char c) noexcept {
+  auto u = static_cast<uint8_t>(c);
+  _bits[u >> 6] |= uint64_t(1) << (u & 0x3F);
+  _nibbles[(u & 0x0F) + (u & 0x80 ? 16 : 0)] |= uint8_t(1) << ((u >> 4) & 0x7);
+  return *this;
+}
+
+inline constexpr bool
+CharSet::contains(char c) const noexcept {
+  auto u = static_cast<uint8_t>(c);
+  return (_bits[u >> 6] >> (u & 0x3F)) & 1;
+}
+
+inline constexpr bool
+CharSet::operator()(char c) const noexcept {
+  return this->contains(c);
+}
+
 // === TextView Implementation ===
 inline constexpr TextView::TextView(const char *ptr, size_t n) noexcept
   : super_type(ptr, n == npos ? ( ptr ? ::strlen(ptr) : 0 ) : n) {}
@@ -965,7 +1226,17 @@ TextView::prefix_at(char c) const {
 inline TextView
 TextView::prefix_at(std::string_view const &delimiters) const {
   self_type zret; // default to empty return.
-  if (auto n = this->find_first_of(delimiters); n != npos)
+  if (auto n = this->find_first_in(*this, delimiters, true); n != npos)
+  {
+    zret.assign(this->data(), n);
+  }
+  return zret;
+}
+
+inline TextView
+TextView::prefix_at(CharSet const &set) const {
+  self_type zret; // default to empty return.
+  if (auto n = this->find_if(set); n != npos)
   {
     zret.assign(this->data(), n);
   }
@@ -1000,7 +1271,16 @@ TextView::remove_prefix_at(char c) {
 
 inline TextView &
 TextView::remove_prefix_at(std::string_view const &delimiters) {
-  if (auto n = this->find_first_of(delimiters); n != npos)
+  if (auto n = this->find_first_in(*this, delimiters, true); n != npos)
+  {
+    this->super_type::remove_prefix(n + 1);
+  }
+  return *this;
+}
+
+inline TextView &
+TextView::remove_prefix_at(CharSet const &set) {
+  if (auto n = this->find_if(set); n != npos)
   {
     this->super_type::remove_prefix(n + 1);
   }
@@ -1040,7 +1320,12 @@ TextView::split_prefix_at(char c) {
 
 inline TextView
 TextView::split_prefix_at(std::string_view const &delimiters) {
-  return this->split_prefix(this->find_first_of(delimiters));
+  return this->split_prefix(this->find_first_in(*this, delimiters, true));
+}
+
+inline TextView
+TextView::split_prefix_at(CharSet const &set) {
+  return this->split_prefix(this->find_if(set));
 }
 
 template <typename F>
@@ -1064,7 +1349,12 @@ TextView::take_prefix_at(char c) {
 
 inline TextView
 TextView::take_prefix_at(std::string_view const &delimiters) {
-  return this->take_prefix(this->find_first_of(delimiters));
+  return this->take_prefix(this->find_first_in(*this, delimiters, true));
+}
+
+inline TextView
+TextView::take_prefix_at(CharSet const &set) {
+  return this->take_prefix(this->find_if(set));
 }
 
 template <typename F>
@@ -1087,7 +1377,7 @@ TextView::suffix(int n) const noexcept {
 inline TextView
 TextView::suffix_at(char c) const {
   self_type zret;
-  if (auto n = this->rfind(c); n != npos)
+  if (auto n = this->find_last_in(*this, {&c, 1}, true); n != npos)
   {
     ++n;
     zret.assign(this->data() + n, this->size() - n);
@@ -1098,7 +1388,18 @@ TextView::suffix_at(char c) const {
 inline TextView
 TextView::suffix_at(std::string_view const &delimiters) const {
   self_type zret;
-  if (auto n = this->find_last_of(delimiters); n != npos)
+  if (auto n = this->find_last_in(*this, delimiters, true); n != npos)
+  {
+    ++n;
+    zret.assign(this->data() + n, this->size() - n);
+  }
+  return zret;
+}
+
+inline TextView
+TextView::suffix_at(CharSet const &set) const {
+  self_type zret;
+  if (auto n = this->rfind_if(set); n != npos)
   {
     ++n;
     zret.assign(this->data() + n, this->size() - n);
@@ -1126,7 +1427,7 @@ TextView::remove_suffix(size_t n) -> self_type & {
 
 inline TextView &
 TextView::remove_suffix_at(char c) {
-  if (auto n = this->rfind(c); n != npos)
+  if (auto n = this->find_last_in(*this, {&c, 1}, true); n != npos)
   {
     this->remove_suffix(this->size() - n);
   }
@@ -1135,7 +1436,16 @@ TextView::remove_suffix_at(char c) {
 
 inline TextView &
 TextView::remove_suffix_at(std::string_view const &delimiters) {
-  if (auto n = this->find_last_of(delimiters); n != npos)
+  if (auto n = this->find_last_in(*this, delimiters, true); n != npos)
+  {
+    this->remove_suffix(this->size() - n);
+  }
+  return *this;
+}
+
+inline TextView &
+TextView::remove_suffix_at(CharSet const &set) {
+  if (auto n = this->rfind_if(set); n != npos)
   {
     this->remove_suffix(this->size() - n);
   }
@@ -1168,13 +1478,19 @@ TextView::split_suffix(int n) -> self_type {
 
 inline TextView
 TextView::split_suffix_at(char c) {
-  auto idx = this->rfind(c);
+  auto idx = this->find_last_in(*this, {&c, 1}, true);
   return npos == idx ? self_type{} : this->split_suffix(this->size() - (idx + 1));
 }
 
 inline auto
 TextView::split_suffix_at(std::string_view const &delimiters) -> self_type {
-  auto idx = this->find_last_of(delimiters);
+  auto idx = this->find_last_in(*this, delimiters, true);
+  return npos == idx ? self_type{} : this->split_suffix(this->size() - (idx + 1));
+}
+
+inline auto
+TextView::split_suffix_at(CharSet const &set) -> self_type {
+  auto idx = this->rfind_if(set);
   return npos == idx ? self_type{} : this->split_suffix(this->size() - (idx + 1));
 }
 
@@ -1198,12 +1514,17 @@ TextView::take_suffix(int n) {
 
 inline TextView
 TextView::take_suffix_at(char c) {
-  return this->take_suffix(this->rfind(c));
+  return this->take_suffix(this->find_last_in(*this, {&c, 1}, true));
 }
 
 inline TextView
 TextView::take_suffix_at(std::string_view const &delimiters) {
-  return this->take_suffix(this->find_last_of(delimiters));
+  return this->take_suffix(this->find_last_in(*this, delimiters, true));
+}
+
+inline TextView
+TextView::take_suffix_at(CharSet const &set) {
+  return this->take_suffix(this->rfind_if(set));
 }
 
 template <typename F>
@@ -1230,15 +1551,25 @@ TextView::rfind_if(F const &pred) const {
   return npos;
 }
 
+inline size_t
+TextView::find_if(CharSet const &set) const {
+  return this->find_first_in(*this, set, true);
+}
+
+inline size_t
+TextView::rfind_if(CharSet const &set) const {
+  return this->find_last_in(*this, set, true);
+}
+
 inline TextView &
 TextView::ltrim(char c) {
-  this->remove_prefix(this->find_first_not_of(c));
+  this->remove_prefix(this->find_first_in(*this, {&c, 1}, false));
   return *this;
 }
 
 inline TextView &
 TextView::rtrim(char c) {
-  auto n = this->find_last_not_of(c);
+  auto n = this->find_last_in(*this, {&c, 1}, false);
   this->remove_suffix(this->size() - (n == npos ? 0 : n + 1));
   return *this;
 }
@@ -1250,15 +1581,13 @@ TextView::trim(char c) {
 
 inline TextView &
 TextView::ltrim(std::string_view const &delimiters) {
-  std::bitset<256> valid;
-  this->init_delimiter_set(delimiters, valid);
-  const char *spot;
-  const char *limit;
-
-  for (spot = this->data(), limit = this->data_end(); spot < limit && valid[static_cast<uint8_t>(*spot)]; ++spot)
-    ;
-  this->remove_prefix(spot - this->data());
+  this->remove_prefix(this->find_first_in(*this, delimiters, false));
+  return *this;
+}
 
+inline TextView &
+TextView::ltrim(CharSet const &set) {
+  this->remove_prefix(this->find_first_in(*this, set, false));
   return *this;
 }
 
@@ -1269,37 +1598,26 @@ TextView::ltrim(const char *delimiters) {
 
 inline TextView &
 TextView::rtrim(std::string_view const &delimiters) {
-  std::bitset<256> valid;
-  this->init_delimiter_set(delimiters, valid);
-  const char *spot  = this->data_end();
-  const char *limit = this->data();
-
-  while (limit < spot-- && valid[static_cast<uint8_t>(*spot)])
-    ;
+  auto n = this->find_last_in(*this, delimiters, false);
+  this->remove_suffix(this->size() - (n == npos ? 0 : n + 1));
+  return *this;
+}
 
-  this->remove_suffix(this->data_end() - (spot + 1));
+inline TextView &
+TextView::rtrim(CharSet const &set) {
+  auto n = this->find_last_in(*this, set, false);
+  this->remove_suffix(this->size() - (n == npos ? 0 : n + 1));
   return *this;
 }
 
 inline TextView &
 TextView::trim(std::string_view const &delimiters) {
-  std::bitset<256> valid;
-  this->init_delimiter_set(delimiters, valid);
-  const char *spot;
-  const char *limit;
-
-  // Do this explicitly, so we don't have to initialize the character set twice.
-  for (spot = this->data(), limit = this->data_end(); spot < limit && valid[static_cast<uint8_t>(*spot)]; ++spot)
-    ;
-  this->remove_prefix(spot - this->data());
-
-  spot  = this->data_end();
-  limit = this->data();
-  while (limit < spot-- && valid[static_cast<uint8_t>(*spot)])
-    ;
-  this->remove_suffix(this->data_end() - (spot + 1));
+  return this->ltrim(delimiters).rtrim(delimiters);
+}
 
-  return *this;
+inline TextView &
+TextView::trim(CharSet const &set) {
+  return this->ltrim(set).rtrim(set);
 }
 
 inline TextView &
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <cstdlib>
 #include <utility>
 #include <cstring>
@@ -19,6 +20,7 @@
 #include <tuple>
 #include <any>
 #include <array>
+#include <stdexcept>
 
 #include "swoc/swoc_version.h"
 #include "swoc/TextView.h"
@@ -187,6 +189,235 @@ protected:
   std::vector<Spec> _items; ///< Items from format string.
 };
 
+/// @cond INTERNAL_DETAIL
+namespace detail {
+// Compile time versions of the format string parsing in @c Format::TextViewExtractor::parse and
+// @c Spec::parse. These must produce the same results.
+
+constexpr bool
+is_digit(char c) {
+  return '0' <= c && c <= '9';
+}
+
+constexpr int
+hex_value(char c) {
+  return is_digit(c) ? c - '0' : ('a' <= c && c <= 'f') ? c - 'a' + 10 : ('A' <= c && c <= 'F') ? c - 'A' + 10 : -1;
+}
+
+constexpr Spec::Align
+align_of(char c) {
+  switch (c) {
+  case '<':
+    return Spec::Align::LEFT;
+  case '>':
+    return Spec::Align::RIGHT;
+  case '^':
+    return Spec::Align::CENTER;
+  case '=':
+    return Spec::Align::SIGN;
+  }
+  return Spec::Align::NONE;
+}
+
+constexpr bool
+is_type(char c) {
+  return std::string_view{"bBdeEfFgopPsSxX"}.find(c) != std::string_view::npos;
+}
+
+/// Parse leading decimal digits from @a text in to @a n. @return @c true if there were digits.
+constexpr bool
+parse_number(std::string_view& text, unsigned &n) {
+  size_t idx = 0;
+  for (n = 0; idx < text.size() && is_digit(text[idx]); ++idx) {
+    n = n * 10 + (text[idx] - '0');
+  }
+  text.remove_prefix(idx);
+  return idx > 0;
+}
+
+/// Parse the specifier @a fmt in to @a spec.
+constexpr void
+parse_spec(std::string_view fmt, Spec& spec) {
+  auto colon = fmt.find(':');
+  spec._name = fmt.substr(0, colon);
+  fmt.remove_prefix(colon == fmt.npos ? fmt.size() : colon + 1);
+  // if it's parsable as a number, treat it as an index.
+  std::string_view num = spec._name;
+  if (unsigned n = 0; parse_number(num, n) && num.empty()) {
+    spec._idx = int(n);
+  }
+  if (fmt.empty()) {
+    return;
+  }
+
+  colon               = fmt.find(':');
+  std::string_view sz = fmt.substr(0, colon);
+  spec._ext           = colon == fmt.npos ? std::string_view{} : fmt.substr(colon + 1);
+  if (sz.empty()) {
+    return;
+  }
+  if ('%' == sz[0]) {
+    if (sz.size() < 4) {
+      throw std::invalid_argument("Fill URI encoding without 2 hex characters and align mark");
+    }
+    if (Spec::Align::NONE == (spec._align = align_of(sz[3]))) {
+      throw std::invalid_argument("Fill URI without alignment mark");
+    }
+    if (hex_value(sz[1]) < 0 || hex_value(sz[2]) < 0) {
+      throw std::invalid_argument("URI encoding with non-hex characters");
+    }
+    spec._fill = char((hex_value(sz[1]) << 4) + hex_value(sz[2]));
+    sz.remove_prefix(4);
+  } else if (sz.size() > 1 && Spec::Align::NONE != (spec._align = align_of(sz[1]))) {
+    spec._fill = sz[0];
+    sz.remove_prefix(2);
+  } else if (Spec::Align::NONE != (spec._align = align_of(sz[0]))) {
+    sz.remove_prefix(1);
+  }
+  if (sz.empty()) {
+    return;
+  }
+  if (sz[0] == Spec::SIGN_ALWAYS || sz[0] == Spec::SIGN_NEVER || sz[0] == Spec::SIGN_NEG) {
+    spec._sign = sz[0];
+    sz.remove_prefix(1);
+  }
+  if (!sz.empty() && '#' == sz[0]) {
+    spec._radix_lead_p = true;
+    sz.remove_prefix(1);
+  }
+  if (!sz.empty() && '0' == sz[0]) {
+    if (Spec::Align::NONE == spec._align) {
+      spec._align = Spec::Align::SIGN;
+    }
+    spec._fill = '0';
+    sz.remove_prefix(1);
+  }
+  if (unsigned n = 0; parse_number(sz, n)) {
+    spec._min = n;
+  }
+  if (!sz.empty() && '.' == sz[0]) {
+    sz.remove_prefix(1);
+    if (unsigned n = 0; parse_number(sz, n)) {
+      spec._prec = int(n);
+    } else {
+      throw std::invalid_argument("Precision mark without precision");
+    }
+  }
+  if (!sz.empty() && is_type(sz[0])) {
+    spec._type = sz[0];
+    sz.remove_prefix(1);
+  }
+  if (!sz.empty() && ',' == sz[0]) {
+    sz.remove_prefix(1);
+    if (unsigned n = 0; parse_number(sz, n)) {
+      spec._max = n;
+    } else {
+      throw std::invalid_argument("Maximum width mark without width");
+    }
+    if (!sz.empty() && is_type(sz[0])) {
+      spec._type = sz[0];
+    }
+  }
+}
+
+/** Parse the next literal and specifier from @a fmt, which is updated.
+ *
+ * @return @c true if a specifier was found, @c false if not.
+ */
+constexpr bool
+parse_next(std::string_view& fmt, std::string_view& literal, std::string_view& specifier) {
+  auto off = fmt.find_first_of("{}");
+  if (off == fmt.npos) {
+    literal = fmt;
+    fmt     = {};
+    return false;
+  }
+  if (fmt.size() <= off + 1) {
+    throw std::invalid_argument("Invalid trailing character in format string.");
+  }
+  if (fmt[off] == fmt[off + 1]) { // double braces are a literal brace.
+    literal = fmt.substr(0, off + 1);
+    fmt.remove_prefix(off + 2);
+    return false;
+  }
+  if ('}' == fmt[off]) {
+    throw std::invalid_argument("Unopened } in format string.");
+  }
+  literal = fmt.substr(0, off);
+  fmt.remove_prefix(off + 1);
+  off = fmt.find('}');
+  if (off == fmt.npos) {
+    throw std::invalid_argument("BWFormat: Unclosed { in format string");
+  }
+  specifier = fmt.substr(0, off);
+  fmt.remove_prefix(off + 1);
+  return true;
+}
+
+/** Parse @a fmt in to @a items.
+ *
+ * @return The number of items.
+ *
+ * If @a items is @c nullptr the items are only counted. Arguments are assigned to specifiers
+ * without a name, as is done when printing with a run time format.
+ */
+constexpr size_t
+parse_format(std::string_view fmt, Spec *items) {
+  size_t n    = 0;
+  int arg_idx = 0;
+  while (!fmt.empty()) {
+    std::string_view literal, specifier;
+    bool spec_p = parse_next(fmt, literal, specifier);
+    if (!literal.empty()) {
+      if (items) {
+        items[n]._type = Spec::LITERAL_TYPE;
+        items[n]._ext  = literal;
+      }
+      ++n;
+    }
+    if (spec_p) {
+      if (items) {
+        parse_spec(specifier, items[n]);
+        if (items[n]._name.empty()) {
+          items[n]._idx = arg_idx++;
+        }
+      }
+      ++n;
+    }
+  }
+  return n;
+}
+
+} // namespace detail
+/// @endcond
+
+/** A format string parsed at compile time.
+ *
+ * @tparam F The format string.
+ *
+ * This is used by @c BufferWriter::print when the format string is a template argument. The
+ * format string is parsed at compile time and errors in it are compile errors. Because the
+ * specifiers are constant, the argument for each specifier is known at compile time and is
+ * formatted directly, without the type erasure and run time lookup of @c ArgPack. This is
+ * for format strings which are fixed, which is the common case.
+ *
+ * @a F must be a character array with static storage duration, e.g.
+ * @code
+ *   static constexpr char FMT[] = "Value {} in {:x}";
+ *   w.print<FMT>(v, addr);
+ * @endcode
+ */
+template <char const *F> struct StaticFormat {
+  /// The format string.
+  static constexpr std::string_view text{F};
+  /// The parsed format string, literals and specifiers in order.
+  static constexpr auto items = [] {
+    std::array<Spec, detail::parse_format(text, nullptr)> zret{};
+    detail::parse_format(text, zret.data());
+    return zret;
+  }();
+};
+
 // Name binding - support for having format specifier names.
 
 /** Signature for a functor bound to a name.
@@ -609,6 +840,36 @@ Get_Arg_Formatter_Array(std::index_sequence<N...>) {
 /// as needed without moving data in the output buffer.
 void Adjust_Alignment(BufferWriter& aux, Spec const& spec);
 
+/** Write output for @a spec to @a w.
+ *
+ * @param w Output.
+ * @param spec Format specifier.
+ * @param f Functor to generate the output.
+ *
+ * @a f is invoked with a @c BufferWriter for the auxiliary buffer of @a w. The output is aligned
+ * and limited as required by @a spec and then committed to @a w. If @a w can't commit the output
+ * it is presumed @a w has made more space available and @a f is invoked again.
+ */
+template <typename F>
+void
+Write_Aligned(BufferWriter& w, Spec const& spec, F&& f) {
+  while (true) {
+    size_t width = w.remaining();
+    if (spec._max < width) {
+      width = spec._max;
+    }
+    FixedBufferWriter lw{w.aux_data(), width};
+    f(lw);
+    if (lw.extent()) {
+      Adjust_Alignment(lw, spec);
+      if (!w.commit(lw.extent())) {
+        continue;
+      }
+    }
+    break;
+  }
+}
+
 /** Format @a n as an integral value.
  *
  * @param w Output buffer.
@@ -633,6 +894,20 @@ BufferWriter& Format_Integer(BufferWriter& w, Spec const& spec, uintmax_t n, boo
  */
 BufferWriter& Format_Float(BufferWriter& w, Spec const& spec, double f, bool negative_p);
 
+/** Format @a f in fixed or scientific notation.
+ *
+ * @param w Output buffer.
+ * @param spec Format specifier.
+ * @param f Input value to format.
+ * @param negative_p Input value should be treated as a negative value.
+ * @return @a w
+ *
+ * This is used by @c Format_Float for the types 'f', 'F', 'e', and 'E'. Without a precision the
+ * output is the shortest that converts back to @a f. With a precision the output is rounded from
+ * the exact value of @a f, which is the same as @c printf.
+ */
+BufferWriter& Format_Float_Decimal(BufferWriter& w, Spec const& spec, double f, bool negative_p);
+
 /** Format output as a hexadecimal dump.
  *
  * @param w Output buffer.
@@ -829,14 +1104,7 @@ BufferWriter::print_nfv(Binding&& names, Extractor&& ex, bwf::ArgPack const& arg
         spec._idx = arg_idx++;
       }
 
-      while (true) {
-        size_t width = this->remaining();
-        if (spec._max < width) {
-          width = spec._max;
-        }
-
-        FixedBufferWriter lw{this->aux_data(), width};
-
+      bwf::Write_Aligned(*this, spec, [&](BufferWriter& lw) {
         if (0 <= spec._idx) {
           if (spec._idx < N) {
             if (spec._type == bwf::Spec::CAPTURE_TYPE) {
@@ -850,14 +1118,7 @@ BufferWriter::print_nfv(Binding&& names, Extractor&& ex, bwf::ArgPack const& arg
         } else if (spec._name.size()) {
           names(lw, spec);
         }
-        if (lw.extent()) {
-          bwf::Adjust_Alignment(lw, spec);
-          if (!this->commit(lw.extent())) {
-            continue;
-          }
-        }
-        break;
-      }
+      });
     }
   }
   return *this;
@@ -889,6 +1150,46 @@ BufferWriter::print_v(const bwf::Format& fmt, const std::tuple<Args...>& args) {
   return this->print_nfv(bwf::Global_Names.bind(), fmt.bind(), bwf::ArgTuple{args});
 }
 
+/// @cond INTERNAL_DETAIL
+namespace bwf { namespace detail {
+/// Output item @a I of the static format @a F with the arguments @a args.
+template <char const *F, size_t I, typename TUPLE>
+void
+print_item(BufferWriter& w, TUPLE const& args) {
+  static constexpr Spec const& spec = StaticFormat<F>::items[I];
+  if constexpr (spec._type == Spec::LITERAL_TYPE) {
+    w.write(spec._ext);
+  } else if constexpr (spec._idx >= 0) {
+    static_assert(spec._idx < int(std::tuple_size<TUPLE>::value), "Format argument index out of range");
+    if constexpr (spec._idx < int(std::tuple_size<TUPLE>::value)) { // avoid cascading errors.
+      Write_Aligned(w, spec, [&](BufferWriter& lw) { bwformat(lw, spec, std::get<spec._idx>(args)); });
+    }
+  } else {
+    Write_Aligned(w, spec, [](BufferWriter& lw) { Global_Names.bind()(lw, spec); });
+  }
+}
+
+template <char const *F, typename TUPLE, size_t... I>
+void
+print_items(BufferWriter& w, TUPLE const& args, std::index_sequence<I...>) {
+  (print_item<F, I>(w, args), ...);
+}
+}} // namespace bwf::detail
+/// @endcond
+
+template <char const *F, typename... Args>
+BufferWriter&
+BufferWriter::print(Args&&... args) {
+  return this->print_v<F>(std::forward_as_tuple(args...));
+}
+
+template <char const *F, typename... Args>
+BufferWriter&
+BufferWriter::print_v(std::tuple<Args...> const& args) {
+  bwf::detail::print_items<F>(*this, args, std::make_index_sequence<bwf::StaticFormat<F>::items.size()>());
+  return *this;
+}
+
 template<typename Binding, typename Extractor>
 BufferWriter&
 BufferWriter::print_nfv(Binding const& names, Extractor&& f) {
@@ -996,7 +1297,8 @@ template<typename F>
 auto
 bwformat(BufferWriter& w, bwf::Spec const& spec, F&& f) ->
 typename std::enable_if<std::is_floating_point<typename std::remove_reference<F>::type>::value, BufferWriter&>::type {
-  return f < 0 ? bwf::Format_Float(w, spec, -f, true) : bwf::Format_Float(w, spec, f, false);
+  // Use the sign bit so that -0.0 keeps its sign.
+  return std::signbit(f) ? bwf::Format_Float(w, spec, -f, true) : bwf::Format_Float(w, spec, f, false);
 }
 
 /* Integer types.
@@ -1027,7 +1329,7 @@ typename std::enable_if<std::is_signed<typename std::remove_reference<I>::type>:
   bool neg_p = false;
   uintmax_t n = static_cast<uintmax_t>(i);
   if (i < 0) {
-    n = static_cast<uintmax_t>(-i);
+    n = -n; // unsigned, so this is correct for the minimum value.
     neg_p = true;
   }
   return bwf::Format_Integer(w, spec, n, neg_p);
@@ -1126,6 +1428,18 @@ FixedBufferWriter::print_v(bwf::Format const& fmt, std::tuple<Args...> const& ar
   return static_cast<self_type&>(this->super_type::print_v(fmt, args));
 }
 
+template <char const *F, typename... Args>
+auto
+FixedBufferWriter::print(Args&&... args) -> self_type& {
+  return static_cast<self_type&>(this->super_type::print_v<F>(std::forward_as_tuple(args...)));
+}
+
+template <char const *F, typename... Args>
+auto
+FixedBufferWriter::print_v(std::tuple<Args...> const& args) -> self_type& {
+  return static_cast<self_type&>(this->super_type::print_v<F>(args));
+}
+
 /// @endcond
 
 // Special case support for @c Scalar, because @c Scalar is a base utility for some other utilities
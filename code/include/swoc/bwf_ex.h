@@ -8,6 +8,8 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <ctime>
 #include <string_view>
 
 #include "swoc/swoc_version.h"
@@ -51,6 +53,36 @@ struct Date {
   Date(std::string_view fmt = DEFAULT_FORMAT);
 };
 
+/** Format wrapper for time stamps in a fixed style, for high rate output such as logging.
+ * If the time isn't provided, the current time is used. The output for each second is cached per
+ * thread so that only the sub-second digits are generated for each time stamp in the same second.
+ *
+ * The precision of the format specifier is the number of sub-second digits, up to 9. The
+ * extension "local" formats in the local time zone, otherwise it is GMT. The time zone is checked
+ * only when the second changes.
+ */
+struct Timestamp {
+  /// Output style.
+  enum Style : uint8_t {
+    ISO8601, ///< "2018-06-08T18:55:37Z", or "2018-06-08T12:55:37-06:00" for local time.
+    HTTP,    ///< RFC 1123 HTTP-date, "Fri, 08 Jun 2018 18:55:37 GMT". Always GMT.
+    CLF      ///< Common log format, "08/Jun/2018:18:55:37 +0000".
+  };
+
+  time_t _epoch;       ///< Seconds since the epoch.
+  uint32_t _nsec = 0;  ///< Nanoseconds in the second.
+  Style _style;        ///< Output style.
+
+  /// Use the time @a t in style @a style.
+  Timestamp(time_t t, Style style = ISO8601) : _epoch(t), _style(style) {}
+
+  /// Use the time @a t in style @a style.
+  Timestamp(std::chrono::system_clock::time_point t, Style style = ISO8601);
+
+  /// Use the current time in style @a style.
+  Timestamp(Style style = ISO8601);
+};
+
 namespace detail {
 // Special case conversions - these handle nullptr because the @c std::string_view spec is stupid.
 inline std::string_view
@@ -201,6 +233,8 @@ BufferWriter& bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Errno const&
 
 BufferWriter& bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Date const& date);
 
+BufferWriter& bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Timestamp const& ts);
+
 template<typename... Args>
 BufferWriter&
 bwformat(BufferWriter& w, bwf::Spec const&, bwf::SubText<Args...> const& subtext) {
@@ -536,6 +536,8 @@ protected:
   friend IP6Addr operator&(IP6Addr const& addr, IPMask const& mask);
 
   friend IP6Addr operator|(IP6Addr const& addr, IPMask const& mask);
+
+  template <typename N, typename P> friend class IPStrideTrie;
 };
 
 /** Storage for an IP address.
@@ -1503,6 +1505,60 @@ public:
     return *this;
   }
 
+  /** Load ranges in bulk.
+   *
+   * @tparam I Forward iterator type.
+   * @param first Iterator for the first element.
+   * @param last Iterator past the last element.
+   * @return @a this
+   *
+   * Each element must be a pair (or tuple) of an @c IPRange and a @c PAYLOAD. The result is the
+   * same as calling @c mark for each element in order but if the ranges for each family are sorted
+   * and do not overlap the space is built in linear time. See @c DiscreteSpace::load. Elements
+   * should be grouped by family as each group is loaded separately.
+   */
+  template <typename I> self_type& load(I first, I last);
+
+  /** Set @a this to the union of two spaces.
+   *
+   * @tparam U Payload type of @a rhs.
+   * @tparam F Blending functor type.
+   * @param lhs Left space.
+   * @param rhs Right space.
+   * @param blender Blending functor.
+   * @return @a this
+   *
+   * The result is the same as copying @a lhs and blending each range of @a rhs with its payload
+   * as the color, but is computed in linear time. See @c DiscreteSpace::unite. @a this must not be
+   * @a lhs or @a rhs.
+   */
+  template <typename U, typename F> self_type& unite(self_type const& lhs, IPSpace<U> const& rhs, F&& blender);
+
+  /** Set @a this to the intersection of two spaces.
+   *
+   * @tparam U Payload type of @a rhs.
+   * @tparam F Blending functor type.
+   * @param lhs Left space.
+   * @param rhs Right space.
+   * @param blender Blending functor.
+   * @return @a this
+   *
+   * Addresses in both spaces have the @a lhs payload blended with the @a rhs payload. See
+   * @c DiscreteSpace::intersect.
+   */
+  template <typename U, typename F> self_type& intersect(self_type const& lhs, IPSpace<U> const& rhs, F&& blender);
+
+  /** Set @a this to the difference of two spaces.
+   *
+   * @tparam U Payload type of @a rhs.
+   * @param lhs Left space.
+   * @param rhs Right space.
+   * @return @a this
+   *
+   * Addresses in @a lhs that are not in @a rhs, with the @a lhs payload.
+   */
+  template <typename U> self_type& difference(self_type const& lhs, IPSpace<U> const& rhs);
+
   /// @return The number of distinct ranges.
   size_t count() const { return _ip4.count() + _ip6.count(); }
 
@@ -1576,13 +1632,13 @@ public:
     bool operator!=(self_type const& that) const;
 
   protected:
-    // These are stored non-const to make implementing @c iterator easier. This class provides the
-    // required @c const protection. This is basic a tuple of iterators - for forward iteration if
-    // the primary (ipv4) iterator is at the end, then use the secondary (ipv6) iterator. The reverse
-    // is done for reverse iteration. This depends on the extra support @c IntrusiveDList iterators
-    // provide.
-    typename IP4Space::iterator _iter_4; ///< IPv4 sub-space iterator.
-    typename IP6Space::iterator _iter_6; ///< IPv6 sub-space iterator.
+    // This is basic a tuple of iterators - for forward iteration if the primary (ipv4) iterator is
+    // at the end, then use the secondary (ipv6) iterator. The reverse is done for reverse
+    // iteration. This depends on the extra support @c IntrusiveDList iterators provide. The
+    // sub-space iterators are constant so that a constant space can create them, @c iterator gets
+    // mutable access to the payload through @a _value.
+    typename IP4Space::const_iterator _iter_4; ///< IPv4 sub-space iterator.
+    typename IP6Space::const_iterator _iter_6; ///< IPv6 sub-space iterator.
     /// Current value.
     value_type _value{IPRange{}, *static_cast<PAYLOAD*>(pseudo_nullptr)};
 
@@ -1597,8 +1653,8 @@ public:
      *
      * In practice, both iterators should be either the beginning or ending iterator for the subspace.
      */
-    const_iterator(typename IP4Space::iterator const& iter4
-                   , typename IP6Space::iterator const& iter6);
+    const_iterator(typename IP4Space::const_iterator const& iter4
+                   , typename IP6Space::const_iterator const& iter6);
   };
 
   /** Iterator.
@@ -1690,7 +1746,7 @@ public:
    */
   iterator find(IP4Addr const& addr) {
     auto spot = _ip4.find(addr);
-    return spot == _ip4.end() ? this->end() : iterator{_ip4.find(addr), _ip6.begin()};
+    return spot == _ip4.end() ? this->end() : iterator{spot, _ip6.begin()};
   }
 
   /** Find the payload for an @a addr.
@@ -1702,6 +1758,60 @@ public:
     return {_ip4.end(), _ip6.find(addr)};
   }
 
+  /// @return A constant iterator for the range containing @a addr.
+  const_iterator find(IPAddr const& addr) const {
+    if (addr.is_ip4()) {
+      return this->find(addr.ip4());
+    } else if (addr.is_ip6()) {
+      return this->find(addr.ip6());
+    }
+    return this->end();
+  }
+
+  /// @return A constant iterator for the range containing @a addr.
+  const_iterator find(IP4Addr const& addr) const {
+    auto spot = _ip4.find(addr);
+    return spot == _ip4.end() ? this->end() : const_iterator{spot, _ip6.begin()};
+  }
+
+  /// @return A constant iterator for the range containing @a addr.
+  const_iterator find(IP6Addr const& addr) const { return {_ip4.end(), _ip6.find(addr)}; }
+
+  /** Find the payloads for a batch of addresses.
+   *
+   * @param addrs Addresses to find.
+   * @param results Iterators for the results.
+   * @return The number of addresses found.
+   *
+   * Each element of @a results is set to the iterator for the range containing the corresponding
+   * address in @a addrs, or @c end() if that address is not in the space. Only the first
+   * @c min(addrs.count(), results.count()) addresses are searched.
+   *
+   * This is equivalent to calling @c find for each address but is considerably faster for large
+   * batches because the searches are interleaved and prefetched.
+   */
+  size_t find(MemSpan<IPAddr const> addrs, MemSpan<iterator> results);
+
+  /** Find the payloads for a batch of IPv4 addresses.
+   *
+   * @param addrs Addresses to find.
+   * @param results Iterators for the results.
+   * @return The number of addresses found.
+   *
+   * @see find(MemSpan<IPAddr const>, MemSpan<iterator>)
+   */
+  size_t find(MemSpan<IP4Addr const> addrs, MemSpan<iterator> results);
+
+  /** Find the payloads for a batch of IPv6 addresses.
+   *
+   * @param addrs Addresses to find.
+   * @param results Iterators for the results.
+   * @return The number of addresses found.
+   *
+   * @see find(MemSpan<IPAddr const>, MemSpan<iterator>)
+   */
+  size_t find(MemSpan<IP6Addr const> addrs, MemSpan<iterator> results);
+
   /// @return A constant iterator to the first element.
   const_iterator begin() const;
 
@@ -1741,11 +1851,15 @@ public:
 protected:
   IP4Space _ip4; ///< Sub-space containing IPv4 ranges.
   IP6Space _ip6; ///< sub-space containing IPv6 ranges.
+
+  template<typename P> friend class IPFlatSpace;
+  template<typename P, typename C> friend class IPSpaceBuilder;
+  template<typename P> friend class IPSpace;
 };
 
 template<typename PAYLOAD>
-IPSpace<PAYLOAD>::const_iterator::const_iterator(typename IP4Space::iterator const& iter4
-                                                 , typename IP6Space::iterator const& iter6)
+IPSpace<PAYLOAD>::const_iterator::const_iterator(typename IP4Space::const_iterator const& iter4
+                                                 , typename IP6Space::const_iterator const& iter6)
     : _iter_4(iter4), _iter_6(iter6) {
   if (_iter_4.has_next()) {
     new(&_value) value_type{_iter_4->range(), _iter_4->payload()};
@@ -1846,9 +1960,7 @@ IPSpace<PAYLOAD>::const_iterator::operator!=(self_type const& that) const {
 }
 
 template<typename PAYLOAD>
-IPSpace<PAYLOAD>::iterator::iterator(self_type const& that) {
-  *this = that;
-}
+IPSpace<PAYLOAD>::iterator::iterator(self_type const& that) : super_type(that) {}
 
 template<typename PAYLOAD>
 auto IPSpace<PAYLOAD>::iterator::operator=(self_type const& that) -> self_type& {
@@ -1878,6 +1990,203 @@ auto IPSpace<PAYLOAD>::iterator::operator--() -> self_type& {
   return *this;
 }
 
+/** A read only, compact copy of an @c IPSpace optimized for lookup.
+ *
+ * @tparam PAYLOAD The color class.
+ *
+ * This is constructed from a populated @c IPSpace and is immutable afterwards. Lookup semantics
+ * are identical to @c IPSpace but searching is done on contiguous arrays rather than a tree and is
+ * therefore much more cache friendly. This is intended for the common case where an @c IPSpace
+ * is loaded and then used only for lookup.
+ *
+ * @see DiscreteFlatSpace
+ */
+template<typename PAYLOAD> class IPFlatSpace {
+  using self_type = IPFlatSpace;
+
+public:
+  using payload_t = PAYLOAD; ///< Export payload type.
+  using IP4Space  = DiscreteFlatSpace<IP4Addr, PAYLOAD>;
+  using IP6Space  = DiscreteFlatSpace<IP6Addr, PAYLOAD>;
+
+  /// Construct an empty space.
+  IPFlatSpace() = default;
+
+  /** Construct from an @a space.
+   *
+   * @param space Source space.
+   *
+   * The ranges and payloads are copied, @a space is not referenced after construction.
+   */
+  explicit IPFlatSpace(IPSpace<PAYLOAD> const& space) : _ip4(space._ip4), _ip6(space._ip6) {}
+
+  /** Construct from subspaces.
+   *
+   * @param ip4 IPv4 subspace.
+   * @param ip6 IPv6 subspace.
+   */
+  IPFlatSpace(IP4Space&& ip4, IP6Space&& ip6) : _ip4(std::move(ip4)), _ip6(std::move(ip6)) {}
+
+  /// @return The number of distinct ranges.
+  size_t count() const { return _ip4.count() + _ip6.count(); }
+
+  size_t count_ip4() const { return _ip4.count(); }
+  size_t count_ip6() const { return _ip6.count(); }
+
+  /** Constant iterator.
+   * The value type is a tuple of the IP address range and the @a PAYLOAD. Both are constant.
+   */
+  class const_iterator {
+    using self_type = const_iterator; ///< Self reference type.
+    friend class IPFlatSpace;
+
+  public:
+    using value_type = std::tuple<IPRange const, PAYLOAD const&>; /// Import for API compliance.
+    // STL algorithm compliance.
+    using iterator_category = std::bidirectional_iterator_tag;
+    using pointer           = value_type *;
+    using reference         = value_type;
+    using difference_type   = int;
+
+    /// Default constructor.
+    const_iterator() = default;
+
+    /// Pre-increment.
+    /// Move to the next element in the list.
+    /// @return The iterator.
+    self_type& operator++();
+
+    /// Pre-decrement.
+    /// Move to the previous element in the list.
+    /// @return The iterator.
+    self_type& operator--();
+
+    /// Post-increment.
+    /// Move to the next element in the list.
+    /// @return The iterator value before the increment.
+    self_type
+    operator++(int) {
+      self_type zret{*this};
+      ++*this;
+      return zret;
+    }
+
+    /// Post-decrement.
+    /// Move to the previous element in the list.
+    /// @return The iterator value before the decrement.
+    self_type
+    operator--(int) {
+      self_type zret{*this};
+      --*this;
+      return zret;
+    }
+
+    /// Dereference.
+    /// @return The range and payload of the referent.
+    value_type operator*() const;
+
+    /// Equality
+    bool operator==(self_type const& that) const {
+      return _iter_4 == that._iter_4 && _iter_6 == that._iter_6;
+    }
+
+    /// Inequality
+    bool operator!=(self_type const& that) const {
+      return _iter_4 != that._iter_4 || _iter_6 != that._iter_6;
+    }
+
+  protected:
+    typename IP4Space::const_iterator _iter_4; ///< IPv4 sub-space iterator.
+    typename IP6Space::const_iterator _iter_6; ///< IPv6 sub-space iterator.
+
+    /// Internal constructor.
+    const_iterator(typename IP4Space::const_iterator const& iter4, typename IP6Space::const_iterator const& iter6)
+        : _iter_4(iter4), _iter_6(iter6) {}
+  };
+
+  using iterator = const_iterator;
+
+  /** Find the payload for an @a addr.
+   *
+   * @param addr Address to find.
+   * @return Iterator for the range containing @a addr.
+   */
+  const_iterator find(IPAddr const& addr) const {
+    if (addr.is_ip4()) {
+      return this->find(addr.ip4());
+    } else if (addr.is_ip6()) {
+      return this->find(addr.ip6());
+    }
+    return this->end();
+  }
+
+  /** Find the payload for an @a addr.
+   *
+   * @param addr Address to find.
+   * @return Iterator for the range containing @a addr.
+   */
+  const_iterator find(IP4Addr const& addr) const {
+    auto spot = _ip4.find(addr);
+    return spot == _ip4.end() ? this->end() : const_iterator{spot, _ip6.begin()};
+  }
+
+  /** Find the payload for an @a addr.
+   *
+   * @param addr Address to find.
+   * @return Iterator for the range containing @a addr.
+   */
+  const_iterator find(IP6Addr const& addr) const { return {_ip4.end(), _ip6.find(addr)}; }
+
+  /// @return An iterator to the first element.
+  const_iterator begin() const { return {_ip4.begin(), _ip6.begin()}; }
+
+  /// @return An iterator past the last element.
+  const_iterator end() const { return {_ip4.end(), _ip6.end()}; }
+
+  /// @return The IPv4 subspace.
+  IP4Space const& ip4() const { return _ip4; }
+
+  /// @return The IPv6 subspace.
+  IP6Space const& ip6() const { return _ip6; }
+
+protected:
+  IP4Space _ip4; ///< Sub-space containing IPv4 ranges.
+  IP6Space _ip6; ///< Sub-space containing IPv6 ranges.
+};
+
+template<typename PAYLOAD>
+auto
+IPFlatSpace<PAYLOAD>::const_iterator::operator++() -> self_type& {
+  if (_iter_4.has_next()) {
+    ++_iter_4; // if this hits the end, @a _iter_6 is at its beginning which is correct.
+  } else if (_iter_6.has_next()) {
+    ++_iter_6;
+  }
+  return *this;
+}
+
+template<typename PAYLOAD>
+auto
+IPFlatSpace<PAYLOAD>::const_iterator::operator--() -> self_type& {
+  if (_iter_6.has_prev()) {
+    --_iter_6;
+  } else if (_iter_4.has_prev()) {
+    --_iter_4;
+  }
+  return *this;
+}
+
+template<typename PAYLOAD>
+auto
+IPFlatSpace<PAYLOAD>::const_iterator::operator*() const -> value_type {
+  if (_iter_4.has_next()) {
+    return value_type{IP4Range{_iter_4.range()}, _iter_4.payload()};
+  } else if (_iter_6.has_next()) {
+    return value_type{IP6Range{_iter_6.range()}, _iter_6.payload()};
+  }
+  return value_type{IPRange{}, *static_cast<PAYLOAD const *>(pseudo_nullptr)};
+}
+
 // --------------------------------------------------------------------------
 // -- IP4Addr --
 inline constexpr sa_family_t IP4Addr::family() { return AF_value; }
@@ -2332,8 +2641,9 @@ inline bool operator>=(IP6Addr const& lhs, IP6Addr const& rhs) {
 }
 
 inline IP6Addr& IP6Addr::operator&=(IPMask const& mask) {
-  if (mask._cidr < WORD_WIDTH) {
-    _addr._store[MSW] &= (~word_type{0} << (WORD_WIDTH - mask._cidr));
+  if (mask._cidr <= WORD_WIDTH) {
+    // Shifting by the full word width is undefined, handle the empty mask explicitly.
+    _addr._store[MSW] &= mask._cidr == 0 ? word_type{0} : (~word_type{0} << (WORD_WIDTH - mask._cidr));
     _addr._store[LSW] = 0;
   } else if (mask._cidr < WIDTH) {
     _addr._store[LSW] &= (~word_type{0} << (2 * WORD_WIDTH - mask._cidr));
@@ -2784,6 +3094,128 @@ auto IPSpace<PAYLOAD>::blend(IPRange const& range, U const& color, F&& blender)
   return *this;
 }
 
+template<typename PAYLOAD>
+template<typename U, typename F>
+auto IPSpace<PAYLOAD>::unite(self_type const& lhs, IPSpace<U> const& rhs, F&& blender) -> self_type& {
+  _ip4.unite(lhs._ip4, rhs._ip4, blender);
+  _ip6.unite(lhs._ip6, rhs._ip6, blender);
+  return *this;
+}
+
+template<typename PAYLOAD>
+template<typename U, typename F>
+auto IPSpace<PAYLOAD>::intersect(self_type const& lhs, IPSpace<U> const& rhs, F&& blender) -> self_type& {
+  _ip4.intersect(lhs._ip4, rhs._ip4, blender);
+  _ip6.intersect(lhs._ip6, rhs._ip6, blender);
+  return *this;
+}
+
+template<typename PAYLOAD>
+template<typename U>
+auto IPSpace<PAYLOAD>::difference(self_type const& lhs, IPSpace<U> const& rhs) -> self_type& {
+  _ip4.difference(lhs._ip4, rhs._ip4);
+  _ip6.difference(lhs._ip6, rhs._ip6);
+  return *this;
+}
+
+template<typename PAYLOAD>
+template<typename I>
+auto IPSpace<PAYLOAD>::load(I first, I last) -> self_type& {
+  // Payloads are copied because the element may be a temporary.
+  auto ip4    = [](auto&& elt) { return std::pair<IP4Range, PAYLOAD>{std::get<0>(elt).ip4(), std::get<1>(elt)}; };
+  auto ip6    = [](auto&& elt) { return std::pair<IP6Range, PAYLOAD>{std::get<0>(elt).ip6(), std::get<1>(elt)}; };
+  auto family = [](auto&& elt) -> sa_family_t {
+    auto const& r = std::get<0>(elt);
+    return r.is_ip4() ? AF_INET : r.is_ip6() ? AF_INET6 : AF_UNSPEC;
+  };
+  while (first != last) {
+    auto f    = family(*first);
+    auto spot = first;
+    while (++spot != last && family(*spot) == f) {
+    }
+    if (AF_INET == f) {
+      _ip4.load(first, spot, ip4);
+    } else if (AF_INET6 == f) {
+      _ip6.load(first, spot, ip6);
+    }
+    first = spot;
+  }
+  return *this;
+}
+
+template<typename PAYLOAD>
+size_t IPSpace<PAYLOAD>::find(MemSpan<IP4Addr const> addrs, MemSpan<iterator> results) {
+  static constexpr size_t N = 64; // Local batch size.
+  typename IP4Space::iterator spots[N];
+  size_t zret = 0;
+  size_t n    = std::min(addrs.count(), results.count());
+  for (size_t base = 0; base < n; base += N) {
+    auto k = std::min(N, n - base);
+    zret += _ip4.find(addrs.subspan(base, k), MemSpan<typename IP4Space::iterator>{spots, k});
+    for (size_t idx = 0; idx < k; ++idx) {
+      results[base + idx] = spots[idx] == _ip4.end() ? this->end() : iterator{spots[idx], _ip6.begin()};
+    }
+  }
+  return zret;
+}
+
+template<typename PAYLOAD>
+size_t IPSpace<PAYLOAD>::find(MemSpan<IP6Addr const> addrs, MemSpan<iterator> results) {
+  static constexpr size_t N = 64; // Local batch size.
+  typename IP6Space::iterator spots[N];
+  size_t zret = 0;
+  size_t n    = std::min(addrs.count(), results.count());
+  for (size_t base = 0; base < n; base += N) {
+    auto k = std::min(N, n - base);
+    zret += _ip6.find(addrs.subspan(base, k), MemSpan<typename IP6Space::iterator>{spots, k});
+    for (size_t idx = 0; idx < k; ++idx) {
+      results[base + idx] = iterator{_ip4.end(), spots[idx]};
+    }
+  }
+  return zret;
+}
+
+template<typename PAYLOAD>
+size_t IPSpace<PAYLOAD>::find(MemSpan<IPAddr const> addrs, MemSpan<iterator> results) {
+  static constexpr size_t N = 64; // Local batch size.
+  // Addresses are split by family in to local batches, along with their original index.
+  IP4Addr keys4[N];
+  IP6Addr keys6[N];
+  uint8_t idx4[N];
+  uint8_t idx6[N];
+  typename IP4Space::iterator spots4[N];
+  typename IP6Space::iterator spots6[N];
+  size_t zret = 0;
+  size_t n    = std::min(addrs.count(), results.count());
+
+  for (size_t base = 0; base < n; base += N) {
+    auto k    = std::min(N, n - base);
+    size_t n4   = 0;
+    size_t n6   = 0;
+    for (size_t idx = 0; idx < k; ++idx) {
+      auto const& addr = addrs[base + idx];
+      if (addr.is_ip4()) {
+        keys4[n4]  = addr.ip4();
+        idx4[n4++] = idx;
+      } else if (addr.is_ip6()) {
+        keys6[n6]  = addr.ip6();
+        idx6[n6++] = idx;
+      } else {
+        results[base + idx] = this->end();
+      }
+    }
+    zret += _ip4.find(MemSpan<IP4Addr const>{keys4, n4}, MemSpan<typename IP4Space::iterator>{spots4, n4});
+    zret += _ip6.find(MemSpan<IP6Addr const>{keys6, n6}, MemSpan<typename IP6Space::iterator>{spots6, n6});
+    for (size_t idx = 0; idx < n4; ++idx) {
+      results[base + idx4[idx]] = spots4[idx] == _ip4.end() ? this->end() : iterator{spots4[idx], _ip6.begin()};
+    }
+    for (size_t idx = 0; idx < n6; ++idx) {
+      results[base + idx6[idx]] = iterator{_ip4.end(), spots6[idx]};
+    }
+  }
+  return zret;
+}
+
 template<typename PAYLOAD>
 void IPSpace<PAYLOAD>::clear() {
   _ip4.clear();
@@ -9,21 +9,17 @@
 namespace swoc { inline namespace SWOC_VERSION_NS {
 
 ArenaWriter &
-ArenaWriter::write(char c)
+ArenaWriter::overflow(char c)
 {
-  if (_attempted >= _capacity) {
-    this->realloc(_attempted + 1);
-  }
+  this->realloc(this->extent() + 1);
   this->super_type::write(c);
   return *this;
 }
 
 ArenaWriter &
-ArenaWriter::write(void const *data, size_t n)
+ArenaWriter::overflow(void const *data, size_t n)
 {
-  if (n + _attempted > _capacity) {
-    this->realloc(n + _attempted);
-  }
+  this->realloc(this->extent() + n);
   this->super_type::write(data, n);
   return *this;
 }
@@ -31,8 +27,8 @@ ArenaWriter::write(void const *data, size_t n)
 bool
 ArenaWriter::commit(size_t n)
 {
-  if (_attempted + n > _capacity) {
-    this->realloc(_attempted + n);
+  if (this->extent() + n > _capacity) {
+    this->realloc(this->extent() + n);
     return false;
   }
   return this->super_type::commit(n);
@@ -42,10 +38,17 @@ void
 ArenaWriter::realloc(size_t n)
 {
   auto text                    = this->view(); // Current data.
+  auto extent                  = this->extent();
   auto span                    = _arena.require(n).remnant().rebind<char>();
   const_cast<char *&>(_buffer) = span.data();
   _capacity                    = span.size();
-  memcpy(_buffer, text.data(), text.size());
+  if (text.size()) {
+    memcpy(_buffer, text.data(), text.size());
+  }
+  // Output that was discarded is now counted as in the buffer, if it fits.
+  auto used = std::min(extent, _capacity);
+  _excess   = extent - used;
+  this->reset_window(used);
 }
 
 }} // namespace swoc
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+ * @c BufferWriter for a chain of segments in a @c MemArena.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+#include "swoc/ChainWriter.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+ChainWriter::ChainWriter(MemArena &arena, size_t segment_size) : _arena(arena), _segment_size(segment_size)
+{
+  auto span = _arena.remnant().rebind<char>();
+  _base = _cursor = span.data();
+  _end = _limit = span.data() + span.size();
+}
+
+ChainWriter &
+ChainWriter::overflow(char c)
+{
+  this->next_segment(1);
+  *_cursor++ = c;
+  return *this;
+}
+
+ChainWriter &
+ChainWriter::overflow(void const *data, size_t n)
+{
+  auto src = static_cast<char const *>(data);
+  // Fill the current segment so every segment but the last is full.
+  size_t k = _limit - _cursor;
+  if (k) {
+    memcpy(_cursor, src, k);
+    _cursor += k;
+    src += k;
+    n -= k;
+  }
+  this->next_segment(n);
+  memcpy(_cursor, src, n);
+  _cursor += n;
+  return *this;
+}
+
+bool
+ChainWriter::commit(size_t n)
+{
+  if (n > size_t(_limit - _cursor)) {
+    this->next_segment(n);
+    return false;
+  }
+  _cursor += n;
+  return true;
+}
+
+void
+ChainWriter::close_segment()
+{
+  size_t n = _cursor - _base;
+  if (n) {
+    _arena.alloc(n); // This is the output in the remnant, at @a _base.
+    if (!_chain.empty() && static_cast<char *>(_chain.back().iov_base) + _chain.back().iov_len == _base) {
+      _chain.back().iov_len += n; // contiguous with the previous segment.
+    } else {
+      _chain.push_back({_base, n});
+    }
+    _chain_size += n;
+    _base = _cursor;
+  }
+}
+
+void
+ChainWriter::next_segment(size_t n)
+{
+  this->close_segment();
+  // The restriction applies to every segment, so the new one needs room for it as well.
+  n = std::max(n + _restricted, _segment_size);
+  if (_arena.remaining() < n) {
+    _arena.require(n);
+  }
+  auto span = _arena.remnant().rebind<char>();
+  _base = _cursor = span.data();
+  _end = span.data() + span.size();
+  this->apply_restriction();
+}
+
+void
+ChainWriter::apply_restriction()
+{
+  _limit = _end - std::min<size_t>(_restricted, _end - _cursor);
+}
+
+ChainWriter &
+ChainWriter::discard(size_t n)
+{
+  size_t k = std::min<size_t>(n, _cursor - _base);
+  _cursor -= k;
+  n -= k;
+  // Anything more comes off the end of the chain. That memory can't be returned to the arena.
+  while (n && !_chain.empty()) {
+    auto &last = _chain.back();
+    k = std::min(n, last.iov_len);
+    last.iov_len -= k;
+    _chain_size -= k;
+    n -= k;
+    if (last.iov_len == 0) {
+      _chain.pop_back();
+    }
+  }
+  return *this;
+}
+
+ChainWriter &
+ChainWriter::restrict(size_t n)
+{
+  _restricted += n;
+  this->apply_restriction();
+  return *this;
+}
+
+ChainWriter &
+ChainWriter::restore(size_t n)
+{
+  _restricted -= std::min(n, _restricted);
+  this->apply_restriction();
+  return *this;
+}
+
+char &
+ChainWriter::at(size_t idx)
+{
+  for (auto const &seg : _chain) {
+    if (idx < seg.iov_len) {
+      return static_cast<char *>(seg.iov_base)[idx];
+    }
+    idx -= seg.iov_len;
+  }
+  return _base[idx];
+}
+
+ChainWriter &
+ChainWriter::copy(size_t dst, size_t src, size_t n)
+{
+  auto extent = this->extent();
+  if (dst >= extent || src >= extent) {
+    return *this;
+  }
+  n = std::min({n, extent - dst, extent - src});
+  if (dst >= _chain_size && src >= _chain_size) {
+    std::memmove(_base + (dst - _chain_size), _base + (src - _chain_size), n);
+  } else if (dst < src) {
+    for (size_t i = 0; i < n; ++i) {
+      this->at(dst + i) = this->at(src + i);
+    }
+  } else {
+    for (size_t i = n; i > 0; --i) {
+      this->at(dst + i - 1) = this->at(src + i - 1);
+    }
+  }
+  return *this;
+}
+
+MemSpan<iovec const>
+ChainWriter::iovecs()
+{
+  this->close_segment();
+  return {_chain.data(), _chain.size()};
+}
+
+MemSpan<char const>
+ChainWriter::segment(size_t idx) const
+{
+  if (idx < _chain.size()) {
+    return {static_cast<char const *>(_chain[idx].iov_base), _chain[idx].iov_len};
+  }
+  return {_base, size_t(_cursor - _base)};
+}
+
+std::ostream &
+ChainWriter::operator>>(std::ostream &stream) const
+{
+  for (auto const &seg : _chain) {
+    stream.write(static_cast<char const *>(seg.iov_base), seg.iov_len);
+  }
+  return stream.write(_base, _cursor - _base);
+}
+
+}} // namespace swoc
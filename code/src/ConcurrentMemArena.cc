@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Memory arena for allocations from multiple threads.
+ */
+#include <algorithm>
+#include "swoc/ConcurrentMemArena.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+thread_local ConcurrentMemArena::Binding ConcurrentMemArena::_bindings[N_BINDINGS] = {};
+std::atomic<uint64_t> ConcurrentMemArena::_next_serial{1};
+
+namespace {
+/// Round @a block_size up to a pool size class so all of an allocated block is used.
+size_t
+round_block_size(size_t block_size) {
+  for (unsigned c = 0; c < MemArena::BlockPool::N_CLASSES; ++c) {
+    if (MemArena::BlockPool::class_size(c) >= block_size) {
+      return MemArena::BlockPool::class_size(c);
+    }
+  }
+  return block_size;
+}
+} // namespace
+
+ConcurrentMemArena::ConcurrentMemArena(size_t block_size, size_t pool_size)
+    : _own_pool(new BlockPool(pool_size)),
+      _pool(_own_pool.get()),
+      _block_size(round_block_size(block_size)),
+      _serial(_next_serial.fetch_add(1)) {}
+
+ConcurrentMemArena::ConcurrentMemArena(BlockPool& pool, size_t block_size)
+    : _pool(&pool), _block_size(round_block_size(block_size)), _serial(_next_serial.fetch_add(1)) {}
+
+ConcurrentMemArena::~ConcurrentMemArena() {
+  this->clear();
+}
+
+auto
+ConcurrentMemArena::bind() -> Cache * {
+  // Check the other recently used arenas, moving a hit to the front.
+  for (unsigned idx = 1; idx < N_BINDINGS; ++idx) {
+    if (_bindings[idx]._serial == _serial) {
+      auto binding = _bindings[idx];
+      std::copy_backward(_bindings, _bindings + idx, _bindings + idx + 1);
+      _bindings[0] = binding;
+      return binding._cache;
+    }
+  }
+
+  Cache *zret;
+  {
+    std::lock_guard lock(_mutex);
+    auto& cache = _caches[std::this_thread::get_id()];
+    if (!cache) {
+      cache = std::make_unique<Cache>();
+    }
+    zret = cache.get();
+  }
+  // Drop the least recently used binding.
+  std::copy_backward(_bindings, _bindings + N_BINDINGS - 1, _bindings + N_BINDINGS);
+  _bindings[0] = {_serial, zret};
+  return zret;
+}
+
+auto
+ConcurrentMemArena::make_block(size_t n) -> Block * {
+  n = std::max(n, _block_size);
+  if (Block *block = _pool->take(n); block) {
+    return block;
+  }
+  return new (::malloc(sizeof(Block) + n)) Block(n);
+}
+
+MemSpan<void>
+ConcurrentMemArena::alloc_slow(Cache *cache, size_t n) {
+  Block *block = this->make_block(n);
+  auto zret    = block->alloc(n);
+  cache->_reserved += block->size;
+  cache->_allocated += n;
+  // Keep whichever block has more space as the current block.
+  if (cache->_block && cache->_block->remaining() >= block->remaining()) {
+    cache->_full.append(block);
+  } else {
+    if (cache->_block) {
+      cache->_full.append(cache->_block);
+    }
+    cache->_block = block;
+  }
+  return zret;
+}
+
+void
+ConcurrentMemArena::recycle(Block *block) {
+  _pool->give(block);
+}
+
+void
+ConcurrentMemArena::recycle(BlockList& list) {
+  list.apply([this](Block *b) { this->recycle(b); }).clear();
+}
+
+ConcurrentMemArena&
+ConcurrentMemArena::freeze() {
+  this->recycle(_frozen);
+  _frozen_allocated = _frozen_reserved = 0;
+  for (auto& [id, cache] : _caches) {
+    if (cache->_block) {
+      _frozen.append(cache->_block);
+      cache->_block = nullptr;
+    }
+    while (Block *b = cache->_full.take_head()) {
+      _frozen.append(b);
+    }
+    _frozen_allocated += cache->_allocated;
+    _frozen_reserved += cache->_reserved;
+    cache->_allocated = cache->_reserved = 0;
+  }
+  return *this;
+}
+
+ConcurrentMemArena&
+ConcurrentMemArena::thaw() {
+  this->recycle(_frozen);
+  _frozen_allocated = _frozen_reserved = 0;
+  return *this;
+}
+
+ConcurrentMemArena&
+ConcurrentMemArena::discard() {
+  for (auto& [id, cache] : _caches) {
+    this->recycle(cache->_full);
+    cache->_allocated = 0;
+    cache->_reserved  = 0;
+    if (cache->_block) {
+      cache->_block->discard();
+      cache->_reserved = cache->_block->size;
+    }
+  }
+  return *this;
+}
+
+ConcurrentMemArena&
+ConcurrentMemArena::clear() {
+  this->thaw();
+  for (auto& [id, cache] : _caches) {
+    this->recycle(cache->_full);
+    if (cache->_block) {
+      this->recycle(cache->_block);
+      cache->_block = nullptr;
+    }
+    cache->_allocated = cache->_reserved = 0;
+  }
+  return *this;
+}
+
+size_t
+ConcurrentMemArena::size() const {
+  size_t zret = 0;
+  for (auto const& [id, cache] : _caches) {
+    zret += cache->_allocated;
+  }
+  return zret;
+}
+
+size_t
+ConcurrentMemArena::allocated_size() const {
+  return _frozen_allocated + this->size();
+}
+
+size_t
+ConcurrentMemArena::reserved_size() const {
+  size_t zret = _frozen_reserved;
+  for (auto const& [id, cache] : _caches) {
+    zret += cache->_reserved;
+  }
+  return zret;
+}
+
+bool
+ConcurrentMemArena::contains(const void *ptr) const {
+  auto pred = [ptr](const Block& b) -> bool { return b.contains(ptr); };
+  return std::any_of(_frozen.begin(), _frozen.end(), pred) ||
+         std::any_of(_caches.begin(), _caches.end(), [&](auto const& item) {
+           auto const& cache = item.second;
+           return (cache->_block && cache->_block->contains(ptr)) || std::any_of(cache->_full.begin(), cache->_full.end(), pred);
+         });
+}
+
+}} // namespace swoc
@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Persistent, memory mappable snapshots of IP spaces.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "swoc/IPSnapshot.h"
+#include "swoc/bwf_std.h"
+#include "swoc/ext/HashFNV.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+namespace {
+/// Round @a n up to a multiple of the section alignment.
+constexpr uint64_t
+align_up(uint64_t n) {
+  return (n + IPSnapshotFile::ALIGN - 1) & ~(uint64_t(IPSnapshotFile::ALIGN) - 1);
+}
+
+/// Write all of @a data to @a fd.
+bool
+write_all(int fd, void const *data, size_t n) {
+  auto ptr = static_cast<char const *>(data);
+  while (n > 0) {
+    auto k = ::write(fd, ptr, n);
+    if (k < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    ptr += k;
+    n   -= k;
+  }
+  return true;
+}
+
+/// Compute the checksum for @a hdr.
+uint64_t
+header_checksum(IPSnapshotFile::Header const& hdr) {
+  IPSnapshotFile::Header tmp = hdr;
+  tmp._checksum              = 0;
+  return IPSnapshotFile::checksum({reinterpret_cast<char const *>(&tmp), sizeof(tmp)});
+}
+} // namespace
+
+IPBlobRef
+IPBlobTable::add(std::string_view data) {
+  if (auto spot = _map.find(data); spot != _map.end()) {
+    return spot->second;
+  }
+  if (data.size() > std::numeric_limits<uint32_t>::max() - _size) {
+    throw std::length_error("IPBlobTable: table size would exceed the 4GB limit of IPBlobRef.");
+  }
+  auto span = _arena.alloc(data.size()).rebind<char>();
+  memcpy(span, data);
+  std::string_view local{span.data(), span.size()};
+  IPBlobRef zret{uint32_t(_size), uint32_t(data.size())};
+  _items.push_back(local);
+  _map.emplace(local, zret);
+  _size += data.size();
+  return zret;
+}
+
+IPSnapshotFile::IPSnapshotFile(self_type&& that) {
+  *this = std::move(that);
+}
+
+auto
+IPSnapshotFile::operator=(self_type&& that) -> self_type& {
+  if (this != &that) {
+    this->clear();
+    _mapped_p = that._mapped_p;
+    _text     = std::move(that._text);
+    _content  = _mapped_p ? that._content : MemSpan<char const>{_text.data(), _text.size()};
+    that._content.clear();
+    that._mapped_p = false;
+  }
+  return *this;
+}
+
+IPSnapshotFile::~IPSnapshotFile() {
+  this->clear();
+}
+
+auto
+IPSnapshotFile::clear() -> self_type& {
+  if (_mapped_p) {
+    ::munmap(const_cast<char *>(_content.data()), _content.size());
+    _mapped_p = false;
+  }
+  _content.clear();
+  _text.clear();
+  return *this;
+}
+
+uint64_t
+IPSnapshotFile::checksum(std::string_view data) {
+  return Hash64FNV1a().hash_immediate(data);
+}
+
+MemSpan<char const>
+IPSnapshotFile::section(Section idx) const {
+  if (_content.empty() || idx >= N_SECTIONS) {
+    return {};
+  }
+  auto const& info = this->header()._sections[idx];
+  return _content.subspan(info._offset, info._size);
+}
+
+TextView
+IPSnapshotFile::blob(IPBlobRef const& ref) const {
+  auto span = this->section(BLOB);
+  return {span.data() + ref._offset, ref._size};
+}
+
+Errata
+IPSnapshotFile::map(file::path const& path, bool verify_p) {
+  this->clear();
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Errata().error(R"(Failed to open IP snapshot "{}" - {}.)", path, std::error_code(errno, std::system_category()));
+  }
+  struct stat info;
+  if (0 != ::fstat(fd, &info)) {
+    auto zret = Errata().error(R"(Failed to stat IP snapshot "{}" - {}.)", path, std::error_code(errno, std::system_category()));
+    ::close(fd);
+    return zret;
+  }
+  if (size_t(info.st_size) < sizeof(Header)) {
+    ::close(fd);
+    return Errata().error(R"(IP snapshot "{}" is too small ({} bytes) to be valid.)", path, info.st_size);
+  }
+  auto ptr = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping stays valid after the descriptor is closed.
+  if (ptr == MAP_FAILED) {
+    return Errata().error(R"(Failed to map IP snapshot "{}" - {}.)", path, std::error_code(errno, std::system_category()));
+  }
+  _content  = {static_cast<char const *>(ptr), size_t(info.st_size)};
+  _mapped_p = true;
+  return this->validate(path, verify_p);
+}
+
+Errata
+IPSnapshotFile::load(file::path const& path, bool verify_p) {
+  std::error_code ec;
+  this->clear();
+  _text = file::load(path, ec);
+  if (ec) {
+    _text.clear();
+    return Errata().error(R"(Failed to load IP snapshot "{}" - {}.)", path, ec);
+  }
+  _content = {_text.data(), _text.size()};
+  return this->validate(path, verify_p);
+}
+
+Errata
+IPSnapshotFile::validate(file::path const& path, bool verify_p) {
+  Errata zret;
+  if (_content.size() < sizeof(Header)) {
+    zret.error(R"(IP snapshot "{}" is too small ({} bytes) to be valid.)", path, _content.size());
+  } else {
+    auto const& hdr = this->header();
+    if (hdr._magic != MAGIC) {
+      zret.error(R"(IP snapshot "{}" is not a snapshot file.)", path);
+    } else if (hdr._byte_order != BYTE_ORDER_MARK) {
+      zret.error(R"(IP snapshot "{}" was written with a different byte order.)", path);
+    } else if (hdr._version != VERSION || hdr._header_size != sizeof(Header)) {
+      zret.error(R"(IP snapshot "{}" is version {} - version {} is required.)", path, hdr._version, VERSION);
+    } else if (hdr._checksum != header_checksum(hdr)) {
+      zret.error(R"(IP snapshot "{}" header is corrupt.)", path);
+    } else {
+      for (unsigned idx = 0; idx < N_SECTIONS; ++idx) {
+        auto const& info = hdr._sections[idx];
+        if (info._offset % ALIGN != 0 || info._offset > _content.size() || info._size > _content.size() - info._offset) {
+          zret.error(R"(IP snapshot "{}" section {} is out of bounds.)", path, idx);
+          break;
+        }
+        if (verify_p && info._checksum != checksum({_content.data() + info._offset, info._size})) {
+          zret.error(R"(IP snapshot "{}" section {} is corrupt.)", path, idx);
+          break;
+        }
+      }
+    }
+  }
+  if (!zret.is_ok()) {
+    this->clear();
+  }
+  return zret;
+}
+
+Errata
+IPSnapshotFile::store(file::path const& path, Header& hdr, MemSpan<char const> const (&sections)[N_SECTIONS]) {
+  // Compute the layout and checksums.
+  uint64_t offset = align_up(sizeof(Header));
+  for (unsigned idx = 0; idx < N_SECTIONS; ++idx) {
+    auto& info     = hdr._sections[idx];
+    info._offset   = offset;
+    info._size     = sections[idx].size();
+    info._checksum = checksum({sections[idx].data(), sections[idx].size()});
+    offset         = align_up(offset + info._size);
+  }
+  hdr._checksum = header_checksum(hdr);
+
+  // Write to a temporary file and rename so that a file being mapped by another process is
+  // never partially written. The temporary file name is unique so concurrent writers do not
+  // collide, and it is synced before the rename so a crash can not leave a truncated file in place.
+  std::string tmp_name{path.string() + ".XXXXXX"};
+  int fd = ::mkstemp(tmp_name.data());
+  if (fd < 0) {
+    return Errata().error(R"(Failed to create temporary file "{}" for IP snapshot - {}.)", tmp_name
+                          , std::error_code(errno, std::system_category()));
+  }
+  file::path tmp{tmp_name};
+
+  static constexpr char PAD[ALIGN] = {0};
+  bool ok_p = 0 == ::fchmod(fd, 0644) && write_all(fd, &hdr, sizeof(hdr)) &&
+              write_all(fd, PAD, align_up(sizeof(hdr)) - sizeof(hdr));
+  for (unsigned idx = 0; ok_p && idx < N_SECTIONS; ++idx) {
+    auto n = sections[idx].size();
+    ok_p   = write_all(fd, sections[idx].data(), n) && write_all(fd, PAD, align_up(n) - n);
+  }
+  ok_p = ok_p && 0 == ::fsync(fd);
+  if (!ok_p) {
+    auto zret = Errata().error(R"(Failed to write IP snapshot "{}" - {}.)", tmp, std::error_code(errno, std::system_category()));
+    ::close(fd);
+    ::unlink(tmp.c_str());
+    return zret;
+  }
+  ::close(fd);
+  if (0 != ::rename(tmp.c_str(), path.c_str())) {
+    auto zret = Errata().error(R"(Failed to rename "{}" to "{}" - {}.)", tmp, path, std::error_code(errno, std::system_category()));
+    ::unlink(tmp.c_str());
+    return zret;
+  }
+  // Sync the directory so the rename itself is durable.
+  auto dir = path.parent_path();
+  int dir_fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dir_fd < 0 || 0 != ::fsync(dir_fd)) {
+    auto zret = Errata().error(R"(Failed to sync directory of IP snapshot "{}" - {}.)", path
+                               , std::error_code(errno, std::system_category()));
+    if (dir_fd >= 0) {
+      ::close(dir_fd);
+    }
+    return zret;
+  }
+  ::close(dir_fd);
+  return {};
+}
+
+}} // namespace swoc
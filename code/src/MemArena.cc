@@ -17,7 +17,7 @@ MemArena::MemArena(swoc::MemArena::self_type&& that)
     : _active_allocated(that._active_allocated), _active_reserved(that._active_reserved)
       , _frozen_allocated(that._frozen_allocated), _frozen_reserved(that._frozen_reserved)
       , _reserve_hint(that._reserve_hint), _frozen(std::move(that._frozen))
-      , _active(std::move(that._active)) {
+      , _active(std::move(that._active)), _pool(that._pool) {
   that._active_allocated = that._active_reserved = 0;
   that._frozen_allocated = that._frozen_reserved = 0;
   that._reserve_hint = 0;
@@ -39,6 +39,7 @@ MemArena::operator=(swoc::MemArena::self_type&& that) {
   std::swap(_reserve_hint, that._reserve_hint);
   _active = std::move(that._active);
   _frozen = std::move(that._frozen);
+  _pool = that._pool; // blocks must go back to the pool they came from.
   return *this;
 }
 
@@ -56,6 +57,14 @@ MemArena::make_block(size_t n) {
   // If post-freeze or reserved, allocate at least that much.
   n = std::max<size_t>(n, _reserve_hint);
   _reserve_hint = 0; // did this, clear for next time.
+
+  if (_pool) {
+    if (Block *block = _pool->take(n); block) {
+      _active_reserved += block->size;
+      return block;
+    }
+  }
+
   // Add in overhead and round up to paragraph units.
   n = Paragraph{round_up(n + ALLOC_HEADER_SIZE + sizeof(Block))};
   // If a page or more, round up to page unit size and clip back to account for alloc header.
@@ -145,14 +154,23 @@ MemArena::require(size_t n) {
   return *this;
 }
 
+void
+MemArena::release(BlockPool *pool, Block *block) {
+  if (pool) {
+    pool->give(block);
+  } else {
+    delete block;
+  }
+}
+
 void
 MemArena::destroy_active() {
-  _active.apply([](Block *b) { delete b; }).clear();
+  _active.apply([pool = _pool](Block *b) { release(pool, b); }).clear();
 }
 
 void
 MemArena::destroy_frozen() {
-  _frozen.apply([](Block *b) { delete b; }).clear();
+  _frozen.apply([pool = _pool](Block *b) { release(pool, b); }).clear();
 }
 
 MemArena&
@@ -178,19 +196,140 @@ MemArena::discard(size_t hint) {
 
 MemArena::~MemArena() {
   // Destruct in a way that makes it safe for the instance to be in one of its own memory blocks.
+  // Once a block is returned to the pool another thread may reuse it, so the pool is kept locally.
   Block *ba = _active.head();
   Block *bf = _frozen.head();
+  BlockPool *pool = _pool;
   _active.clear();
   _frozen.clear();
   while (bf) {
     Block *b = bf;
     bf = bf->_link._next;
-    delete b;
+    release(pool, b);
   }
   while (ba) {
     Block *b = ba;
     ba = ba->_link._next;
-    delete b;
+    release(pool, b);
+  }
+}
+
+// --- BlockPool ---
+
+MemArena::BlockPool::BlockPool(size_t max_blocks, size_t max_bytes) : _max_bytes(max_bytes) {
+  for (auto& bin : _bins) {
+    bin._blocks.reset(new Block *[max_blocks]);
+    bin._next.reset(new std::atomic<uint32_t>[max_blocks]);
+    for (uint32_t idx = 0; idx < max_blocks; ++idx) {
+      push(bin, bin._empty, idx);
+    }
+  }
+}
+
+MemArena::BlockPool::~BlockPool() {
+  this->clear();
+}
+
+MemArena::BlockPool&
+MemArena::BlockPool::global() {
+  // Deliberately leaked so that arenas destroyed during process exit can still return blocks.
+  static self_type *pool = new self_type;
+  return *pool;
+}
+
+uint32_t
+MemArena::BlockPool::pop(Bin& bin, std::atomic<uint64_t>& head) {
+  uint64_t h = head.load(std::memory_order_acquire);
+  while (uint32_t(h) != NIL) {
+    uint32_t idx = uint32_t(h);
+    // If another thread pops @a idx first, the tag changes and the exchange fails.
+    uint64_t next = (((h >> 32) + 1) << 32) | bin._next[idx].load(std::memory_order_relaxed);
+    if (head.compare_exchange_weak(h, next, std::memory_order_acquire, std::memory_order_acquire)) {
+      return idx;
+    }
+  }
+  return NIL;
+}
+
+void
+MemArena::BlockPool::push(Bin& bin, std::atomic<uint64_t>& head, uint32_t idx) {
+  uint64_t h = head.load(std::memory_order_relaxed);
+  uint64_t next;
+  do {
+    bin._next[idx].store(uint32_t(h), std::memory_order_relaxed);
+    next = (((h >> 32) + 1) << 32) | idx;
+  } while (!head.compare_exchange_weak(h, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+auto
+MemArena::BlockPool::take(size_t n) -> Block * {
+  unsigned c = 0;
+  while (c < N_CLASSES && class_size(c) < n) {
+    ++c;
+  }
+  if (c >= N_CLASSES) {
+    return nullptr;
+  }
+  Bin& bin = _bins[c];
+  if (auto idx = pop(bin, bin._full); idx != NIL) {
+    Block *block = bin._blocks[idx];
+    push(bin, bin._empty, idx);
+    _bytes.fetch_sub(block->size, std::memory_order_relaxed);
+    _hits.fetch_add(1, std::memory_order_relaxed);
+    return block;
+  }
+  _misses.fetch_add(1, std::memory_order_relaxed);
+  return new (::malloc(sizeof(Block) + class_size(c))) Block(class_size(c));
+}
+
+void
+MemArena::BlockPool::give(Block *block) {
+  unsigned c = 0;
+  while (c < N_CLASSES && class_size(c) < block->size) {
+    ++c;
+  }
+  if (c < N_CLASSES && class_size(c) == block->size) {
+    // Reserve the memory first so concurrent returns can't exceed the limit.
+    if (_bytes.fetch_add(block->size, std::memory_order_relaxed) + block->size <= _max_bytes) {
+      Bin& bin = _bins[c];
+      if (auto idx = pop(bin, bin._empty); idx != NIL) {
+        bin._blocks[idx] = &block->discard();
+        push(bin, bin._full, idx);
+        _returns.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    _bytes.fetch_sub(block->size, std::memory_order_relaxed);
+  }
+  _drops.fetch_add(1, std::memory_order_relaxed);
+  delete block;
+}
+
+auto
+MemArena::BlockPool::stats() const -> Stats {
+  Stats zret;
+  zret._hits    = _hits.load(std::memory_order_relaxed);
+  zret._misses  = _misses.load(std::memory_order_relaxed);
+  zret._returns = _returns.load(std::memory_order_relaxed);
+  zret._drops   = _drops.load(std::memory_order_relaxed);
+  zret._bytes   = _bytes.load(std::memory_order_relaxed);
+  // Not counted directly to keep that off the fast path. This can be transiently off if other
+  // threads are using the pool.
+  auto removed = zret._hits + _cleared.load(std::memory_order_relaxed);
+  zret._blocks = zret._returns > removed ? zret._returns - removed : 0;
+  return zret;
+}
+
+void
+MemArena::BlockPool::clear() {
+  for (auto& bin : _bins) {
+    for (auto idx = pop(bin, bin._full); idx != NIL; idx = pop(bin, bin._full)) {
+      Block *block = bin._blocks[idx];
+      push(bin, bin._empty, idx);
+      _cleared.fetch_add(1, std::memory_order_relaxed);
+      _bytes.fetch_sub(block->size, std::memory_order_relaxed);
+      delete block;
+    }
   }
 }
 
@@ -10,9 +10,19 @@
 */
 
 #include "swoc/TextView.h"
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstring>
 #include <sstream>
 
+#if defined(__x86_64__) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define SWOC_TEXTVIEW_SIMD 1
+#include <immintrin.h>
+/// Compile a function for AVX2, which is selected at run time if the CPU supports it.
+#define SWOC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
 using namespace swoc::literals;
 
 int
@@ -68,9 +78,9 @@ const int8_t svtoi_convert[256] = {
     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 20
     0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, -1, -1, -1, -1, // 30
     -1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, // 40
-    25, 26, 27, 28, 20, 30, 31, 32, 33, 34, 35, -1, -1, -1, -1, -1, // 50
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, -1, -1, -1, -1, -1, // 50
     -1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, // 60
-    25, 26, 27, 28, 20, 30, 31, 32, 33, 34, 35, -1, -1, -1, -1, -1, // 70
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, -1, -1, -1, -1, -1, // 70
     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 80
     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 90
     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // A0
@@ -82,164 +92,630 @@ const int8_t svtoi_convert[256] = {
 };
 /// @endcond
 
-intmax_t
-svtoi(TextView src, TextView *out, int base) {
-  intmax_t zret = 0;
+/* Integer conversion.
+ *
+ * Decimal and hexadecimal are converted 8 digits at a time by loading the digits as a 64 bit word
+ * (SWAR - SIMD within a register). Overflow isn't possible in the leading digits that fit in
+ * @c uintmax_t, so the checks are done only for any digits past that.
+ */
+namespace {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SWOC_SWAR_DIGITS 1
 
-  if (src.ltrim_if(&isspace) && src) {
-    TextView parsed;
-    const char *start = src.data();
-    bool neg = false;
-    if ('-' == *src) {
-      ++src;
-      neg = true;
-    } else if ('+' == *src) {
-      ++src;
+constexpr uint64_t SWAR_ONES = 0x0101010101010101ULL; ///< Low bit of each byte.
+constexpr uint64_t SWAR_HIGH = 0x8080808080808080ULL; ///< High bit of each byte.
+
+/// @return The 8 bytes at @a text, the first byte in the low order bits.
+inline uint64_t
+swar_load(char const *text) {
+  uint64_t zret;
+  memcpy(&zret, text, sizeof(zret));
+  return zret;
+}
+
+/// @return The high bit set in each byte of @a x that is greater than @a lo and less than @a hi.
+inline uint64_t
+swar_between(uint64_t x, uint8_t lo, uint8_t hi) {
+  uint64_t low7 = x & (SWAR_ONES * 0x7F);
+  return (SWAR_ONES * (127 + hi) - low7) & ~x & (low7 + SWAR_ONES * (127 - lo)) & SWAR_HIGH;
+}
+
+/// @return The high bit set in each byte of @a x that is a decimal digit.
+inline uint64_t
+swar_digits(uint64_t x) {
+  return swar_between(x, '0' - 1, '9' + 1);
+}
+
+/** Shift the leading @a k digits in @a x to the high order bytes, filling with '0'.
+ *
+ * @param x Characters.
+ * @param k Number of digits, 1..7.
+ * @return @a x as the last 8 digits of the number in the first @a k characters.
+ */
+inline uint64_t
+swar_align(uint64_t x, unsigned k) {
+  return (x << (64 - 8 * k)) | (0x3030303030303030ULL >> (8 * k));
+}
+
+/// @return The value of the 8 decimal digits in @a x.
+inline uint32_t
+swar_decimal(uint64_t x) {
+  x -= 0x3030303030303030ULL;
+  x = (x * 10) + (x >> 8); // pairs of digits.
+  x = (((x & 0x000000FF000000FFULL) * 0x000F424000000064ULL) + (((x >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >>
+      32;
+  return uint32_t(x);
+}
+
+/// @return The high bit set in each byte of @a x that is a hexadecimal letter.
+inline uint64_t
+swar_hex_alpha(uint64_t x) {
+  return swar_between(x | (SWAR_ONES * 0x20), 'a' - 1, 'f' + 1);
+}
+
+
+/// @return The value of the 8 hexadecimal digits in @a x, where @a alpha marks the letters.
+inline uint32_t
+swar_hex(uint64_t x, uint64_t alpha) {
+  // The low nibble is the value for digits, and 9 less than the value for letters.
+  x = (x & (SWAR_ONES * 0x0F)) + (alpha >> 7) * 9;
+  // Combine pairs of nibbles, then bytes, then 16 bit values. The first digit is in the low bits.
+  x = ((x & 0x00FF00FF00FF00FFULL) << 4) | ((x >> 8) & 0x00FF00FF00FF00FFULL);
+  x = ((x & 0x0000FFFF0000FFFFULL) << 8) | ((x >> 16) & 0x0000FFFF0000FFFFULL);
+  return uint32_t(((x & 0xFFFFFFFFULL) << 16) | (x >> 32));
+}
+#endif
+
+/** Convert the digits at @a spot.
+ *
+ * @param zret Result to update.
+ * @param src Text to convert.
+ * @param spot First unconverted digit.
+ * @param radix Conversion radix.
+ *
+ * The digits already converted must not have overflowed.
+ */
+ParsedNumber<uintmax_t> &
+svto_finish(ParsedNumber<uintmax_t> &zret, TextView src, char const *spot, uintmax_t radix) {
+  char const *limit = src.data_end();
+  bool overflow_p   = false;
+  int8_t v;
+  for (; spot < limit && 0 <= (v = svtoi_convert[uint8_t(*spot)]) && uintmax_t(v) < radix; ++spot) {
+    overflow_p |= __builtin_mul_overflow(zret.value, radix, &zret.value);
+    overflow_p |= __builtin_add_overflow(zret.value, uintmax_t(v), &zret.value);
+  }
+  zret.parsed.assign(src.data(), spot);
+  if (overflow_p) {
+    zret.value = std::numeric_limits<uintmax_t>::max();
+    zret.error = std::errc::result_out_of_range;
+  } else if (zret.parsed.empty()) {
+    zret.error = std::errc::invalid_argument;
+  }
+  return zret;
+}
+
+/// White space skipped before a number, the same as @c isspace in the "C" locale.
+constexpr CharSet SPACES{" \t\n\v\f\r"};
+
+} // namespace
+
+template <>
+ParsedNumber<uintmax_t>
+svto_radix_checked<10>(TextView src) {
+  // Any value with this many digits fits.
+  static constexpr int SAFE = std::numeric_limits<uintmax_t>::digits10;
+  ParsedNumber<uintmax_t> zret;
+  char const *spot = src.data();
+  char const *safe = spot + std::min<size_t>(src.size(), SAFE);
+#if SWOC_SWAR_DIGITS
+  static constexpr uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+  // The first non-digit in a word ends the number, with no per digit branching.
+  while (src.data_end() - spot >= 8 && spot - src.data() <= SAFE - 8) {
+    uint64_t x     = swar_load(spot);
+    uint64_t other = ~swar_digits(x) & SWAR_HIGH;
+    if (0 == other) {
+      zret.value = zret.value * 100000000 + swar_decimal(x);
+      spot += 8;
+      continue;
     }
-    zret = intmax_t(svtou(src, &parsed, base));
-    if (!parsed.empty()) {
-      if (out) {
-        out->assign(start, parsed.data_end());
-      }
-      if (neg) {
-        zret = -zret;
+    // The number ends in this word, so it's complete.
+    if (unsigned k = __builtin_ctzll(other) / 8; k > 0) {
+      zret.value = zret.value * POW10[k] + swar_decimal(swar_align(x, k));
+      spot += k;
+    }
+    zret.parsed.assign(src.data(), spot);
+    if (zret.parsed.empty()) {
+      zret.error = std::errc::invalid_argument;
+    }
+    return zret;
+  }
+#endif
+  for (; spot < safe && '0' <= *spot && *spot <= '9'; ++spot) {
+    zret.value = zret.value * 10 + (*spot - '0');
+  }
+  return svto_finish(zret, src, spot, 10);
+}
+
+template <>
+ParsedNumber<uintmax_t>
+svto_radix_checked<16>(TextView src) {
+  // Any value with this many digits fits.
+  static constexpr int SAFE = std::numeric_limits<uintmax_t>::digits / 4;
+  ParsedNumber<uintmax_t> zret;
+  char const *spot = src.data();
+  char const *safe = spot + std::min<size_t>(src.size(), SAFE);
+#if SWOC_SWAR_DIGITS
+  while (src.data_end() - spot >= 8 && spot - src.data() <= SAFE - 8) {
+    uint64_t x     = swar_load(spot);
+    uint64_t alpha = swar_hex_alpha(x);
+    uint64_t other = ~(swar_digits(x) | alpha) & SWAR_HIGH;
+    if (0 == other) {
+      zret.value = (zret.value << 32) | swar_hex(x, alpha);
+      spot += 8;
+      continue;
+    }
+    // The number ends in this word, so it's complete.
+    if (unsigned k = __builtin_ctzll(other) / 8; k > 0) {
+      zret.value = (zret.value << (4 * k)) | swar_hex(swar_align(x, k), alpha << (64 - 8 * k));
+      spot += k;
+    }
+    zret.parsed.assign(src.data(), spot);
+    if (zret.parsed.empty()) {
+      zret.error = std::errc::invalid_argument;
+    }
+    return zret;
+  }
+#endif
+  for (int8_t v; spot < safe && 0 <= (v = svtoi_convert[uint8_t(*spot)]) && v < 16; ++spot) {
+    zret.value = (zret.value << 4) | v;
+  }
+  return svto_finish(zret, src, spot, 16);
+}
+
+ParsedNumber<uintmax_t>
+svtou_checked(TextView src, int base) {
+  ParsedNumber<uintmax_t> zret;
+
+  if (!(0 <= base && base <= 36)) {
+    zret.error = std::errc::invalid_argument;
+    return zret;
+  }
+  if (src && SPACES(*src)) {
+    src.ltrim(SPACES);
+  }
+  auto origin = src.data();
+  // If base is 0, it wasn't specified - check for standard base prefixes
+  if (0 == base) {
+    base = 10;
+    if (src && '0' == *src) {
+      ++src;
+      base = 8;
+      if (src && ('x' == *src || 'X' == *src)) {
+        ++src;
+        base = 16;
       }
     }
   }
+
+  // For performance in common cases, use the templated conversion.
+  switch (base) {
+    case 8:
+      zret = svto_radix_checked<8>(src);
+      break;
+    case 10:
+      zret = svto_radix_checked<10>(src);
+      break;
+    case 16:
+      zret = svto_radix_checked<16>(src);
+      break;
+    default:
+      svto_finish(zret, src, src.data(), base);
+      break;
+  }
+
+  // Include any radix prefix, which may be all that was parsed (e.g. "0").
+  zret.parsed.assign(origin, src.data() + zret.parsed.size());
+  if (zret.error == std::errc::invalid_argument && !zret.parsed.empty()) {
+    zret.error = std::errc{};
+  }
+  return zret;
+}
+
+ParsedNumber<intmax_t>
+svtoi_checked(TextView src, int base) {
+  ParsedNumber<intmax_t> zret;
+
+  if (src && SPACES(*src)) {
+    src.ltrim(SPACES);
+  }
+  const char *start = src.data();
+  bool neg          = false;
+  if (src && '-' == *src) {
+    ++src;
+    neg = true;
+  } else if (src && '+' == *src) {
+    ++src;
+  }
+  auto n = svtou_checked(src, base);
+  if (n.parsed.empty()) {
+    zret.error = n.error;
+    return zret;
+  }
+  zret.parsed.assign(start, n.parsed.data_end());
+  zret.error = n.error;
+  // Magnitude of the limit in the direction of the sign.
+  uintmax_t limit = uintmax_t(std::numeric_limits<intmax_t>::max()) + (neg ? 1 : 0);
+  if (n.error == std::errc::result_out_of_range || n.value > limit) {
+    zret.value = neg ? std::numeric_limits<intmax_t>::min() : std::numeric_limits<intmax_t>::max();
+    zret.error = std::errc::result_out_of_range;
+  } else if (neg) {
+    zret.value = n.value ? -intmax_t(n.value - 1) - 1 : 0;
+  } else {
+    zret.value = intmax_t(n.value);
+  }
   return zret;
 }
 
+intmax_t
+svtoi(TextView src, TextView *out, int base) {
+  auto zret = svtoi_checked(src, base);
+  if (out) {
+    *out = zret.parsed;
+  }
+  return zret.value;
+}
+
 uintmax_t
 svtou(TextView src, TextView *out, int base) {
-  uintmax_t zret = 0;
-
+  auto zret = svtou_checked(src, base);
   if (out) {
-    out->clear();
+    *out = zret.parsed;
   }
-  if (!(0 <= base && base <= 36)) {
-    return 0;
+  return zret.value;
+}
+
+/* Delimiter search.
+ *
+ * Searches are done in blocks of 16 (SSE2) or 32 (AVX2) bytes, using a matcher to compute a bit
+ * mask of the bytes in a block that are in the set. The last (or first, searching backwards)
+ * partial block is done by searching an overlapping full block - the overlapped bytes have already
+ * been checked and so can't match.
+ *
+ * A string of delimiters is matched by comparing the block against each delimiter. This is limited
+ * to a few delimiters as the cost is linear in the number of delimiters, larger sets use a table
+ * lookup per byte. A @c CharSet is matched using its nibble tables, which is the same cost for any
+ * set but requires a byte shuffle and so is done only with AVX2.
+ *
+ * AVX2 is not part of the base x86_64 instruction set and so is selected at run time.
+ */
+namespace {
+/// Maximum number of delimiters for a vectorized search.
+constexpr size_t MAX_SIMD_DELIMITERS = 8;
+
+template <typename F>
+size_t
+scalar_find_first(std::string_view const &src, F const &pred, bool in_p) {
+  for (size_t idx = 0, n = src.size(); idx < n; ++idx) {
+    if (pred(src[idx]) == in_p) {
+      return idx;
+    }
   }
-  if (src.ltrim_if(&isspace).size()) {
-    auto origin = src.data();
-    int8_t v;
-    // If base is 0, it wasn't specified - check for standard base prefixes
-    if (0 == base) {
-      base = 10;
-      if ('0' == *src) {
-        ++src;
-        base = 8;
-        if (src && ('x' == *src || 'X' == *src)) {
-          ++src;
-          base = 16;
-        }
-      }
+  return TextView::npos;
+}
+
+template <typename F>
+size_t
+scalar_find_last(std::string_view const &src, F const &pred, bool in_p) {
+  for (size_t idx = src.size(); idx > 0;) {
+    if (pred(src[--idx]) == in_p) {
+      return idx;
     }
+  }
+  return TextView::npos;
+}
+
+size_t
+scalar_find_first_in(std::string_view const &src, std::string_view const &delimiters, bool in_p) {
+  if (delimiters.size() == 1) { // common case, don't bother with the table.
+    return scalar_find_first(src, [c = delimiters[0]](char x) { return x == c; }, in_p);
+  }
+  return scalar_find_first(src, CharSet(delimiters), in_p);
+}
+
+size_t
+scalar_find_last_in(std::string_view const &src, std::string_view const &delimiters, bool in_p) {
+  if (delimiters.size() == 1) {
+    return scalar_find_last(src, [c = delimiters[0]](char x) { return x == c; }, in_p);
+  }
+  return scalar_find_last(src, CharSet(delimiters), in_p);
+}
 
-    // For performance in common cases, use the templated conversion.
-    switch (base) {
-      case 8:zret = svto_radix<8>(src);
-        break;
-      case 10:zret = svto_radix<10>(src);
-        break;
-      case 16:zret = svto_radix<16>(src);
-        break;
-      default:
-        while (src.size() && (0 <= (v = svtoi_convert[static_cast<unsigned char>(*src)])) &&
-               v < base) {
-          auto n = zret * base + v;
-          if (n < zret) {
-            zret = std::numeric_limits<uintmax_t>::max();
-            break; // overflow, stop parsing.
-          }
-          zret = n;
-          ++src;
-        }
-        break;
+#if SWOC_TEXTVIEW_SIMD
+/// Matches up to @c MAX_SIMD_DELIMITERS delimiters, 16 bytes at a time.
+struct Sse2Delimiters {
+  static constexpr size_t WIDTH = 16;
+
+  Sse2Delimiters(char const *delimiters, size_t n, bool in_p) : _n(n), _flip(in_p ? 0 : 0xFFFF) {
+    for (size_t k = 0; k < n; ++k) {
+      _set[k] = _mm_set1_epi8(delimiters[k]);
     }
+  }
 
-    if (out) {
-      out->assign(origin, src.data());
+  /// Bit mask of the bytes in the block at @a text that match.
+  unsigned
+  operator()(char const *text) const {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(text));
+    __m128i m = _mm_cmpeq_epi8(v, _set[0]);
+    for (size_t k = 1; k < _n; ++k) {
+      m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _set[k]));
     }
+    return static_cast<unsigned>(_mm_movemask_epi8(m)) ^ _flip;
   }
-  return zret;
-}
 
-double svtod(swoc::TextView text, swoc::TextView *parsed) {
-  // @return 10^e
-  auto pow10 = [](int e) -> double  {
-    double zret = 1.0;
-    double scale = 10.0;
-    if (e < 0) { // flip the scale and make @a e positive.
-      e = -e;
-      scale = 0.1;
+  __m128i _set[MAX_SIMD_DELIMITERS];
+  size_t _n;
+  unsigned _flip;
+};
+
+/// Matches up to @c MAX_SIMD_DELIMITERS delimiters, 32 bytes at a time.
+struct Avx2Delimiters {
+  static constexpr size_t WIDTH = 32;
+
+  SWOC_TARGET_AVX2
+  Avx2Delimiters(char const *delimiters, size_t n, bool in_p) : _n(n), _flip(in_p ? 0 : 0xFFFFFFFF) {
+    for (size_t k = 0; k < n; ++k) {
+      _set[k] = _mm256_set1_epi8(delimiters[k]);
     }
+  }
 
-    // Walk the bits in the exponent @a e and multiply the scale for set bits.
-    while (e) {
-      if (e & 1) {
-        zret *= scale;
-      }
-      scale *= scale;
-      e >>= 1;
+  SWOC_TARGET_AVX2 unsigned
+  operator()(char const *text) const {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(text));
+    __m256i m = _mm256_cmpeq_epi8(v, _set[0]);
+    for (size_t k = 1; k < _n; ++k) {
+      m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _set[k]));
     }
-    return zret;
-  };
+    return static_cast<unsigned>(_mm256_movemask_epi8(m)) ^ _flip;
+  }
 
-  if (text.empty()) {
-    return 0;
+  __m256i _set[MAX_SIMD_DELIMITERS];
+  size_t _n;
+  unsigned _flip;
+};
+
+/** Matches a @c CharSet, 32 bytes at a time.
+ *
+ * Each byte selects a table row with its low nibble, from the first table if the byte is less than
+ * 0x80 and the second if not, and the row is checked for the bit for the high nibble.
+ */
+struct Avx2Nibbles {
+  static constexpr size_t WIDTH = 32;
+
+  SWOC_TARGET_AVX2
+  Avx2Nibbles(uint8_t const *nibbles, bool in_p) : _flip(in_p ? 0 : 0xFFFFFFFF) {
+    __m128i low  = _mm_loadu_si128(reinterpret_cast<__m128i const *>(nibbles));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<__m128i const *>(nibbles + 16));
+    _low         = _mm256_broadcastsi128_si256(low);
+    _high        = _mm256_broadcastsi128_si256(high);
+    _bits        = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64,
+                                    -128, 1, 2, 4, 8, 16, 32, 64, -128);
   }
 
-  auto org_text = text; // save this to update @a parsed.
-  // Check just once and dump to a local copy if needed.
-  TextView local_parsed;
-  if (! parsed) {
-    parsed = &local_parsed;
+  SWOC_TARGET_AVX2 unsigned
+  operator()(char const *text) const {
+    __m256i const mask = _mm256_set1_epi8(0x0F);
+    __m256i v          = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(text));
+    __m256i lo         = _mm256_and_si256(v, mask);
+    __m256i hi         = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+    __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(_low, lo), _mm256_shuffle_epi8(_high, lo), v);
+    __m256i bit = _mm256_shuffle_epi8(_bits, hi);
+    __m256i m   = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+    return static_cast<unsigned>(_mm256_movemask_epi8(m)) ^ _flip;
   }
 
-  // Handle leading sign.
-  int sign = 1;
-  if (*text == '-') {
-    ++text;
-    sign = -1;
-  } else if (*text == '+') {
-    ++text;
+  __m256i _low;
+  __m256i _high;
+  __m256i _bits;
+  unsigned _flip;
+};
+
+// The block search loops. @a n must be at least the matcher width. These are duplicated so the
+// AVX2 versions can be compiled for AVX2, which is required for the matcher to be inlined.
+
+template <typename M>
+size_t
+sse2_find_first(char const *text, size_t n, M const &match) {
+  constexpr size_t W = M::WIDTH;
+  size_t idx         = 0;
+  for (; idx + W <= n; idx += W) {
+    if (auto bits = match(text + idx); bits) {
+      return idx + __builtin_ctz(bits);
+    }
+  }
+  if (idx < n) {
+    idx = n - W;
+    if (auto bits = match(text + idx); bits) {
+      return idx + __builtin_ctz(bits);
+    }
   }
-  // Parse the leading whole part as an integer.
-  intmax_t whole = svto_radix<10>(text);
-  parsed->assign(org_text.data(), text.data());
+  return TextView::npos;
+}
 
-  if (text.empty()) {
-    return whole;
+template <typename M>
+size_t
+sse2_find_last(char const *text, size_t n, M const &match) {
+  constexpr size_t W = M::WIDTH;
+  size_t idx         = n;
+  for (; idx >= W; idx -= W) {
+    if (auto bits = match(text + idx - W); bits) {
+      return idx - W + (31 - __builtin_clz(bits));
+    }
+  }
+  if (idx > 0) {
+    if (auto bits = match(text); bits) {
+      return 31 - __builtin_clz(bits);
+    }
   }
+  return TextView::npos;
+}
 
-  double frac = 0.0;
-  if (*text == '.') { // fractional part.
-    ++text;
-    double scale = 0.1;
-    while (text && isdigit(*text)) {
-      frac += scale * (*text++ - '0');
-      scale /= 10.0;
+template <typename M>
+SWOC_TARGET_AVX2 size_t
+avx2_find_first(char const *text, size_t n, M const &match) {
+  constexpr size_t W = M::WIDTH;
+  size_t idx         = 0;
+  for (; idx + W <= n; idx += W) {
+    if (auto bits = match(text + idx); bits) {
+      return idx + __builtin_ctz(bits);
+    }
+  }
+  if (idx < n) {
+    idx = n - W;
+    if (auto bits = match(text + idx); bits) {
+      return idx + __builtin_ctz(bits);
     }
   }
+  return TextView::npos;
+}
 
-  double exp = 1.0;
-  if (text.starts_with_nocase("e")) {
-    int exp_sign = 1;
-    ++text;
-    if (text) {
-      if (*text == '+') {
-        ++text;
-      } else if (*text == '-') {
-        ++text;
-        exp_sign = -1;
-      }
+template <typename M>
+SWOC_TARGET_AVX2 size_t
+avx2_find_last(char const *text, size_t n, M const &match) {
+  constexpr size_t W = M::WIDTH;
+  size_t idx         = n;
+  for (; idx >= W; idx -= W) {
+    if (auto bits = match(text + idx - W); bits) {
+      return idx - W + (31 - __builtin_clz(bits));
     }
-    auto exp_part = svto_radix<10>(text);
-    exp = pow10(exp_part * exp_sign);
   }
+  if (idx > 0) {
+    if (auto bits = match(text); bits) {
+      return 31 - __builtin_clz(bits);
+    }
+  }
+  return TextView::npos;
+}
+
+// Search functions, @a n must be at least 16.
+
+size_t
+sse2_find_first_in(char const *text, size_t n, char const *delimiters, size_t n_set, bool in_p) {
+  return sse2_find_first(text, n, Sse2Delimiters(delimiters, n_set, in_p));
+}
+
+size_t
+sse2_find_last_in(char const *text, size_t n, char const *delimiters, size_t n_set, bool in_p) {
+  return sse2_find_last(text, n, Sse2Delimiters(delimiters, n_set, in_p));
+}
+
+SWOC_TARGET_AVX2 size_t
+avx2_find_first_in(char const *text, size_t n, char const *delimiters, size_t n_set, bool in_p) {
+  if (n < Avx2Delimiters::WIDTH) {
+    return sse2_find_first_in(text, n, delimiters, n_set, in_p);
+  }
+  return avx2_find_first(text, n, Avx2Delimiters(delimiters, n_set, in_p));
+}
+
+SWOC_TARGET_AVX2 size_t
+avx2_find_last_in(char const *text, size_t n, char const *delimiters, size_t n_set, bool in_p) {
+  if (n < Avx2Delimiters::WIDTH) {
+    return sse2_find_last_in(text, n, delimiters, n_set, in_p);
+  }
+  return avx2_find_last(text, n, Avx2Delimiters(delimiters, n_set, in_p));
+}
+
+SWOC_TARGET_AVX2 size_t
+avx2_find_first_of_set(char const *text, size_t n, uint8_t const *nibbles, bool in_p) {
+  return avx2_find_first(text, n, Avx2Nibbles(nibbles, in_p));
+}
+
+SWOC_TARGET_AVX2 size_t
+avx2_find_last_of_set(char const *text, size_t n, uint8_t const *nibbles, bool in_p) {
+  return avx2_find_last(text, n, Avx2Nibbles(nibbles, in_p));
+}
+
+/// Search implementations for the CPU.
+struct Searcher {
+  /// Search for delimiters - text, text size, delimiters, delimiter count, in set.
+  using DelimiterFunc = size_t (*)(char const *, size_t, char const *, size_t, bool);
+  /// Search for a @c CharSet - text, text size, nibble tables, in set.
+  using SetFunc = size_t (*)(char const *, size_t, uint8_t const *, bool);
+
+  DelimiterFunc _first_in;
+  DelimiterFunc _last_in;
+  SetFunc _first_of_set; ///< @c nullptr if not supported.
+  SetFunc _last_of_set;  ///< @c nullptr if not supported.
+};
+
+constexpr Searcher SSE2_SEARCHER{&sse2_find_first_in, &sse2_find_last_in, nullptr, nullptr};
+constexpr Searcher AVX2_SEARCHER{&avx2_find_first_in, &avx2_find_last_in, &avx2_find_first_of_set,
+                                 &avx2_find_last_of_set};
+
+/// Selected implementation, set on first use. This is not done during static initialization as
+/// views can be used during static initialization.
+std::atomic<Searcher const *> Active_Searcher{nullptr};
+
+Searcher const &
+searcher() {
+  auto zret = Active_Searcher.load(std::memory_order_relaxed);
+  if (nullptr == zret) {
+    __builtin_cpu_init();
+    zret = __builtin_cpu_supports("avx2") ? &AVX2_SEARCHER : &SSE2_SEARCHER;
+    Active_Searcher.store(zret, std::memory_order_relaxed);
+  }
+  return *zret;
+}
+#endif
+} // namespace
+
+size_t
+TextView::find_first_in(std::string_view const &src, std::string_view const &delimiters, bool in_p) {
+  if (delimiters.empty()) {
+    return in_p || src.empty() ? npos : 0;
+  }
+#if SWOC_TEXTVIEW_SIMD
+  if (src.size() >= 16 && delimiters.size() <= MAX_SIMD_DELIMITERS) {
+    return searcher()._first_in(src.data(), src.size(), delimiters.data(), delimiters.size(), in_p);
+  }
+#endif
+  return scalar_find_first_in(src, delimiters, in_p);
+}
 
-  parsed->assign(org_text.data(), text.data());
-  return sign * (whole + frac) * exp;
+size_t
+TextView::find_last_in(std::string_view const &src, std::string_view const &delimiters, bool in_p) {
+  if (delimiters.empty()) {
+    return in_p || src.empty() ? npos : src.size() - 1;
+  }
+#if SWOC_TEXTVIEW_SIMD
+  if (src.size() >= 16 && delimiters.size() <= MAX_SIMD_DELIMITERS) {
+    return searcher()._last_in(src.data(), src.size(), delimiters.data(), delimiters.size(), in_p);
+  }
+#endif
+  return scalar_find_last_in(src, delimiters, in_p);
+}
+
+size_t
+TextView::find_first_in(std::string_view const &src, CharSet const &set, bool in_p) {
+#if SWOC_TEXTVIEW_SIMD
+  if (src.size() >= 32) {
+    if (auto f = searcher()._first_of_set; f) {
+      return f(src.data(), src.size(), set._nibbles, in_p);
+    }
+  }
+#endif
+  return scalar_find_first(src, set, in_p);
+}
+
+size_t
+TextView::find_last_in(std::string_view const &src, CharSet const &set, bool in_p) {
+#if SWOC_TEXTVIEW_SIMD
+  if (src.size() >= 32) {
+    if (auto f = searcher()._last_of_set; f) {
+      return f(src.data(), src.size(), set._nibbles, in_p);
+    }
+  }
+#endif
+  return scalar_find_last(src, set, in_p);
 }
 
 // Do the template instantiations.
@@ -37,6 +37,10 @@ Spec::Property::Property() {
   _data['b'] = TYPE_CHAR | NUMERIC_TYPE_CHAR;
   _data['B'] = TYPE_CHAR | NUMERIC_TYPE_CHAR | UPPER_TYPE_CHAR;
   _data['d'] = TYPE_CHAR | NUMERIC_TYPE_CHAR;
+  _data['e'] = TYPE_CHAR | NUMERIC_TYPE_CHAR;
+  _data['E'] = TYPE_CHAR | NUMERIC_TYPE_CHAR | UPPER_TYPE_CHAR;
+  _data['f'] = TYPE_CHAR | NUMERIC_TYPE_CHAR;
+  _data['F'] = TYPE_CHAR | NUMERIC_TYPE_CHAR | UPPER_TYPE_CHAR;
   _data['g'] = TYPE_CHAR;
   _data['o'] = TYPE_CHAR | NUMERIC_TYPE_CHAR;
   _data['p'] = TYPE_CHAR;
@@ -307,6 +311,79 @@ char UPPER_DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 char LOWER_DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
 static const std::array<uint64_t, 11> POWERS_OF_TEN = {
     {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000}};
+
+/// Pairs of digits in radix @a RADIX, from @a digits, for converting two digits per division.
+template <unsigned RADIX>
+constexpr std::array<char, 2 * RADIX * RADIX>
+Digit_Pairs(char const *digits) {
+  std::array<char, 2 * RADIX * RADIX> zret{};
+  for (unsigned i = 0; i < RADIX * RADIX; ++i) {
+    zret[2 * i]     = digits[i / RADIX];
+    zret[2 * i + 1] = digits[i % RADIX];
+  }
+  return zret;
+}
+
+constexpr auto DECIMAL_PAIRS   = Digit_Pairs<10>("0123456789");
+constexpr auto LOWER_HEX_PAIRS = Digit_Pairs<16>("0123456789abcdef");
+constexpr auto UPPER_HEX_PAIRS = Digit_Pairs<16>("0123456789ABCDEF");
+
+/** Write the decimal digits of @a n backwards from @a out.
+ *
+ * @param out End of the output.
+ * @param n Value.
+ * @return The first digit.
+ */
+char *
+Write_Decimal(char *out, uintmax_t n) {
+  // Split off 8 digits at a time until the rest can be done with faster 32 bit arithmetic.
+  while (n > std::numeric_limits<uint32_t>::max()) {
+    auto chunk = static_cast<uint32_t>(n % 100000000);
+    n /= 100000000;
+    for (int k = 0; k < 4; ++k) {
+      out -= 2;
+      memcpy(out, DECIMAL_PAIRS.data() + (chunk % 100) * 2, 2);
+      chunk /= 100;
+    }
+  }
+  auto v = static_cast<uint32_t>(n);
+  while (v >= 100) {
+    auto k = (v % 100) * 2;
+    v /= 100;
+    out -= 2;
+    memcpy(out, DECIMAL_PAIRS.data() + k, 2);
+  }
+  if (v >= 10) {
+    out -= 2;
+    memcpy(out, DECIMAL_PAIRS.data() + v * 2, 2);
+  } else {
+    *--out = char('0' + v);
+  }
+  return out;
+}
+
+/** Write the hexadecimal digits of @a n backwards from @a out.
+ *
+ * @param out End of the output.
+ * @param n Value.
+ * @param pairs Digit pairs, which determines the case.
+ * @return The first digit.
+ */
+char *
+Write_Hex(char *out, uintmax_t n, char const *pairs) {
+  while (n >= 0x100) {
+    out -= 2;
+    memcpy(out, pairs + (n & 0xFF) * 2, 2);
+    n >>= 8;
+  }
+  if (n >= 0x10) {
+    out -= 2;
+    memcpy(out, pairs + n * 2, 2);
+  } else {
+    *--out = pairs[n * 2 + 1];
+  }
+  return out;
+}
 } // namespace
 
 /// Templated radix based conversions. Only a small number of radix are
@@ -383,12 +460,14 @@ Write_Aligned(BufferWriter& w, F const& f, Spec::Align align, int width, char fi
 
 BufferWriter&
 Format_Integer(BufferWriter& w, Spec const& spec, uintmax_t i, bool neg_p) {
-  size_t n = 0;
   int width = static_cast<int>(spec._min); // amount left to fill.
   char neg = 0;
   char prefix1 = spec._radix_lead_p ? '0' : 0;
   char prefix2 = 0;
-  char buff[std::numeric_limits<uintmax_t>::digits + 1];
+  // Room for the digits, sign, and radix prefix.
+  char buff[std::numeric_limits<uintmax_t>::digits + 3];
+  char *const end = buff + sizeof(buff);
+  char *out;
 
   if (spec._sign != Spec::SIGN_NEVER) {
     if (neg_p) {
@@ -400,23 +479,24 @@ Format_Integer(BufferWriter& w, Spec const& spec, uintmax_t i, bool neg_p) {
 
   switch (spec._type) {
     case 'x':prefix2 = 'x';
-      n = bwf::To_Radix<16>(i, buff, sizeof(buff), bwf::LOWER_DIGITS);
+      out = Write_Hex(end, i, LOWER_HEX_PAIRS.data());
       break;
     case 'X':prefix2 = 'X';
-      n = bwf::To_Radix<16>(i, buff, sizeof(buff), bwf::UPPER_DIGITS);
+      out = Write_Hex(end, i, UPPER_HEX_PAIRS.data());
       break;
     case 'b':prefix2 = 'b';
-      n = bwf::To_Radix<2>(i, buff, sizeof(buff), bwf::LOWER_DIGITS);
+      out = end - bwf::To_Radix<2>(i, buff, sizeof(buff), bwf::LOWER_DIGITS);
       break;
     case 'B':prefix2 = 'B';
-      n = bwf::To_Radix<2>(i, buff, sizeof(buff), bwf::UPPER_DIGITS);
+      out = end - bwf::To_Radix<2>(i, buff, sizeof(buff), bwf::UPPER_DIGITS);
       break;
-    case 'o':n = bwf::To_Radix<8>(i, buff, sizeof(buff), bwf::LOWER_DIGITS);
+    case 'o':out = end - bwf::To_Radix<8>(i, buff, sizeof(buff), bwf::LOWER_DIGITS);
       break;
     default:prefix1 = 0;
-      n = bwf::To_Radix<10>(i, buff, sizeof(buff), bwf::LOWER_DIGITS);
+      out = Write_Decimal(end, i);
       break;
   }
+  size_t n = end - out;
   // Clip fill width by stuff that's already committed to be written.
   if (neg) {
     --width;
@@ -428,8 +508,21 @@ Format_Integer(BufferWriter& w, Spec const& spec, uintmax_t i, bool neg_p) {
     }
   }
   width -= static_cast<int>(n);
-  std::string_view digits{buff + sizeof(buff) - n, n};
 
+  if (width <= 0) { // No fill, so the output is the same for every alignment - write it at once.
+    if (prefix1) {
+      if (prefix2) {
+        *--out = prefix2;
+      }
+      *--out = prefix1;
+    }
+    if (neg) {
+      *--out = neg;
+    }
+    return w.write(out, end - out);
+  }
+
+  std::string_view digits{out, n};
   if (spec._align == Spec::Align::SIGN) { // custom for signed case because
     // prefix and digits are seperated.
     if (neg) {
@@ -468,8 +561,18 @@ Format_Integer(BufferWriter& w, Spec const& spec, uintmax_t i, bool neg_p) {
 ///
 /// format: whole.fraction
 ///     or: left.right
+///
+/// The types 'f', 'F', 'e', and 'E' are passed to @c Format_Float_Decimal.
 BufferWriter&
 Format_Float(BufferWriter& w, Spec const& spec, double f, bool negative_p) {
+  switch (spec._type) {
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+      return Format_Float_Decimal(w, spec, f, negative_p);
+  }
+
   static const std::string_view infinity_bwf{"Inf"};
   static const std::string_view nan_bwf{"NaN"};
   static const std::string_view zero_bwf{"0"};
@@ -699,45 +802,6 @@ bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Errno const& e) {
   return w;
 }
 
-bwf::Date::Date(std::string_view fmt)
-    : _epoch(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())), _fmt(fmt) {}
-
-BufferWriter&
-bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Date const& date) {
-  if (spec.has_numeric_type()) {
-    bwformat(w, spec, date._epoch);
-  } else {
-    struct tm t;
-    auto r = w.remaining();
-    size_t n{0};
-    // Verify @a fmt is null terminated, even outside the bounds of the view.
-    if (date._fmt.data()[date._fmt.size() - 1] != 0 && date._fmt.data()[date._fmt.size()] != 0) {
-      throw (std::invalid_argument{"BWF Date String is not null terminated."});
-    }
-    // Get the time, GMT or local if specified.
-    if (spec._ext == "local"sv) {
-      localtime_r(&date._epoch, &t);
-    } else {
-      gmtime_r(&date._epoch, &t);
-    }
-    // Try a direct write, faster if it works.
-    if (r > 0) {
-      n = strftime(w.aux_data(), r, date._fmt.data(), &t);
-    }
-    if (n > 0) {
-      w.commit(n);
-    } else {
-      // Direct write didn't work. Unfortunately need to write to a temporary
-      // buffer or the sizing isn't correct if @a w is clipped because @c
-      // strftime returns 0 if the buffer isn't large enough.
-      char buff[256]; // hope for the best - no real way to resize appropriately on failure.
-      n = strftime(buff, sizeof(buff), date._fmt.data(), &t);
-      w.write(buff, n);
-    }
-  }
-  return w;
-}
-
 BufferWriter&
 bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Pattern const& pattern) {
   auto limit = std::min<size_t>(spec._max, pattern._text.size() * pattern._n);
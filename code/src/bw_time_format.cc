@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+    BufferWriter formatting for time stamps.
+
+    Rendering a time stamp is mostly the cost of converting the epoch to calendar fields and
+    generating the text, which is the same for every time stamp in a second. Each thread therefore
+    keeps the text for the most recent second, and only the sub-second digits are generated for each
+    time stamp.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include "swoc/BufferWriter.h"
+#include "swoc/bwf_base.h"
+#include "swoc/bwf_ex.h"
+
+using namespace std::literals;
+using namespace swoc::literals;
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+namespace {
+
+/// Per thread cache of the output of a @c bwf::Date.
+struct DateCache {
+  static constexpr size_t MAX_FMT  = 64;  ///< Longest format string that is cached.
+  static constexpr size_t MAX_TEXT = 256; ///< Longest output that is cached.
+
+  time_t _epoch = 0;       ///< Time of the cached text.
+  bool _valid_p = false;   ///< Cache contains text.
+  bool _local_p = false;   ///< Text is in local time.
+  uint8_t _fmt_n = 0;      ///< Length of the format.
+  uint16_t _text_n = 0;    ///< Length of the text.
+  char _fmt[MAX_FMT];      ///< Format used for @a _text.
+  char _text[MAX_TEXT];    ///< Output text.
+};
+
+thread_local DateCache Date_Cache;
+
+/// Per thread cache of the text of a @c bwf::Timestamp for one second.
+struct TimestampCache {
+  static constexpr size_t PREFIX_N = 40; ///< Longest text up to the seconds for any style.
+  static constexpr size_t SUFFIX_N = 8;  ///< Longest text after the seconds for any style.
+
+  time_t _epoch = 0;         ///< Time of the cached text.
+  bool _valid_p = false;     ///< Cache contains text.
+  uint8_t _prefix_n = 0;     ///< Length of the text before the sub-second digits.
+  uint8_t _suffix_n = 0;     ///< Length of the text after the sub-second digits.
+  char _prefix[PREFIX_N];    ///< Text up to and including the seconds.
+  char _suffix[SUFFIX_N];    ///< Text after the seconds, such as the time zone.
+};
+
+/// Caches by style, GMT and then local time.
+thread_local TimestampCache Timestamp_Cache[3][2];
+
+constexpr char DAY_NAME[7][4]    = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+constexpr char MONTH_NAME[12][4] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+/// Broken down time, the fields needed for the fixed styles.
+struct Civil {
+  int64_t _year;
+  unsigned _month;  ///< [1, 12]
+  unsigned _day;    ///< [1, 31]
+  unsigned _wday;   ///< [0, 6], Sunday is 0.
+  unsigned _hour;
+  unsigned _min;
+  unsigned _sec;
+  long _offset = 0; ///< Seconds east of GMT.
+};
+
+/** Convert @a epoch to GMT.
+ *
+ * This is the days to civil date conversion from "chrono-Compatible Low-Level Date Algorithms"
+ * (Hinnant), which is much faster than @c gmtime_r and has no locale or time zone dependency.
+ */
+void
+to_civil(time_t epoch, Civil &c) {
+  int64_t days = epoch / 86400;
+  int64_t secs = epoch % 86400;
+  if (secs < 0) {
+    secs += 86400;
+    --days;
+  }
+  c._hour = unsigned(secs / 3600);
+  c._min  = unsigned(secs / 60 % 60);
+  c._sec  = unsigned(secs % 60);
+  int64_t wday = (days + 4) % 7; // 1970-01-01 was a Thursday.
+  c._wday      = unsigned(wday < 0 ? wday + 7 : wday);
+
+  int64_t z      = days + 719468;
+  int64_t era    = (z >= 0 ? z : z - 146096) / 146097;
+  unsigned doe   = unsigned(z - era * 146097);                          // [0, 146096]
+  unsigned yoe   = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+  unsigned doy   = doe - (365 * yoe + yoe / 4 - yoe / 100);             // [0, 365]
+  unsigned mp    = (5 * doy + 2) / 153;                                 // [0, 11], March is 0.
+  c._day         = doy - (153 * mp + 2) / 5 + 1;
+  c._month       = mp < 10 ? mp + 3 : mp - 9;
+  c._year        = int64_t(yoe) + era * 400 + (c._month <= 2);
+}
+
+/// Convert @a epoch to local time, or to GMT if it can not be converted.
+void
+to_local(time_t epoch, Civil &c) {
+  struct tm t;
+  if (nullptr == localtime_r(&epoch, &t)) { // out of range for @c tm.
+    to_civil(epoch, c);
+    return;
+  }
+  c._year   = int64_t(t.tm_year) + 1900;
+  c._month  = t.tm_mon + 1;
+  c._day    = t.tm_mday;
+  c._wday   = t.tm_wday;
+  c._hour   = t.tm_hour;
+  c._min    = t.tm_min;
+  c._sec    = t.tm_sec;
+  c._offset = t.tm_gmtoff;
+}
+
+/// Write @a n as exactly @a width decimal digits to @a out. @return The end of the output.
+char *
+put_digits(char *out, uint64_t n, unsigned width) {
+  for (char *spot = out + width; spot > out;) {
+    *--spot = char('0' + n % 10);
+    n /= 10;
+  }
+  return out + width;
+}
+
+/// Write the year @a y to @a out, at least 4 digits. @return The end of the output.
+char *
+put_year(char *out, int64_t y) {
+  if (y < 0) {
+    *out++ = '-';
+    y      = -y;
+  }
+  unsigned width = 4;
+  for (int64_t n = y / 10000; n; n /= 10) {
+    ++width;
+  }
+  return put_digits(out, uint64_t(y), width);
+}
+
+/// Write the time zone offset @a offset as "+hhmm", with @a sep between the hours and minutes.
+char *
+put_offset(char *out, long offset, char sep) {
+  *out++ = offset < 0 ? '-' : '+';
+  unsigned n = unsigned(offset < 0 ? -offset : offset) / 60;
+  out        = put_digits(out, n / 60, 2);
+  if (sep) {
+    *out++ = sep;
+  }
+  return put_digits(out, n % 60, 2);
+}
+
+/// Fill @a cache with the text for @a epoch in @a style.
+void
+render(TimestampCache &cache, time_t epoch, bwf::Timestamp::Style style, bool local_p) {
+  Civil c;
+  if (local_p && style != bwf::Timestamp::HTTP) {
+    to_local(epoch, c);
+  } else {
+    to_civil(epoch, c);
+  }
+
+  char *out    = cache._prefix;
+  char *suffix = cache._suffix;
+  switch (style) {
+  case bwf::Timestamp::ISO8601:
+    out    = put_year(out, c._year);
+    *out++ = '-';
+    out    = put_digits(out, c._month, 2);
+    *out++ = '-';
+    out    = put_digits(out, c._day, 2);
+    *out++ = 'T';
+    out    = put_digits(out, c._hour, 2);
+    *out++ = ':';
+    out    = put_digits(out, c._min, 2);
+    *out++ = ':';
+    out    = put_digits(out, c._sec, 2);
+    if (local_p) {
+      suffix = put_offset(suffix, c._offset, ':');
+    } else {
+      *suffix++ = 'Z';
+    }
+    break;
+  case bwf::Timestamp::HTTP:
+    memcpy(out, DAY_NAME[c._wday], 3);
+    out += 3;
+    *out++ = ',';
+    *out++ = ' ';
+    out    = put_digits(out, c._day, 2);
+    *out++ = ' ';
+    memcpy(out, MONTH_NAME[c._month - 1], 3);
+    out += 3;
+    *out++ = ' ';
+    out    = put_year(out, c._year);
+    *out++ = ' ';
+    out    = put_digits(out, c._hour, 2);
+    *out++ = ':';
+    out    = put_digits(out, c._min, 2);
+    *out++ = ':';
+    out    = put_digits(out, c._sec, 2);
+    memcpy(suffix, " GMT", 4);
+    suffix += 4;
+    break;
+  case bwf::Timestamp::CLF:
+    out    = put_digits(out, c._day, 2);
+    *out++ = '/';
+    memcpy(out, MONTH_NAME[c._month - 1], 3);
+    out += 3;
+    *out++ = '/';
+    out    = put_year(out, c._year);
+    *out++ = ':';
+    out    = put_digits(out, c._hour, 2);
+    *out++ = ':';
+    out    = put_digits(out, c._min, 2);
+    *out++ = ':';
+    out    = put_digits(out, c._sec, 2);
+    *suffix++ = ' ';
+    suffix    = put_offset(suffix, c._offset, 0);
+    break;
+  }
+  cache._prefix_n = uint8_t(out - cache._prefix);
+  cache._suffix_n = uint8_t(suffix - cache._suffix);
+  cache._epoch    = epoch;
+  cache._valid_p  = true;
+}
+
+} // namespace
+
+bwf::Date::Date(std::string_view fmt)
+    : _epoch(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())), _fmt(fmt) {}
+
+bwf::Timestamp::Timestamp(std::chrono::system_clock::time_point t, Style style) : _style(style) {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+  auto s  = ns / 1000000000;
+  ns %= 1000000000;
+  if (ns < 0) {
+    ns += 1000000000;
+    --s;
+  }
+  _epoch = time_t(s);
+  _nsec  = uint32_t(ns);
+}
+
+bwf::Timestamp::Timestamp(Style style) : Timestamp(std::chrono::system_clock::now(), style) {}
+
+BufferWriter&
+bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Date const& date) {
+  if (spec.has_numeric_type()) {
+    return bwformat(w, spec, date._epoch);
+  }
+
+  // Verify @a fmt is null terminated, even outside the bounds of the view.
+  if (date._fmt.data()[date._fmt.size() - 1] != 0 && date._fmt.data()[date._fmt.size()] != 0) {
+    throw (std::invalid_argument{"BWF Date String is not null terminated."});
+  }
+  bool local_p = spec._ext == "local"sv;
+  auto &cache  = Date_Cache;
+  if (cache._valid_p && cache._epoch == date._epoch && cache._local_p == local_p && cache._fmt_n == date._fmt.size() &&
+      0 == memcmp(cache._fmt, date._fmt.data(), cache._fmt_n)) {
+    return w.write(cache._text, cache._text_n);
+  }
+
+  // Get the time, GMT or local if specified.
+  struct tm t;
+  if (!local_p || nullptr == localtime_r(&date._epoch, &t)) {
+    if (nullptr == gmtime_r(&date._epoch, &t)) {
+      return w; // out of range for @c tm, nothing to format.
+    }
+  }
+  size_t n = strftime(cache._text, sizeof(cache._text), date._fmt.data(), &t);
+  if (n > 0) {
+    if (date._fmt.size() <= sizeof(cache._fmt)) {
+      cache._epoch   = date._epoch;
+      cache._local_p = local_p;
+      cache._fmt_n   = uint8_t(date._fmt.size());
+      cache._text_n  = uint16_t(n);
+      memcpy(cache._fmt, date._fmt.data(), cache._fmt_n);
+      cache._valid_p = true;
+    } else {
+      cache._valid_p = false;
+    }
+    w.write(cache._text, n);
+  } else {
+    // Too long to cache, or no output. Try a direct write, as the output may still fit in @a w.
+    cache._valid_p = false;
+    auto r         = w.remaining();
+    if (r > 0 && (n = strftime(w.aux_data(), r, date._fmt.data(), &t)) > 0) {
+      w.commit(n);
+    }
+  }
+  return w;
+}
+
+BufferWriter&
+bwformat(BufferWriter& w, bwf::Spec const& spec, bwf::Timestamp const& ts) {
+  if (spec.has_numeric_type()) {
+    return bwformat(w, spec, ts._epoch);
+  }
+
+  bool local_p = spec._ext == "local"sv;
+  auto &cache  = Timestamp_Cache[ts._style][local_p];
+  if (!cache._valid_p || cache._epoch != ts._epoch) {
+    render(cache, ts._epoch, ts._style, local_p);
+  }
+
+  // Assemble locally so there is only one write to @a w. The cached text is copied as whole
+  // arrays, as fixed size copies are much faster than variable size ones for short text.
+  char buff[TimestampCache::PREFIX_N + 10 + TimestampCache::SUFFIX_N];
+  char *out = buff;
+  memcpy(out, cache._prefix, sizeof(cache._prefix));
+  out += cache._prefix_n;
+  if (spec._prec > 0) {
+    static constexpr uint32_t SCALE[] = {1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
+    unsigned digits = std::min(spec._prec, 9);
+    *out++          = '.';
+    out             = put_digits(out, ts._nsec / SCALE[digits], digits);
+  }
+  memcpy(out, cache._suffix, sizeof(cache._suffix));
+  out += cache._suffix_n;
+  return w.write(buff, out - buff);
+}
+
+}} // namespace swoc
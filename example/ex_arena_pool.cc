@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Per request arena cycles with and without a block pool.
+
+    Each cycle creates an arena, makes a number of small allocations, and then clears the arena,
+    which is the pattern of an arena per request or transaction. This is done with blocks from the
+    system allocator and with blocks from a pool.
+
+    Arguments are the number of cycles and the number of bytes allocated per cycle.
+
+    ex_arena_pool 1000000 20000
+*/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "swoc/TextView.h"
+#include "swoc/MemArena.h"
+
+using swoc::MemArena;
+
+int
+main(int argc, char *argv[]) {
+  unsigned n_cycles = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 1000000;
+  unsigned n_bytes  = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 20000;
+
+  std::vector<unsigned> sizes;
+  std::minstd_rand rng(17);
+  for (unsigned total = 0; total < n_bytes;) {
+    sizes.push_back(16 + rng() % 240);
+    total += sizes.back();
+  }
+
+  auto cycle = [&](MemArena::BlockPool *pool) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned k = 0; k < n_cycles; ++k) {
+      MemArena arena{4000, pool};
+      for (auto n : sizes) {
+        arena.alloc(n);
+      }
+    }
+    auto delta = std::chrono::steady_clock::now() - t0;
+    return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / n_cycles;
+  };
+
+  std::cout << sizes.size() << " allocations, " << n_bytes << " bytes per cycle" << std::endl;
+  std::cout << "malloc: " << cycle(nullptr) << " ns / cycle" << std::endl;
+  MemArena::BlockPool pool;
+  std::cout << "pool:   " << cycle(&pool) << " ns / cycle" << std::endl;
+  auto stats = pool.stats();
+  std::cout << "pool hits " << stats._hits << " misses " << stats._misses << " returns " << stats._returns << " drops "
+            << stats._drops << " blocks " << stats._blocks << " bytes " << stats._bytes << std::endl;
+
+  return 0;
+}
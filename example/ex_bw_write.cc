@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of @c BufferWriter output.
+
+    Output typical of access log formatting is written to a @c LocalBufferWriter and an
+    @c ArenaWriter - single characters, short strings, aligned and filled numbers, IP addresses, and
+    a complete log line. Writers are used through a @c BufferWriter reference, as formatters do.
+
+    The argument is the number of times each output is done.
+
+    ex_bw_write 1000000
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+#include "swoc/ArenaWriter.h"
+#include "swoc/BufferWriter.h"
+#include "swoc/bwf_base.h"
+#include "swoc/bwf_ip.h"
+
+using namespace std::literals;
+
+namespace {
+/// Nanoseconds per call of @a f on @a w, @a n times.
+template <typename F>
+double
+run(swoc::BufferWriter& w, unsigned n, F&& f) {
+  size_t sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    w.discard(w.extent());
+    f(w, i);
+    sum += w.size();
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / n;
+}
+
+constexpr char LOG_FMT[] = "{} {:>6} {} {}/{} {} {} - {}";
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 1000000;
+
+  swoc::IPAddr addr4{"172.16.43.2"};
+  swoc::IPAddr addr6{"2001:db8:85a3::8a2e:370:7334"};
+  static constexpr std::string_view URL{"http://www.example.com/path/to/resource"};
+
+  auto chars = [](swoc::BufferWriter& w, unsigned) {
+    for (char c : URL) {
+      w.write(c);
+    }
+  };
+  auto strings = [](swoc::BufferWriter& w, unsigned) {
+    for (int k = 0; k < 8; ++k) {
+      w.write("GET "sv);
+    }
+  };
+  auto numbers = [](swoc::BufferWriter& w, unsigned i) { w.print("{:>10} {:<8} {:#x} {:08}", i, i % 1000, i, i * 7); };
+  auto ip      = [&](swoc::BufferWriter& w, unsigned) { w.print("{} {}", addr4, addr6); };
+  auto log     = [&](swoc::BufferWriter& w, unsigned i) {
+    w.print<LOG_FMT>(1600000000 + i, i % 1000, addr4, "TCP_MISS", 200, 1024 + i, "GET", URL);
+  };
+
+  swoc::LocalBufferWriter<512> lw;
+  swoc::MemArena arena;
+  swoc::ArenaWriter aw{arena};
+
+  std::cout << "ns per output  LocalBufferWriter  ArenaWriter" << std::endl;
+  std::cout << "chars (39)     " << run(lw, n, chars) << "  " << run(aw, n, chars) << std::endl;
+  std::cout << "strings (8)    " << run(lw, n, strings) << "  " << run(aw, n, strings) << std::endl;
+  std::cout << "numbers        " << run(lw, n, numbers) << "  " << run(aw, n, numbers) << std::endl;
+  std::cout << "ip addresses   " << run(lw, n, ip) << "  " << run(aw, n, ip) << std::endl;
+  std::cout << "log line       " << run(lw, n, log) << "  " << run(aw, n, log) << std::endl;
+  return 0;
+}
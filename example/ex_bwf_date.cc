@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of time stamp formatting.
+
+    Time stamps are formatted as they would be for log lines, many per second, with @c bwf::Date,
+    @c bwf::Timestamp, and for comparison @c gmtime_r and @c strftime on every time stamp.
+
+    The argument is the number of time stamps.
+
+    ex_bwf_date 1000000
+*/
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <string_view>
+
+#include "swoc/BufferWriter.h"
+#include "swoc/bwf_ex.h"
+
+namespace {
+/// Nanoseconds per time stamp to format @a n time stamps with @a f.
+template <typename F>
+double
+run(unsigned n, F&& f) {
+  swoc::LocalBufferWriter<256> w;
+  size_t sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  auto start = std::chrono::system_clock::from_time_t(1528484137);
+  for (unsigned i = 0; i < n; ++i) {
+    f(w.clear(), start + std::chrono::microseconds(i * 2)); // 500k per second.
+    sum += w.size();
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / n;
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  using swoc::bwf::Date;
+  using swoc::bwf::Timestamp;
+  using tp = std::chrono::system_clock::time_point;
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 1000000;
+
+  std::cout << "ns per time stamp" << std::endl;
+  std::cout << "  strftime         " << run(n, [](swoc::BufferWriter& w, tp t) {
+    time_t epoch = std::chrono::system_clock::to_time_t(t);
+    struct tm tm;
+    gmtime_r(&epoch, &tm);
+    w.commit(strftime(w.aux_data(), w.remaining(), "%d/%b/%Y:%H:%M:%S +0000", &tm));
+  }) << std::endl;
+  std::cout << "  Date             " << run(n, [](swoc::BufferWriter& w, tp t) {
+    w.print("{}", Date(std::chrono::system_clock::to_time_t(t), "%d/%b/%Y:%H:%M:%S +0000"));
+  }) << std::endl;
+  std::cout << "  Timestamp CLF    " << run(n, [](swoc::BufferWriter& w, tp t) {
+    w.print("{}", Timestamp(t, Timestamp::CLF));
+  }) << std::endl;
+  std::cout << "  Timestamp ISO.3  " << run(n, [](swoc::BufferWriter& w, tp t) {
+    w.print("{:.3}", Timestamp(t));
+  }) << std::endl;
+  static constexpr char ISO_FMT[] = "{:.3}";
+  std::cout << "  static ISO.3     " << run(n, [](swoc::BufferWriter& w, tp t) {
+    w.print<ISO_FMT>(Timestamp(t));
+  }) << std::endl;
+  return 0;
+}
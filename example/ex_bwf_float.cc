@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of floating point formatting.
+
+    Doubles are formatted with the default format, the shortest round trip formats, and formats with
+    a precision, and for comparison with @c snprintf. Values are in a typical range for measurements,
+    [0.001, 100000), and across the full range of doubles.
+
+    The argument is the number of values.
+
+    ex_bwf_float 1000000
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "swoc/BufferWriter.h"
+#include "swoc/bwf_base.h"
+
+namespace {
+/// Nanoseconds per value to format @a values with @a f.
+template <typename F>
+double
+run(std::vector<double> const& values, F&& f) {
+  size_t sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  for (double v : values) {
+    sum += f(v);
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / values.size();
+}
+
+/// Report the time for each format on @a values, including the default format if @a default_p.
+void
+report(char const *title, std::vector<double> const& values, bool default_p) {
+  swoc::LocalBufferWriter<2048> lw;
+  swoc::BufferWriter& w = lw;
+  char buff[2048];
+
+  auto bwf = [&](swoc::bwf::Format const& fmt) {
+    return run(values, [&](double v) { return w.discard(w.extent()).print(fmt, v).size(); });
+  };
+  auto c_fmt = [&](char const *fmt) {
+    return run(values, [&](double v) { return size_t(snprintf(buff, sizeof(buff), fmt, v)); });
+  };
+
+  std::cout << title << std::endl;
+  if (default_p) {
+    std::cout << "  {}      " << bwf(swoc::bwf::Format{"{}"}) << std::endl;
+  }
+  std::cout << "  {:e}    " << bwf(swoc::bwf::Format{"{:e}"}) << "  %.17g " << c_fmt("%.17g") << std::endl;
+  std::cout << "  {:f}    " << bwf(swoc::bwf::Format{"{:f}"}) << "  %g    " << c_fmt("%g") << std::endl;
+  std::cout << "  {:.3f}  " << bwf(swoc::bwf::Format{"{:.3f}"}) << "  %.3f  " << c_fmt("%.3f") << std::endl;
+  std::cout << "  {:.6e}  " << bwf(swoc::bwf::Format{"{:.6e}"}) << "  %.6e  " << c_fmt("%.6e") << std::endl;
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 1000000;
+  std::mt19937_64 rng(1);
+  std::vector<double> typical;
+  std::vector<double> full;
+  std::uniform_real_distribution<double> exponent(-3, 5);
+  while (typical.size() < n) {
+    typical.push_back(std::pow(10.0, exponent(rng)));
+  }
+  while (full.size() < n) {
+    uint64_t bits = rng() & 0x7FEFFFFFFFFFFFFFULL; // finite, non-negative
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    full.push_back(v);
+  }
+
+  std::cout << "ns per value" << std::endl;
+  report("[0.001, 100000)", typical, true);
+  // The default format only works for values less than 2^64.
+  report("all doubles", full, false);
+  return 0;
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of integer formatting.
+
+    Integers of various sizes are formatted with @c bwformat and, for comparison, @c snprintf.
+    Sixteen values are formatted per output.
+
+    The argument is the number of outputs.
+
+    ex_bwf_integer 1000000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string_view>
+
+#include "swoc/BufferWriter.h"
+#include "swoc/bwf_base.h"
+
+namespace {
+/// Nanoseconds per value of @a f on @a w, @a n times.
+template <typename F>
+double
+run(swoc::BufferWriter& w, unsigned n, F&& f) {
+  size_t sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    w.discard(w.extent());
+    for (unsigned k = 0; k < 16; ++k) {
+      f(w, i * 16 + k);
+    }
+    sum += w.size();
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / (n * 16);
+}
+
+/// Nanoseconds per value of @c snprintf with @a fmt of @a f, @a n times.
+template <typename F>
+double
+run_printf(unsigned n, char const *fmt, F&& f) {
+  char buff[512];
+  size_t sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    size_t used = 0;
+    for (unsigned k = 0; k < 16; ++k) {
+      used += snprintf(buff + used, sizeof(buff) - used, fmt, f(i * 16 + k));
+    }
+    sum += used;
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) {
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / (n * 16);
+}
+
+// Values of different sizes.
+unsigned small(unsigned i) { return i % 1000; }
+unsigned word(unsigned i) { return i * 2654435761U; }
+unsigned long long wide(unsigned i) { return i * 0x9E3779B97F4A7C15ULL; }
+int negative(unsigned i) { return -int(i % 100000); }
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 1000000;
+  swoc::LocalBufferWriter<512> lw;
+  swoc::BufferWriter& w = lw;
+
+  swoc::bwf::Spec dec;
+  swoc::bwf::Spec hex;
+  hex._type         = 'x';
+  hex._radix_lead_p = true;
+  swoc::bwf::Spec right;
+  right._align = swoc::bwf::Spec::Align::RIGHT;
+  right._min   = 12;
+
+  std::cout << "ns per value      bwformat  snprintf" << std::endl;
+  std::cout << "small (<1000)     " << run(w, n, [&](auto& w, unsigned i) { bwformat(w, dec, small(i)); }) << "  "
+            << run_printf(n, "%u", small) << std::endl;
+  std::cout << "32 bit            " << run(w, n, [&](auto& w, unsigned i) { bwformat(w, dec, word(i)); }) << "  "
+            << run_printf(n, "%u", word) << std::endl;
+  std::cout << "64 bit            " << run(w, n, [&](auto& w, unsigned i) { bwformat(w, dec, wide(i)); }) << "  "
+            << run_printf(n, "%llu", wide) << std::endl;
+  std::cout << "negative          " << run(w, n, [&](auto& w, unsigned i) { bwformat(w, dec, negative(i)); }) << "  "
+            << run_printf(n, "%d", negative) << std::endl;
+  std::cout << "64 bit hex        " << run(w, n, [&](auto& w, unsigned i) { bwformat(w, hex, wide(i)); }) << "  "
+            << run_printf(n, "%#llx", wide) << std::endl;
+  std::cout << "32 bit width 12   " << run(w, n, [&](auto& w, unsigned i) { bwformat(w, right, word(i)); }) << "  "
+            << run_printf(n, "%12u", word) << std::endl;
+  return 0;
+}
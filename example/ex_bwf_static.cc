@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of formatted output with static format strings.
+
+    Each format is printed with a format string parsed on every call (@c print), a pre-parsed
+    @c bwf::Format, a pre-parsed format with the arguments in a tuple (@c print_v), a format string
+    parsed at compile time (@c print<F>), and @c snprintf.
+
+    The argument is the number of times each format is printed.
+
+    ex_bwf_static 1000000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string_view>
+
+#include "swoc/BufferWriter.h"
+#include "swoc/bwf_base.h"
+
+using namespace std::literals;
+
+namespace {
+/// Nanoseconds per call of @a f, @a n times.
+template <typename F>
+double
+run(unsigned n, F&& f) {
+  swoc::LocalBufferWriter<256> w;
+  size_t sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    f(w.clear(), i);
+    sum += w.size();
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / n;
+}
+
+constexpr char HEX_FMT[] = "Format |{:#010x}| '{}'";
+constexpr char LOG_FMT[] = "{} {:>6} {}/{} {} {} - {}";
+constexpr char LITERAL_FMT[] = "Nothing to see here";
+
+constexpr std::string_view TEXT{"e99a18c428cb38d5f260853678922e03"};
+constexpr std::string_view URL{"http://www.example.com/path/to/resource"};
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 1000000;
+
+  static const swoc::bwf::Format hex_fmt{HEX_FMT};
+  static const swoc::bwf::Format log_fmt{LOG_FMT};
+  static const swoc::bwf::Format literal_fmt{LITERAL_FMT};
+
+  std::cout << "ns per print   print  Format  print_v  static  snprintf" << std::endl;
+
+  std::cout << "hex           " << run(n, [](auto& w, unsigned i) { w.print(HEX_FMT, -956 - int(i & 0xFF), TEXT); }) << "  "
+            << run(n, [](auto& w, unsigned i) { w.print(hex_fmt, -956 - int(i & 0xFF), TEXT); }) << "  "
+            << run(n, [](auto& w, unsigned i) { w.print_v(hex_fmt, std::make_tuple(-956 - int(i & 0xFF), TEXT)); }) << "  "
+            << run(n, [](auto& w, unsigned i) { w.template print<HEX_FMT>(-956 - int(i & 0xFF), TEXT); }) << "  "
+            << run(n,
+                   [](auto& w, unsigned i) {
+                     w.commit(snprintf(w.aux_data(), w.remaining(), "Format |%#010x| '%.*s'", -956 - int(i & 0xFF),
+                                       int(TEXT.size()), TEXT.data()));
+                   })
+            << std::endl;
+
+  std::cout << "log line      "
+            << run(n, [](auto& w, unsigned i) { w.print(LOG_FMT, 1600000000 + i, i % 1000, "TCP_MISS", 200, 1024 + i, "GET", URL); })
+            << "  "
+            << run(n, [](auto& w, unsigned i) { w.print(log_fmt, 1600000000 + i, i % 1000, "TCP_MISS", 200, 1024 + i, "GET", URL); })
+            << "  "
+            << run(n,
+                   [](auto& w, unsigned i) {
+                     w.print_v(log_fmt, std::make_tuple(1600000000 + i, i % 1000, "TCP_MISS", 200, 1024 + i, "GET", URL));
+                   })
+            << "  "
+            << run(n, [](auto& w, unsigned i) { w.template print<LOG_FMT>(1600000000 + i, i % 1000, "TCP_MISS", 200, 1024 + i, "GET", URL); })
+            << "  "
+            << run(n,
+                   [](auto& w, unsigned i) {
+                     w.commit(snprintf(w.aux_data(), w.remaining(), "%u %6u %s/%d %u %s - %.*s", 1600000000 + i, i % 1000, "TCP_MISS",
+                                       200, 1024 + i, "GET", int(URL.size()), URL.data()));
+                   })
+            << std::endl;
+
+  std::cout << "literal       " << run(n, [](auto& w, unsigned) { w.print(LITERAL_FMT); }) << "  "
+            << run(n, [](auto& w, unsigned) { w.print(literal_fmt); }) << "  "
+            << run(n, [](auto& w, unsigned) { w.print_v(literal_fmt, std::make_tuple()); }) << "  "
+            << run(n, [](auto& w, unsigned) { w.template print<LITERAL_FMT>(); }) << "  "
+            << run(n, [](auto& w, unsigned) { w.commit(snprintf(w.aux_data(), w.remaining(), "Nothing to see here")); }) << std::endl;
+  return 0;
+}
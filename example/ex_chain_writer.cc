@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of building large output with @c ArenaWriter and @c ChainWriter.
+
+    A stats page is built in an arena and written to /dev/null with @c writev. @c ArenaWriter
+    output is one contiguous buffer, which is copied every time it grows. @c ChainWriter output
+    is a list of segments which are handed to @c writev as is.
+
+    The arguments are the page size in KB and the number of pages.
+
+    ex_chain_writer 512 200
+*/
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+#include "swoc/ArenaWriter.h"
+#include "swoc/ChainWriter.h"
+#include "swoc/bwf_base.h"
+
+using namespace std::literals;
+
+namespace {
+/// Write @a n bytes of stats to @a w.
+void
+stats_page(swoc::BufferWriter& w, size_t n) {
+  for (unsigned i = 0; w.extent() < n; ++i) {
+    w.print("proxy.process.http.{}.{:<24} {:>12}\n", i % 97, "completed_requests"sv, i * 7919);
+  }
+}
+
+/// Write all of @a iov to @a fd.
+void
+write_out(int fd, iovec const *iov, size_t n) {
+  while (n > 0) {
+    auto k = std::min<size_t>(n, IOV_MAX);
+    if (::writev(fd, iov, k) < 0) {
+      break;
+    }
+    iov += k;
+    n   -= k;
+  }
+}
+
+/// Microseconds per page for @a f, @a n times.
+template <typename F>
+double
+run(unsigned n, F&& f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    f();
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  return double(std::chrono::duration_cast<std::chrono::microseconds>(delta).count()) / n;
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  size_t size = 1024 * (argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 512);
+  unsigned n  = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 200;
+  int fd      = ::open("/dev/null", O_WRONLY);
+  size_t segments = 0;
+
+  auto arena_page = [&]() {
+    swoc::MemArena arena;
+    swoc::ArenaWriter w{arena};
+    stats_page(w, size);
+    auto span = arena.alloc(w.size());
+    iovec iov{span.data(), span.size()};
+    write_out(fd, &iov, 1);
+  };
+
+  auto chain_page = [&]() {
+    swoc::MemArena arena;
+    swoc::ChainWriter w{arena};
+    stats_page(w, size);
+    auto chain = w.iovecs();
+    segments   = chain.count();
+    write_out(fd, chain.data(), chain.count());
+  };
+
+  std::cout << "us per " << size / 1024 << "KB page" << std::endl;
+  std::cout << "ArenaWriter  " << run(n, arena_page) << std::endl;
+  std::cout << "ChainWriter  " << run(n, chain_page) << " (" << segments << " segments)" << std::endl;
+  ::close(fd);
+  return 0;
+}
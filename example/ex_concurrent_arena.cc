@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Allocation contention across threads.
+
+    Each thread makes small allocations from a shared arena in rounds, with the arena thawed and
+    frozen between rounds to reuse memory. This is done with a @c MemArena protected by a mutex, with a
+    @c ConcurrentMemArena, and with a @c MemArena per thread as a lower bound.
+
+    Arguments are the maximum number of threads and the number of allocations per thread.
+
+    ex_concurrent_arena 8 2000000
+*/
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "swoc/TextView.h"
+#include "swoc/MemArena.h"
+#include "swoc/ConcurrentMemArena.h"
+
+using swoc::MemArena;
+using swoc::ConcurrentMemArena;
+
+/// Number of allocations between arena generations.
+static constexpr unsigned GENERATION = 1 << 16;
+
+/** Run @a n_threads threads in rounds.
+ *
+ * @param n_threads Number of threads.
+ * @param n_rounds Number of rounds.
+ * @param f Called by each thread in each round to make one generation of allocations.
+ * @param g Called between rounds, when no thread is allocating.
+ * @return Nanoseconds per allocation across all threads.
+ */
+template <typename F, typename G>
+double
+run(unsigned n_threads, unsigned n_rounds, F&& f, G&& g) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned round = 0; round < n_rounds; ++round) {
+    std::vector<std::thread> threads;
+    for (unsigned idx = 0; idx < n_threads; ++idx) {
+      threads.emplace_back(f, idx);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    g();
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / (double(n_threads) * n_rounds * GENERATION);
+}
+
+int
+main(int argc, char *argv[]) {
+  unsigned max_threads = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : std::thread::hardware_concurrency();
+  unsigned n_allocs    = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 2000000;
+  max_threads          = std::max(max_threads, 1U);
+  unsigned n_rounds    = std::max(n_allocs / GENERATION, 1U);
+
+  // Allocation sizes, the same for every thread and arena.
+  std::vector<unsigned> sizes(GENERATION);
+  std::minstd_rand rng(17);
+  for (auto& n : sizes) {
+    n = 16 + rng() % 112;
+  }
+
+  std::cout << "ns / allocation" << std::endl << "threads\tmutex\tconcurrent\tper thread" << std::endl;
+  for (unsigned n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+    MemArena locked_arena;
+    std::mutex mutex;
+    auto locked = run(
+      n_threads, n_rounds,
+      [&](unsigned) {
+        for (auto n : sizes) {
+          std::lock_guard lock(mutex);
+          locked_arena.alloc(n);
+        }
+      },
+      [&]() { locked_arena.thaw().freeze(); });
+
+    ConcurrentMemArena shared_arena;
+    auto concurrent = run(
+      n_threads, n_rounds,
+      [&](unsigned) {
+        for (auto n : sizes) {
+          shared_arena.alloc(n);
+        }
+      },
+      [&]() { shared_arena.thaw().freeze(); });
+
+    std::vector<MemArena> arenas(n_threads);
+    auto local = run(
+      n_threads, n_rounds,
+      [&](unsigned idx) {
+        for (auto n : sizes) {
+          arenas[idx].alloc(n);
+        }
+      },
+      [&]() {
+        for (auto& arena : arenas) {
+          arena.thaw().freeze();
+        }
+      });
+
+    std::cout << n_threads << "\t" << locked << "\t" << concurrent << "\t" << local << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Insert latency of @c IntrusiveHashMap while the table grows.
+
+    Elements are inserted in to an empty map and the time for each insert is recorded. This is done
+    with the @c AVERAGE expansion policy, which moves every element when the table expands, and with
+    the @c INCREMENTAL policy which moves a few buckets on each operation. The latency percentiles
+    show the cost of expansion.
+
+    Arguments are the number of elements and the number of runs.
+
+    ex_hashmap_latency 1000000 3
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "swoc/TextView.h"
+#include "swoc/IntrusiveHashMap.h"
+
+struct Thing {
+  unsigned _key;
+  Thing *_next = nullptr;
+  Thing *_prev = nullptr;
+};
+
+struct Descriptor {
+  static Thing *&
+  next_ptr(Thing *thing) {
+    return thing->_next;
+  }
+  static Thing *&
+  prev_ptr(Thing *thing) {
+    return thing->_prev;
+  }
+  static unsigned
+  key_of(Thing *thing) {
+    return thing->_key;
+  }
+  static size_t
+  hash_of(unsigned key) {
+    return key * 0x9E3779B97F4A7C15ULL;
+  }
+  static bool
+  equal(unsigned lhs, unsigned rhs) {
+    return lhs == rhs;
+  }
+};
+
+using Map = swoc::IntrusiveHashMap<Descriptor>;
+
+/// Insert @a things in to a map with @a policy and return the nanoseconds for each insert.
+std::vector<uint64_t>
+run(std::vector<Thing>& things, Map::ExpansionPolicy policy) {
+  std::vector<uint64_t> times;
+  times.reserve(things.size());
+  Map map;
+  map.set_expansion_policy(policy);
+  for (auto& thing : things) {
+    auto t0 = std::chrono::steady_clock::now();
+    map.insert(&thing);
+    auto t1 = std::chrono::steady_clock::now();
+    times.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+  }
+  map.clear();
+  return times;
+}
+
+int
+main(int argc, char *argv[]) {
+  unsigned n      = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 1000000;
+  unsigned n_runs = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 3;
+  n               = std::max(n, 1000U);
+
+  std::vector<Thing> things(n);
+  for (unsigned idx = 0; idx < n; ++idx) {
+    things[idx]._key = idx;
+  }
+
+  std::cout << n << " inserts, ns per insert" << std::endl
+            << "policy\ttotal ms\tmean\tp50\tp99\tp999\tmax" << std::endl;
+  for (unsigned r = 0; r < n_runs; ++r) {
+    for (auto [name, policy] : {std::make_pair("average", Map::AVERAGE), std::make_pair("incremental", Map::INCREMENTAL)}) {
+      auto times     = run(things, policy);
+      uint64_t total = 0;
+      for (auto t : times) {
+        total += t;
+      }
+      std::sort(times.begin(), times.end());
+      auto pct = [&](double p) { return times[std::min(times.size() - 1, size_t(p * times.size()))]; };
+      std::cout << name << "\t" << total / 1000000 << "\t" << total / times.size() << "\t" << pct(0.5) << "\t" << pct(0.99)
+                << "\t" << pct(0.999) << "\t" << times.back() << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Lookup rate of @c IntrusiveHashMap for the bucket mappings, and of @c FlatHashMap.
+
+    Maps are filled with random string keys, as in the @c IntrusiveHashMap unit tests, and with
+    integer keys with a cheap hash, as for session tables. Each is looked up with the default
+    @c PRIME bucket mapping, the @c POWER_OF_2 mapping, and in a @c FlatHashMap with the same
+    descriptor.
+
+    Arguments are the number of elements and the number of lookups.
+
+    ex_hashmap_lookup 100000 20000000
+*/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "swoc/TextView.h"
+#include "swoc/IntrusiveHashMap.h"
+#include "swoc/FlatHashMap.h"
+
+using swoc::IntrusiveHashMapping;
+
+template <typename K> struct Thing {
+  K _key;
+  int _n = 0;
+  Thing *_next = nullptr;
+  Thing *_prev = nullptr;
+};
+
+template <typename K, typename HASH, IntrusiveHashMapping M> struct Descriptor {
+  static constexpr IntrusiveHashMapping BUCKET_MAPPING = M;
+  static Thing<K> *&
+  next_ptr(Thing<K> *thing) {
+    return thing->_next;
+  }
+  static Thing<K> *&
+  prev_ptr(Thing<K> *thing) {
+    return thing->_prev;
+  }
+  static K
+  key_of(Thing<K> *thing) {
+    return thing->_key;
+  }
+  static size_t
+  hash_of(K key) {
+    return HASH{}(key);
+  }
+  static bool
+  equal(K lhs, K rhs) {
+    return lhs == rhs;
+  }
+};
+
+/// Lookups per second for @a keys in a map of @a things.
+template <typename MAP, typename K>
+double
+run(std::vector<Thing<K>>& things, std::vector<K> const& keys) {
+  MAP map;
+  for (auto& thing : things) {
+    map.insert(&thing);
+  }
+  int sum = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto const& key : keys) {
+    if (auto spot = map.find(key); spot != map.end()) {
+      sum += spot->_n;
+    }
+  }
+  auto delta = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  map.clear();
+  if (sum == -1) { // prevent optimizing out the lookups.
+    std::cout << sum;
+  }
+  return keys.size() / delta;
+}
+
+template <typename K, typename HASH>
+void
+compare(char const *name, std::vector<Thing<K>>& things, std::vector<K> const& keys) {
+  using Prime = Descriptor<K, HASH, IntrusiveHashMapping::PRIME>;
+  using Pow2  = Descriptor<K, HASH, IntrusiveHashMapping::POWER_OF_2>;
+  auto prime  = run<swoc::IntrusiveHashMap<Prime>>(things, keys);
+  auto pow2   = run<swoc::IntrusiveHashMap<Pow2>>(things, keys);
+  auto flat   = run<swoc::FlatHashMap<Prime>>(things, keys);
+  std::cout << name << "\t" << prime / 1e6 << "\t" << pow2 / 1e6 << "\t" << flat / 1e6 << std::endl;
+}
+
+/// Cheap hash for integer keys.
+struct IntHash {
+  size_t
+  operator()(unsigned key) const {
+    return key;
+  }
+};
+
+int
+main(int argc, char *argv[]) {
+  unsigned n         = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 100000;
+  unsigned n_lookups = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 20000000;
+  n                  = std::max(n, 1U);
+
+  std::minstd_rand rng(13);
+  std::uniform_int_distribution<short> char_gen{'a', 'z'};
+  std::uniform_int_distribution<short> length_gen{20, 40};
+
+  std::vector<std::string> strings(n);
+  for (auto& s : strings) {
+    s.resize(length_gen(rng));
+    for (auto& c : s) {
+      c = char_gen(rng);
+    }
+  }
+
+  std::vector<Thing<std::string_view>> str_things(n);
+  std::vector<Thing<unsigned>> int_things(n);
+  for (unsigned idx = 0; idx < n; ++idx) {
+    str_things[idx]._key = strings[idx];
+    str_things[idx]._n   = idx;
+    int_things[idx]._key = rng();
+    int_things[idx]._n   = idx;
+  }
+
+  // Mostly hits with some misses.
+  std::vector<std::string_view> str_keys;
+  std::vector<unsigned> int_keys;
+  for (unsigned idx = 0; idx < n_lookups; ++idx) {
+    auto k = rng() % n;
+    if (idx % 8 == 0) {
+      str_keys.push_back(strings[k].substr(1));
+      int_keys.push_back(int_things[k]._key + 1);
+    } else {
+      str_keys.push_back(strings[k]);
+      int_keys.push_back(int_things[k]._key);
+    }
+  }
+
+  std::cout << n << " elements, millions of lookups / second" << std::endl << "key\tprime\tpower of 2\tflat" << std::endl;
+  compare<std::string_view, std::hash<std::string_view>>("string", str_things, str_keys);
+  compare<unsigned, IntHash>("integer", int_things, int_keys);
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Thread scaling of a shared @c IntrusiveHashMap.
+
+    Each thread does mostly lookups of random keys, with one in ten operations removing one of its
+    own elements and inserting it back, as for a session table. This is done with a single
+    @c IntrusiveHashMap protected by a mutex and with a @c ConcurrentIntrusiveHashMap.
+
+    Arguments are the maximum number of threads, the number of operations per thread, and the
+    number of elements per thread.
+
+    ex_hashmap_scaling 8 2000000 10000
+*/
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "swoc/TextView.h"
+#include "swoc/IntrusiveHashMap.h"
+#include "swoc/ConcurrentIntrusiveHashMap.h"
+
+struct Session {
+  unsigned _key;
+  Session *_next = nullptr;
+  Session *_prev = nullptr;
+};
+
+struct Descriptor {
+  static Session *&
+  next_ptr(Session *s) {
+    return s->_next;
+  }
+  static Session *&
+  prev_ptr(Session *s) {
+    return s->_prev;
+  }
+  static unsigned
+  key_of(Session *s) {
+    return s->_key;
+  }
+  static size_t
+  hash_of(unsigned key) {
+    return key;
+  }
+  static bool
+  equal(unsigned lhs, unsigned rhs) {
+    return lhs == rhs;
+  }
+};
+
+/// A single map with a mutex.
+struct Locked {
+  swoc::IntrusiveHashMap<Descriptor> _map;
+  std::mutex _mutex;
+
+  void
+  insert(Session *s) {
+    std::lock_guard lock(_mutex);
+    _map.insert(s);
+  }
+  void
+  erase(Session *s) {
+    std::lock_guard lock(_mutex);
+    _map.erase(s);
+  }
+  Session *
+  find(unsigned key) {
+    std::lock_guard lock(_mutex);
+    auto spot = _map.find(key);
+    return spot == _map.end() ? nullptr : &*spot;
+  }
+};
+
+/// Run the workload on @a map with @a n_threads and return millions of operations per second.
+template <typename MAP>
+double
+run(MAP& map, std::vector<std::vector<Session>>& sessions, std::vector<unsigned> const& keys, unsigned n_threads, unsigned n_ops) {
+  for (unsigned t = 0; t < n_threads; ++t) {
+    for (auto& s : sessions[t]) {
+      map.insert(&s);
+    }
+  }
+  std::vector<std::thread> threads;
+  std::vector<unsigned> hits(n_threads);
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::minstd_rand rng(t + 1);
+      auto& mine = sessions[t];
+      for (unsigned i = 0; i < n_ops; ++i) {
+        if (i % 10 == 0) {
+          auto s = &mine[rng() % mine.size()];
+          map.erase(s);
+          map.insert(s);
+        } else if (map.find(keys[rng() % keys.size()])) {
+          ++hits[t];
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto delta = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  for (unsigned t = 0; t < n_threads; ++t) {
+    for (auto& s : sessions[t]) {
+      map.erase(&s);
+    }
+  }
+  return double(n_threads) * n_ops / delta / 1e6;
+}
+
+int
+main(int argc, char *argv[]) {
+  unsigned max_threads = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : std::thread::hardware_concurrency();
+  unsigned n_ops       = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 2000000;
+  unsigned n_elts      = argc > 3 ? swoc::svtou(std::string_view{argv[3]}) : 10000;
+  max_threads          = std::max(max_threads, 1U);
+  n_elts               = std::max(n_elts, 1U);
+
+  std::vector<std::vector<Session>> sessions(max_threads, std::vector<Session>(n_elts));
+  // Random keys, as from hashing addresses.
+  std::vector<unsigned> keys;
+  std::mt19937 rng(17);
+  for (auto& v : sessions) {
+    for (auto& s : v) {
+      s._key = rng();
+      keys.push_back(s._key);
+    }
+  }
+
+  std::cout << "millions of operations / second" << std::endl << "threads\tmutex\tsharded" << std::endl;
+  for (unsigned n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+    Locked locked;
+    auto l = run(locked, sessions, keys, n_threads, n_ops);
+    swoc::ConcurrentIntrusiveHashMap<Descriptor> sharded;
+    auto s = run(sharded, sessions, keys, n_threads, n_ops);
+    std::cout << n_threads << "\t" << l << "\t" << s << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Lookup speed of a frozen @c Lexicon.
+
+    A lexicon of HTTP header names is looked up by name and by value, before and after freezing.
+    Name lookups use names with mixed case and some unknown names.
+
+    The argument is the number of lookups.
+
+    ex_lexicon 10000000
+*/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "swoc/TextView.h"
+#include "swoc/Lexicon.h"
+
+using Lexicon = swoc::Lexicon<int>;
+
+static constexpr std::string_view NAMES[] = {
+  "Accept", "Accept-Charset", "Accept-Encoding", "Accept-Language", "Accept-Ranges", "Age", "Allow", "Authorization",
+  "Cache-Control", "Connection", "Content-Encoding", "Content-Language", "Content-Length", "Content-Location",
+  "Content-MD5", "Content-Range", "Content-Type", "Cookie", "Date", "ETag", "Expect", "Expires", "From", "Host",
+  "If-Match", "If-Modified-Since", "If-None-Match", "If-Range", "If-Unmodified-Since", "Keep-Alive", "Last-Modified",
+  "Location", "Max-Forwards", "Pragma", "Proxy-Authenticate", "Proxy-Authorization", "Proxy-Connection", "Range",
+  "Referer", "Retry-After", "Server", "Set-Cookie", "TE", "Trailer", "Transfer-Encoding", "Upgrade", "User-Agent",
+  "Vary", "Via", "Warning", "WWW-Authenticate", "X-Forwarded-For"};
+
+/// Nanoseconds per call of @a f on each of @a items.
+template <typename T, typename F>
+double
+run(std::vector<T> const& items, F&& f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto const& item : items) {
+    f(item);
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / items.size();
+}
+
+int
+main(int argc, char *argv[]) {
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 10000000;
+
+  Lexicon lex(-1, "unknown");
+  int value = 0;
+  for (auto name : NAMES) {
+    lex.define(value++, name);
+  }
+
+  // Lookup keys - names in varying case with some unknown, and values with some unknown.
+  std::minstd_rand rng(11);
+  std::vector<std::string> names;
+  for (auto name : NAMES) {
+    std::string s{name};
+    names.push_back(s);
+    for (auto& c : s) {
+      c = toupper(c);
+    }
+    names.push_back(s);
+  }
+  names.push_back("X-Unknown");
+  names.push_back("Content-Lengths");
+  std::vector<std::string_view> name_keys;
+  std::vector<int> value_keys;
+  for (unsigned idx = 0; idx < n; ++idx) {
+    name_keys.push_back(names[rng() % names.size()]);
+    value_keys.push_back(rng() % (value + 2));
+  }
+
+  size_t sum        = 0;
+  auto by_name      = [&](std::string_view name) { sum += lex[name]; };
+  auto by_value     = [&](int v) { sum += lex[v].size(); };
+  double name_hash  = run(name_keys, by_name);
+  double value_hash = run(value_keys, by_value);
+
+  auto t0 = std::chrono::steady_clock::now();
+  lex.freeze();
+  auto freeze_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+
+  double name_frozen  = run(name_keys, by_name);
+  double value_frozen = run(value_keys, by_value);
+
+  std::cout << lex.count() << " names, frozen in " << freeze_time << " us" << std::endl
+            << "ns / lookup\thash\tfrozen" << std::endl
+            << "name\t\t" << name_hash << "\t" << name_frozen << std::endl
+            << "value\t\t" << value_hash << "\t" << value_frozen << std::endl;
+
+  return sum == 0; // use the results.
+}
@@ -17,9 +17,12 @@
 
 #include <unordered_set>
 #include <fstream>
+#include <random>
+#include <algorithm>
 
 #include "swoc/TextView.h"
 #include "swoc/swoc_ip.h"
+#include "swoc/IPTrie.h"
 #include "swoc/bwf_ip.h"
 #include "swoc/bwf_std.h"
 #include "swoc/bwf_std.h"
@@ -132,9 +135,15 @@ void post_processing_performance_test(Space & space) {
       a6.push_back(++IP6Addr(a));
     }
   }
+  // Lookups in practice are not in address order, randomize to avoid measuring only cache hits.
+  std::mt19937 rng{0x5ca1ab1e};
+  std::shuffle(a4.begin(), a4.end(), rng);
+  std::shuffle(a6.begin(), a6.end(), rng);
+
+  unsigned hits = 0; // Use the lookup results so they are not optimized out.
   auto t0 = std::chrono::system_clock::now();
   for ( auto const& addr : a4) {
-    [[maybe_unused]] auto spot = space.find(addr);
+    hits += space.find(addr) != space.end();
   }
   auto delta = std::chrono::system_clock::now() - t0;
   std::cout << W().print("IPv4 time - {} addresses, {} ns total, {} ns per lookup\n",
@@ -142,9 +151,98 @@ void post_processing_performance_test(Space & space) {
 
   t0 = std::chrono::system_clock::now();
   for ( auto const& addr : a6) {
-    [[maybe_unused]] auto spot = space.find(addr);
+    hits += space.find(addr) != space.end();
   }
   delta = std::chrono::system_clock::now() - t0;
   std::cout << W().print("IPv6 time - {} addresses, {} ns total, {} ns per lookup\n",
       a6.size(), delta.count(), delta.count() / a6.size());
+
+  // Same lookups in batches.
+  static constexpr size_t BATCH = 1024;
+  std::vector<Space::iterator> spots(BATCH);
+  t0 = std::chrono::system_clock::now();
+  for (size_t idx = 0; idx < a4.size(); idx += BATCH) {
+    hits += space.find(swoc::MemSpan<IP4Addr const>{a4.data() + idx, std::min(BATCH, a4.size() - idx)}, swoc::MemSpan<Space::iterator>{spots.data(), spots.size()});
+  }
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("IPv4 batch time - {} addresses, {} ns total, {} ns per lookup\n",
+    a4.size(), delta.count(), delta.count() / a4.size());
+
+  t0 = std::chrono::system_clock::now();
+  for (size_t idx = 0; idx < a6.size(); idx += BATCH) {
+    hits += space.find(swoc::MemSpan<IP6Addr const>{a6.data() + idx, std::min(BATCH, a6.size() - idx)}, swoc::MemSpan<Space::iterator>{spots.data(), spots.size()});
+  }
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("IPv6 batch time - {} addresses, {} ns total, {} ns per lookup\n",
+    a6.size(), delta.count(), delta.count() / a6.size());
+
+  // Rebuild the space from its sorted ranges, by marking and by bulk loading.
+  std::vector<std::pair<IPRange, std::monostate>> sorted;
+  for ( auto && [ r, p ] : space) {
+    sorted.emplace_back(r, p);
+  }
+  {
+    Space s;
+    t0 = std::chrono::system_clock::now();
+    for ( auto const& [ r, p ] : sorted) {
+      s.mark(r, p);
+    }
+    delta = std::chrono::system_clock::now() - t0;
+    std::cout << W().print("Mark time - {} ranges, {} ns total, {} ns per range\n",
+      s.count(), delta.count(), delta.count() / sorted.size());
+  }
+  {
+    Space s;
+    t0 = std::chrono::system_clock::now();
+    s.load(sorted.begin(), sorted.end());
+    delta = std::chrono::system_clock::now() - t0;
+    std::cout << W().print("Load time - {} ranges, {} ns total, {} ns per range\n",
+      s.count(), delta.count(), delta.count() / sorted.size());
+  }
+
+  // Same lookups on the frozen / flat version of the space.
+  t0 = std::chrono::system_clock::now();
+  swoc::IPFlatSpace<std::monostate> flat{space};
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("Flat space - {} ranges, built in {} ns\n", flat.count(), delta.count());
+
+  t0 = std::chrono::system_clock::now();
+  for ( auto const& addr : a4) {
+    hits += flat.find(addr) != flat.end();
+  }
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("IPv4 flat time - {} addresses, {} ns total, {} ns per lookup\n",
+    a4.size(), delta.count(), delta.count() / a4.size());
+
+  t0 = std::chrono::system_clock::now();
+  for ( auto const& addr : a6) {
+    hits += flat.find(addr) != flat.end();
+  }
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("IPv6 flat time - {} addresses, {} ns total, {} ns per lookup\n",
+      a6.size(), delta.count(), delta.count() / a6.size());
+
+  // Same lookups on a prefix trie built from the space.
+  t0 = std::chrono::system_clock::now();
+  swoc::IPTrie<std::monostate> trie{space};
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("Trie - {} networks, {} IPv4 tables, {} IPv6 tables, built in {} ns\n", trie.count(),
+                         trie.ip4().node_count(), trie.ip6().node_count(), delta.count());
+
+  t0 = std::chrono::system_clock::now();
+  for ( auto const& addr : a4) {
+    hits += std::get<1>(trie.find(addr)) != nullptr;
+  }
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("IPv4 trie time - {} addresses, {} ns total, {} ns per lookup\n",
+    a4.size(), delta.count(), delta.count() / a4.size());
+
+  t0 = std::chrono::system_clock::now();
+  for ( auto const& addr : a6) {
+    hits += std::get<1>(trie.find(addr)) != nullptr;
+  }
+  delta = std::chrono::system_clock::now() - t0;
+  std::cout << W().print("IPv6 trie time - {} addresses, {} ns total, {} ns per lookup\n",
+      a6.size(), delta.count(), delta.count() / a6.size());
+  std::cout << W().print("{} hits\n", hits);
 }
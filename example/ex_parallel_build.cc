@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Parallel construction of an IP space from multiple feeds.
+
+    Each feed is a set of random ranges which is blended in to the space as a bit in a bitset
+    payload. The space is built sequentially with @c IPSpace::blend and in parallel with
+    @c IPSpaceBuilder with increasing numbers of threads, and the results are checked to be
+    identical.
+
+    Arguments are the number of feeds, the number of ranges per feed, and the maximum number
+    of threads.
+
+    ex_parallel_build 8 200000 8
+*/
+
+#include <bitset>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "swoc/swoc_ip.h"
+#include "swoc/IPSpaceBuilder.h"
+
+using namespace std::literals;
+
+using swoc::IP4Addr;
+using swoc::IP6Addr;
+using swoc::IPRange;
+using swoc::IP4Range;
+using swoc::IP6Range;
+
+using Bits    = std::bitset<64>;
+using Space   = swoc::IPSpace<Bits>;
+using Builder = swoc::IPSpaceBuilder<Bits, unsigned>;
+
+/// Blend a feed bit in to a payload.
+bool
+blender(Bits& bits, unsigned bit) {
+  bits[bit] = true;
+  return true;
+}
+
+/// @return @c true if @a lhs and @a rhs have the same ranges and payloads.
+bool
+same(Space const& lhs, Space const& rhs) {
+  if (lhs.count() != rhs.count()) {
+    return false;
+  }
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](auto const& l, auto const& r) {
+    return std::get<0>(l) == std::get<0>(r) && std::get<1>(l) == std::get<1>(r);
+  });
+}
+
+int
+main(int argc, char *argv[]) {
+  unsigned n_feeds   = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 8;
+  unsigned n_ranges  = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 200000;
+  unsigned n_threads = argc > 3 ? swoc::svtou(std::string_view{argv[3]}) : std::thread::hardware_concurrency();
+  n_feeds            = std::clamp(n_feeds, 1U, 64U);
+  n_threads          = std::max(n_threads, 1U);
+
+  // Generate the feeds - mostly IPv4 with some IPv6.
+  std::mt19937 rng(0x5ca1ab1e);
+  std::vector<std::vector<IPRange>> feeds(n_feeds);
+  for (auto& feed : feeds) {
+    for (unsigned idx = 0; idx < n_ranges; ++idx) {
+      if (idx % 8 == 0) {
+        in6_addr addr{};
+        addr.s6_addr[0] = 0x20;
+        addr.s6_addr[1] = 0x01;
+        for (unsigned b = 2; b < 8; ++b) {
+          addr.s6_addr[b] = rng() & 0xFF;
+        }
+        IP6Addr min{addr};
+        for (unsigned b = 8; b < 16; ++b) {
+          addr.s6_addr[b] = 0xFF;
+        }
+        feed.emplace_back(IP6Range{min, IP6Addr{addr}});
+      } else {
+        IP4Addr min{in_addr_t(rng())};
+        in_addr_t max = min.host_order() + (rng() & 0xFFFF);
+        feed.emplace_back(IP4Range{min, IP4Addr{std::max(max, min.host_order())}});
+      }
+    }
+  }
+  std::cout << n_feeds << " feeds of " << n_ranges << " ranges" << std::endl;
+
+  Space seq;
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned bit = 0; bit < n_feeds; ++bit) {
+    for (auto const& range : feeds[bit]) {
+      seq.blend(range, bit, &blender);
+    }
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  std::cout << "Sequential: " << seq.count() << " ranges in " << std::chrono::duration_cast<std::chrono::milliseconds>(delta).count()
+            << " ms" << std::endl;
+
+  Builder builder;
+  t0 = std::chrono::steady_clock::now();
+  for (unsigned bit = 0; bit < n_feeds; ++bit) {
+    for (auto const& range : feeds[bit]) {
+      builder.blend(range, bit);
+    }
+  }
+  delta = std::chrono::steady_clock::now() - t0;
+  std::cout << "Recorded " << builder.count() << " operations in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(delta).count() << " ms" << std::endl;
+
+  bool ok_p = true;
+  for (unsigned n = 1; n <= n_threads; n *= 2) {
+    Space space;
+    t0 = std::chrono::steady_clock::now();
+    builder.build(space, &blender, n);
+    delta = std::chrono::steady_clock::now() - t0;
+    bool same_p = same(seq, space);
+    ok_p        = ok_p && same_p;
+    std::cout << "Parallel " << n << " threads: " << space.count() << " ranges in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(delta).count() << " ms"
+              << (same_p ? "" : " - MISMATCH") << std::endl;
+  }
+
+  return ok_p ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Throughput of a shared IP space under update load.
+
+    Reader threads look up random addresses while a writer thread periodically updates the space.
+    This is done with @c SharedIPSpace and with an @c IPSpace protected by a @c std::shared_mutex
+    to compare the lookup rates.
+
+    Arguments are the number of reader threads, the number of ranges, and the number of seconds
+    for each run.
+
+    ex_shared_ip_space 8 100000 2
+*/
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <memory>
+#include <algorithm>
+
+#include "swoc/TextView.h"
+#include "swoc/swoc_ip.h"
+#include "swoc/SharedIPSpace.h"
+#include "swoc/bwf_std.h"
+
+using namespace std::literals;
+
+using swoc::IP4Addr;
+using swoc::IP4Range;
+using swoc::IPSpace;
+using swoc::SharedIPSpace;
+
+using Space = IPSpace<unsigned>;
+
+/// Interval between updates.
+static constexpr auto UPDATE_INTERVAL = 100ms;
+
+/// Fill @a space with @a ranges, each with a distinct payload starting at @a base.
+void
+fill(Space& space, std::vector<IP4Range> const& ranges, unsigned base) {
+  unsigned idx = base;
+  for (auto const& r : ranges) {
+    space.mark(r, idx++);
+  }
+}
+
+/// Result of a run.
+struct Result {
+  uint64_t _lookups = 0;                  ///< Total lookups.
+  unsigned _updates = 0;                  ///< Total updates.
+  std::chrono::nanoseconds _elapsed{0};   ///< Actual run time.
+  std::chrono::nanoseconds _update_time{0}; ///< Time spent in updates.
+
+  /// Print the results with @a name.
+  void print(char const *name) const {
+    auto sec = std::chrono::duration<double>(_elapsed).count();
+    std::cout << name << ": " << _lookups / sec / 1e6 << "M lookups/sec, " << _updates << " updates, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(_update_time).count() / std::max(1U, _updates) << " us/update"
+              << std::endl;
+  }
+};
+
+/** Run readers and a writer.
+ *
+ * @param n_threads Number of reader threads.
+ * @param duration Length of the run.
+ * @param addrs Addresses to look up.
+ * @param lookup Lookup functor, invoked with the thread index and an address. Must return the number of hits.
+ * @param update Update functor, invoked with the update count.
+ */
+template <typename L, typename U>
+Result
+run(unsigned n_threads, std::chrono::milliseconds duration, std::vector<IP4Addr> const& addrs, L&& lookup, U&& update) {
+  Result zret;
+  std::atomic<uint64_t> total{0};
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  auto limit = start + duration;
+
+  // Readers check the time themselves so the run ends even if the writer is starved.
+  for (unsigned t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      uint64_t count = 0;
+      uint64_t hits  = 0;
+      size_t idx     = (t * addrs.size()) / n_threads;
+      while (std::chrono::steady_clock::now() < limit) {
+        for (unsigned k = 0; k < 256; ++k) {
+          hits += lookup(t, addrs[idx]);
+          if (++idx >= addrs.size()) {
+            idx = 0;
+          }
+        }
+        count += 256;
+      }
+      total += count;
+      if (hits == 0) {
+        std::cerr << "No hits in thread " << t << std::endl;
+      }
+    });
+  }
+
+  for (auto next = start + UPDATE_INTERVAL; next < limit; next += UPDATE_INTERVAL) {
+    std::this_thread::sleep_until(next);
+    auto t0 = std::chrono::steady_clock::now();
+    update(++zret._updates);
+    zret._update_time += std::chrono::steady_clock::now() - t0;
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  zret._elapsed = std::chrono::steady_clock::now() - start;
+  zret._lookups = total;
+  return zret;
+}
+
+int
+main(int argc, char *argv[]) {
+  unsigned n_threads = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : std::thread::hardware_concurrency();
+  unsigned n_ranges  = argc > 2 ? swoc::svtou(std::string_view{argv[2]}) : 100000;
+  std::chrono::milliseconds duration{argc > 3 ? 1000 * swoc::svtou(std::string_view{argv[3]}) : 2000};
+
+  if (n_threads < 1) {
+    n_threads = 1;
+  }
+
+  std::mt19937 rng(0x5ca1ab1e);
+  std::vector<IP4Range> ranges;
+  std::vector<IP4Addr> addrs;
+  ranges.reserve(n_ranges);
+  addrs.reserve(n_ranges);
+  for (unsigned i = 0; i < n_ranges; ++i) {
+    IP4Addr min{in_addr_t(rng())};
+    IP4Addr max{in_addr_t(min.host_order() + (rng() & 0xFFF))};
+    if (max < min) {
+      max = min;
+    }
+    ranges.emplace_back(min, max);
+    addrs.emplace_back(in_addr_t(min.host_order() + ((max.host_order() - min.host_order()) >> 1)));
+  }
+  std::shuffle(addrs.begin(), addrs.end(), rng);
+  // Updates touch a small fraction of the space.
+  auto update_ranges = [&](Space& space, unsigned k) {
+    for (unsigned i = 0; i < 16; ++i) {
+      space.mark(ranges[(k * 16 + i) % ranges.size()], k);
+    }
+  };
+
+  std::cout << "Threads: " << n_threads << " Ranges: " << n_ranges << " Run: " << duration.count() << "ms" << std::endl;
+
+  {
+    Space space;
+    std::shared_mutex mutex;
+    fill(space, ranges, 0);
+    auto r = run(
+      n_threads, duration, addrs,
+      [&](unsigned, IP4Addr const& addr) -> unsigned {
+        std::shared_lock lock(mutex);
+        return space.find(addr) != space.end();
+      },
+      [&](unsigned k) {
+        std::unique_lock lock(mutex);
+        update_ranges(space, k);
+      });
+    r.print("shared_mutex");
+  }
+
+  {
+    SharedIPSpace<unsigned> shared;
+    shared.rebuild([&](Space& space) { fill(space, ranges, 0); });
+    std::vector<std::unique_ptr<SharedIPSpace<unsigned>::Reader>> readers;
+    for (unsigned t = 0; t < n_threads; ++t) {
+      readers.emplace_back(new SharedIPSpace<unsigned>::Reader{shared});
+    }
+    auto r = run(
+      n_threads, duration, addrs,
+      [&](unsigned t, IP4Addr const& addr) -> unsigned {
+        auto ref = readers[t]->lock();
+        return ref->find(addr) != ref->end();
+      },
+      [&](unsigned k) { shared.update([&](Space& space) { update_ranges(space, k); }); });
+    r.print("SharedIPSpace");
+  }
+
+  return 0;
+}
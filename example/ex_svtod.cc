@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of floating point conversion.
+
+    Numbers typical of log and configuration fields - latencies, ratios, and full precision values -
+    are converted with @c svtod, with @c strtod on a @c std::string copy of the text as is needed to
+    get a C string from a view, and with @c strtod directly. Results are checked to be the same for
+    all of the methods.
+
+    The argument is the number of conversions.
+
+    ex_svtod 10000000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "swoc/TextView.h"
+
+using swoc::TextView;
+
+namespace {
+/// Nanoseconds per call of @a f on each of @a items, @a passes times.
+template <typename F>
+double
+run(std::vector<std::string> const& items, unsigned passes, F&& f) {
+  double sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  for (unsigned pass = 0; pass < passes; ++pass) {
+    for (auto const& item : items) {
+      sum += f(item);
+    }
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / (double(passes) * items.size());
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 10000000;
+
+  std::mt19937_64 rng(17);
+  std::uniform_real_distribution<double> unit;
+  static const std::string REST{" 200 GET http://www.example.com/"};
+  struct Set {
+    char const *title;
+    std::vector<std::string> items;
+  };
+  Set sets[] = {{"latency (0.123)  ", {}}, {"ratio (0.4567)   ", {}}, {"exponent (1e-5)  ", {}}, {"full (17 digits) ", {}}};
+  // Few enough items to stay in cache.
+  static constexpr unsigned N_ITEMS = 10000;
+  unsigned passes                   = n / (4 * N_ITEMS);
+  char buff[64];
+  for (unsigned idx = 0; idx < N_ITEMS; ++idx) {
+    snprintf(buff, sizeof(buff), "%.3f", unit(rng) * 10);
+    sets[0].items.push_back(buff + REST);
+    snprintf(buff, sizeof(buff), "%.4f", unit(rng));
+    sets[1].items.push_back(buff + REST);
+    snprintf(buff, sizeof(buff), "%.2e", unit(rng) * 1e-3);
+    sets[2].items.push_back(buff + REST);
+    uint64_t bits = rng() >> 2; // positive, finite.
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    snprintf(buff, sizeof(buff), "%.17g", d);
+    sets[3].items.push_back(buff + REST);
+  }
+
+  auto svtod       = [](std::string const& s) { return swoc::svtod(s); };
+  auto strtod_copy = [](std::string const& s) {
+    TextView view{s};
+    return std::strtod(std::string(view.prefix(view.find(' '))).c_str(), nullptr);
+  };
+  auto strtod = [](std::string const& s) { return std::strtod(s.c_str(), nullptr); };
+
+  unsigned mismatch = 0;
+  for (auto const& set : sets) {
+    for (auto const& item : set.items) {
+      double lhs = svtod(item), rhs = strtod(item);
+      mismatch += (0 != memcmp(&lhs, &rhs, sizeof(double)));
+    }
+  }
+
+  std::cout << "ns per number      svtod  strtod (copy)  strtod" << std::endl;
+  for (auto const& set : sets) {
+    std::cout << set.title << "  " << run(set.items, passes, svtod) << "  " << run(set.items, passes, strtod_copy) << "  "
+              << run(set.items, passes, strtod) << std::endl;
+  }
+  std::cout << "Mismatches: " << mismatch << std::endl;
+  return 0;
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of integer conversion.
+
+    Numbers typical of access log fields - status codes, sizes, times, and identifiers - are converted
+    with @c svtou, @c svto_radix_checked, the per character loop @c svtou used previously,
+    @c std::from_chars, and @c strtoull.
+
+    The argument is the number of conversions.
+
+    ex_svtoi 10000000
+*/
+
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "swoc/TextView.h"
+
+using swoc::TextView;
+
+namespace {
+/// The previous conversion, one character at a time.
+uintmax_t
+per_char(TextView src) {
+  uintmax_t zret{0};
+  int8_t v;
+  while (src.size() && (0 <= (v = swoc::svtoi_convert[uint8_t(*src)])) && v < 10) {
+    zret = zret * 10 + v;
+    ++src;
+  }
+  return zret;
+}
+
+/// Nanoseconds per call of @a f on each of @a items, @a passes times.
+template <typename F>
+double
+run(std::vector<std::string> const& items, unsigned passes, F&& f) {
+  uintmax_t sum = 0;
+  auto t0       = std::chrono::steady_clock::now();
+  for (unsigned pass = 0; pass < passes; ++pass) {
+    for (auto const& item : items) {
+      sum += f(item);
+    }
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / (double(passes) * items.size());
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  unsigned n = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 10000000;
+
+  std::minstd_rand rng(17);
+  std::uniform_int_distribution<uint64_t> id;
+  // The numbers are fields in a line.
+  static const std::string REST{" TCP_MISS/200 GET http://www.example.com/ - DIRECT/10.0.0.2 text/html"};
+  struct Set {
+    char const *title;
+    std::vector<std::string> items;
+  };
+  Set sets[] = {{"status (3)   ", {}}, {"size (1-7)   ", {}}, {"time (10)    ", {}}, {"id (19-20)   ", {}}};
+  // Few enough items to stay in cache.
+  static constexpr unsigned N_ITEMS = 10000;
+  unsigned passes                   = n / (4 * N_ITEMS);
+  for (unsigned idx = 0; idx < N_ITEMS; ++idx) {
+    sets[0].items.push_back(std::to_string(100 + rng() % 500) + REST);
+    sets[1].items.push_back(std::to_string(rng() % (uint64_t(1) << (rng() % 23))) + REST);
+    sets[2].items.push_back(std::to_string(1600000000 + rng() % 100000000) + REST);
+    sets[3].items.push_back(std::to_string(id(rng) | (uint64_t(1) << 63)) + REST);
+  }
+
+  auto svtou      = [](std::string const& s) { return swoc::svtou(s); };
+  auto checked    = [](std::string const& s) { return swoc::svto_radix_checked<10>(s).value; };
+  auto from_chars = [](std::string const& s) {
+    uint64_t zret = 0;
+    std::from_chars(s.data(), s.data() + s.size(), zret);
+    return zret;
+  };
+  auto strtoull = [](std::string const& s) { return std::strtoull(s.c_str(), nullptr, 10); };
+
+  std::cout << "ns per number  per_char  svtou  checked  from_chars  strtoull" << std::endl;
+  for (auto const& set : sets) {
+    std::cout << set.title << "  " << run(set.items, passes, &per_char) << "  " << run(set.items, passes, svtou)
+              << "  " << run(set.items, passes, checked) << "  " << run(set.items, passes, from_chars) << "  "
+              << run(set.items, passes, strtoull) << std::endl;
+  }
+  return 0;
+}
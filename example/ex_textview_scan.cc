@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 Verizon Media
+
+/** @file
+
+    Speed of delimiter searches in @c TextView.
+
+    Lines typical of configuration files and access logs are tokenized with @c TextView using
+    strings of delimiters and using @c CharSet, and with the same operations done a byte at a time,
+    as @c TextView did before the searches were vectorized.
+
+    The argument is the number of passes over the lines.
+
+    ex_textview_scan 20000
+*/
+
+#include <bitset>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "swoc/TextView.h"
+
+using swoc::TextView;
+
+namespace {
+/// Byte at a time versions of the @c TextView methods.
+struct Scalar {
+  static constexpr std::string_view WS{" \t"};
+  static constexpr std::string_view SEP{",;"};
+  static constexpr std::string_view EQ{"="};
+
+  static TextView
+  take_prefix_at(TextView& src, std::string_view const& delimiters) {
+    return src.take_prefix(src.find_first_of(delimiters));
+  }
+
+  static TextView&
+  ltrim(TextView& src, std::string_view const& delimiters) {
+    std::bitset<256> set;
+    for (char c : delimiters) {
+      set[static_cast<uint8_t>(c)] = true;
+    }
+    size_t idx = 0;
+    while (idx < src.size() && set[static_cast<uint8_t>(src[idx])]) {
+      ++idx;
+    }
+    return src.remove_prefix(idx);
+  }
+
+  static TextView&
+  trim(TextView& src, std::string_view const& delimiters) {
+    ltrim(src, delimiters);
+    auto n = src.find_last_not_of(delimiters);
+    return src.remove_suffix(src.size() - (n == src.npos ? 0 : n + 1));
+  }
+};
+
+/// The @c TextView methods with strings of delimiters.
+struct Vector {
+  static constexpr std::string_view WS{" \t"};
+  static constexpr std::string_view SEP{",;"};
+  static constexpr std::string_view EQ{"="};
+
+  static TextView
+  take_prefix_at(TextView& src, std::string_view const& delimiters) {
+    return src.take_prefix_at(delimiters);
+  }
+
+  static TextView&
+  ltrim(TextView& src, std::string_view const& delimiters) {
+    return src.ltrim(delimiters);
+  }
+
+  static TextView&
+  trim(TextView& src, std::string_view const& delimiters) {
+    return src.trim(delimiters);
+  }
+};
+
+/// The @c TextView methods with character sets.
+struct Set {
+  static constexpr swoc::CharSet WS{" \t"};
+  static constexpr swoc::CharSet SEP{",;"};
+  static constexpr swoc::CharSet EQ{"="};
+
+  static TextView
+  take_prefix_at(TextView& src, swoc::CharSet const& set) {
+    return src.take_prefix_at(set);
+  }
+
+  static TextView&
+  ltrim(TextView& src, swoc::CharSet const& set) {
+    return src.ltrim(set);
+  }
+
+  static TextView&
+  trim(TextView& src, swoc::CharSet const& set) {
+    return src.trim(set);
+  }
+};
+
+/// Split a line in to white space separated tokens.
+template <typename S>
+size_t
+words(TextView line) {
+  size_t zret = 0;
+  while (S::ltrim(line, S::WS), line) {
+    zret += S::take_prefix_at(line, S::WS).size();
+  }
+  return zret;
+}
+
+/// Split a line in to comma separated key / value pairs.
+template <typename S>
+size_t
+pairs(TextView line) {
+  size_t zret = 0;
+  while (line) {
+    TextView value = S::take_prefix_at(line, S::SEP);
+    TextView key   = S::take_prefix_at(value, S::EQ);
+    zret += S::trim(key, S::WS).size() + S::trim(value, S::WS).size();
+  }
+  return zret;
+}
+
+/// Nanoseconds per line for @a passes of @a f over @a lines.
+template <typename F>
+double
+run(std::vector<std::string> const& lines, unsigned passes, F&& f) {
+  size_t sum = 0;
+  auto t0    = std::chrono::steady_clock::now();
+  for (unsigned pass = 0; pass < passes; ++pass) {
+    for (auto const& line : lines) {
+      sum += f(line);
+    }
+  }
+  auto delta = std::chrono::steady_clock::now() - t0;
+  if (sum == 1) { // Keep the work from being optimized away.
+    std::cout << sum;
+  }
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count()) / (double(passes) * lines.size());
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[]) {
+  unsigned passes = argc > 1 ? swoc::svtou(std::string_view{argv[1]}) : 20000;
+
+  std::minstd_rand rng(13);
+  std::vector<std::string> config;
+  std::vector<std::string> logs;
+  std::vector<std::string> lists;
+  static constexpr std::string_view METHODS[] = {"GET", "POST", "HEAD", "PUT"};
+  static constexpr std::string_view NAMES[]   = {"alpha", "bravo", "charlie", "delta", "echo", "foxtrot"};
+  for (unsigned idx = 0; idx < 200; ++idx) {
+    config.push_back("CONFIG proxy.config.http.server_ports    STRING   " + std::to_string(8000 + rng() % 1000) +
+                     " " + std::to_string(8000 + rng() % 1000) + ":ipv6");
+    logs.push_back(std::to_string(1600000000 + rng() % 1000) + ".123 " + std::to_string(rng() % 1000) + " 10.0.0." +
+                   std::to_string(rng() % 256) + " TCP_MISS/200 " + std::to_string(rng() % 100000) + " " +
+                   std::string(METHODS[rng() % 4]) + " http://www.example.com/path/to/resource/" +
+                   std::to_string(rng()) + "?query=" + std::to_string(rng()) + " - DIRECT/10.0.0.2 text/html");
+    std::string list;
+    for (unsigned k = 0, n = 3 + rng() % 6; k < n; ++k) {
+      list += std::string(k ? ", " : "") + std::string(NAMES[rng() % 6]) + " = " + std::to_string(rng() % 10000);
+    }
+    lists.push_back(list);
+  }
+
+  std::cout << "ns per line     scalar  vector  charset" << std::endl;
+  auto report = [&](char const *title, std::vector<std::string> const& lines, auto&& scalar, auto&& vector,
+                    auto&& set) {
+    auto s = run(lines, passes, scalar);
+    auto v = run(lines, passes, vector);
+    auto c = run(lines, passes, set);
+    std::cout << title << "  " << s << "  " << v << "  " << c << std::endl;
+  };
+  report("config words ", config, &words<Scalar>, &words<Vector>, &words<Set>);
+  report("log words    ", logs, &words<Scalar>, &words<Vector>, &words<Set>);
+  report("config pairs ", lists, &pairs<Scalar>, &pairs<Vector>, &pairs<Set>);
+
+  // Trimming white space with a locale aware predicate and a character set.
+  auto trim_isspace = [](TextView line) { return line.trim_if(&isspace).size(); };
+  auto trim_set     = [](TextView line) { return line.trim(Set::WS).size(); };
+  std::vector<std::string> padded;
+  for (auto const& line : config) {
+    padded.push_back("   \t  " + line.substr(0, 20) + "  \t   ");
+  }
+  std::cout << "trim isspace   " << run(padded, passes, trim_isspace) << "  charset  " << run(padded, passes, trim_set)
+            << std::endl;
+
+  return 0;
+}
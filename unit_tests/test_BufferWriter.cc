@@ -19,9 +19,11 @@
  */
 
 #include <cstring>
+#include <sstream>
 #include "swoc/MemArena.h"
 #include "swoc/BufferWriter.h"
 #include "swoc/ArenaWriter.h"
+#include "swoc/ChainWriter.h"
 #include "catch.hpp"
 
 namespace
@@ -41,7 +43,7 @@ TEST_CASE("BufferWriter::write(StringView)", "[BWWSV]")
     X() : i(0), j(0), good(true) {}
 
     X &
-    write(char c) override
+    overflow(char c) override
     {
       while (j == three[i].size()) {
         ++i;
@@ -386,6 +388,98 @@ TEST_CASE("ArenaWriter print", "[BW][ArenaWriter]")
   REQUIRE(valid_p == true);
 }
 
+TEST_CASE("ChainWriter", "[BW][ChainWriter]")
+{
+  swoc::MemArena arena{256};
+  swoc::ChainWriter cw{arena, 100};
+  std::string ref;
+  std::array<char, 85> buffer;
+
+  auto flatten = [](swoc::MemSpan<iovec const> chain) {
+    std::string zret;
+    for (auto const &v : chain) {
+      zret.append(static_cast<char const *>(v.iov_base), v.iov_len);
+    }
+    return zret;
+  };
+
+  REQUIRE(cw.extent() == 0);
+  REQUIRE(cw.count() == 0);
+  REQUIRE(cw.iovecs().count() == 0);
+
+  for (char c = 'a'; c <= 'z'; ++c) {
+    memset(buffer.data(), c, buffer.size());
+    cw.write(buffer.data(), buffer.size()).write(c);
+    ref.append(buffer.data(), buffer.size()).append(1, c);
+  }
+  for (int i = 0; i < 500; ++i) {
+    cw.print("{:>6}|{:<4}|{:x}.", i, i % 7, i * 31);
+    ref += swoc::LocalBufferWriter<64>{}.print("{:>6}|{:<4}|{:x}.", i, i % 7, i * 31).view();
+  }
+  REQUIRE(cw.extent() == ref.size());
+  REQUIRE(cw.error() == false);
+  REQUIRE(cw.count() > 1);
+
+  auto chain = cw.iovecs();
+  REQUIRE(chain.count() == cw.count());
+  REQUIRE(flatten(chain) == ref);
+  REQUIRE(arena.size() == ref.size()); // all of the output is allocated, and nothing else.
+  for (size_t i = 0; i < chain.count(); ++i) {
+    auto seg = cw.segment(i);
+    REQUIRE(seg.data() == chain[i].iov_base);
+    REQUIRE(seg.size() == chain[i].iov_len);
+  }
+
+  // Output is never moved.
+  auto first = chain[0];
+  std::string first_text{static_cast<char const *>(first.iov_base), first.iov_len};
+  std::string big(5000, 'x');
+  cw.write(big);
+  ref += big;
+  chain = cw.iovecs();
+  REQUIRE(chain[0].iov_base == first.iov_base);
+  REQUIRE(first_text == std::string_view(static_cast<char const *>(first.iov_base), first.iov_len));
+  REQUIRE(flatten(chain) == ref);
+
+  // Discard and copy across segments.
+  cw.discard(big.size() + 10);
+  ref.resize(ref.size() - big.size() - 10);
+  REQUIRE(flatten(cw.iovecs()) == ref);
+  cw.write("tail");
+  ref += "tail";
+  cw.copy(0, ref.size() - 200, 150);
+  ref.replace(0, 150, ref.substr(ref.size() - 200, 150));
+  cw.copy(ref.size() - 120, 10, 110);
+  ref.replace(ref.size() - 120, 110, ref.substr(10, 110));
+  REQUIRE(flatten(cw.iovecs()) == ref);
+
+  std::ostringstream out;
+  cw >> out;
+  REQUIRE(out.str() == ref);
+
+  // A restriction carries over to new segments.
+  auto n_segments = cw.count();
+  cw.restrict(10);
+  for (int i = 0; i < 300; ++i) {
+    cw.write(char('0' + i % 10));
+    ref += char('0' + i % 10);
+  }
+  REQUIRE(cw.count() > n_segments);
+  auto remaining = cw.remaining();
+  cw.restore(10);
+  REQUIRE(cw.remaining() == remaining + 10);
+  // More than the remaining space, the next write starts a segment with room for it.
+  auto reserve = cw.remaining() + 100;
+  cw.restrict(reserve);
+  REQUIRE(cw.remaining() == 0);
+  cw.write('!');
+  ref += '!';
+  remaining = cw.remaining();
+  cw.restore(reserve + 100);
+  REQUIRE(cw.remaining() == remaining + reserve);
+  REQUIRE(flatten(cw.iovecs()) == ref);
+}
+
 #if 0
 // Need Endpoint or some other IP address parsing support to load the test values.
 TEST_CASE("BufferWriter IP", "[libswoc][ip][bwf]") {
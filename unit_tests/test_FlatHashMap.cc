@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    FlatHashMap unit tests.
+*/
+
+#include <string>
+#include <string_view>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "swoc/FlatHashMap.h"
+#include "swoc/bwf_base.h"
+#include "catch.hpp"
+
+using swoc::FlatHashMap;
+using swoc::MemArena;
+
+using namespace std::literals;
+
+namespace
+{
+struct Thing {
+  std::string _payload;
+  int _n{0};
+
+  Thing(std::string_view text, int x) : _payload(text), _n(x) {}
+};
+
+// Same form as an @c IntrusiveHashMap descriptor, without the links.
+struct ThingDescriptor {
+  static std::string_view
+  key_of(Thing *thing)
+  {
+    return thing->_payload;
+  }
+  static size_t
+  hash_of(std::string_view s)
+  {
+    return std::hash<std::string_view>{}(s);
+  }
+  static bool
+  equal(std::string_view const &lhs, std::string_view const &rhs)
+  {
+    return lhs == rhs;
+  }
+};
+
+// Cheap integer hash, with the value in the low bits.
+struct Number {
+  unsigned _n;
+};
+
+struct NumberDescriptor {
+  static unsigned
+  key_of(Number const *n)
+  {
+    return n->_n;
+  }
+  static unsigned
+  hash_of(unsigned n)
+  {
+    return n;
+  }
+  static bool
+  equal(unsigned lhs, unsigned rhs)
+  {
+    return lhs == rhs;
+  }
+};
+
+// Hash values that differ only in the high bits.
+struct HighBitsDescriptor : public NumberDescriptor {
+  static uint64_t
+  hash_of(unsigned n)
+  {
+    return uint64_t(n) << 40;
+  }
+};
+
+// Access to the probe start.
+struct HighBitsMap : public FlatHashMap<HighBitsDescriptor> {
+  using FlatHashMap::probe_for;
+  using FlatHashMap::_capacity;
+};
+
+using Map = FlatHashMap<ThingDescriptor>;
+} // namespace
+
+TEST_CASE("FlatHashMap", "[libswoc][FlatHashMap]")
+{
+  static_assert(std::is_same_v<Map::value_type, Thing>);
+  static_assert(std::is_same_v<FlatHashMap<NumberDescriptor>::value_type, Number>);
+
+  Map map;
+  REQUIRE(map.count() == 0);
+  REQUIRE(map.begin() == map.end());
+  REQUIRE(map.find("bob"sv) == map.end());
+
+  Thing bob{"bob", 1};
+  Thing dave{"dave", 2};
+  Thing bob_too{"bob", 3};
+  REQUIRE(map.insert(&bob));
+  REQUIRE(map.insert(&dave));
+  REQUIRE(false == map.insert(&bob_too)); // Keys are unique.
+  REQUIRE(map.count() == 2);
+  REQUIRE(map.find("bob"sv)->_n == 1);
+  REQUIRE(map.find(&bob) != map.end());
+  REQUIRE(map.find(&bob_too) == map.end());
+  REQUIRE(std::distance(map.begin(), map.end()) == 2);
+
+  Map const &cmap = map;
+  REQUIRE(cmap.find("dave"sv)->_n == 2);
+
+  REQUIRE(false == map.erase(&bob_too));
+  REQUIRE(map.erase(&bob));
+  REQUIRE(map.find("bob"sv) == map.end());
+  REQUIRE(map.insert(&bob_too));
+  REQUIRE(map.find("bob"sv)->_n == 3);
+
+  map.clear();
+  REQUIRE(map.count() == 0);
+  REQUIRE(map.find("dave"sv) == map.end());
+  REQUIRE(map.capacity() > 0);
+}
+
+TEST_CASE("FlatHashMap Random", "[libswoc][FlatHashMap]")
+{
+  constexpr unsigned N = 20000;
+  std::vector<Number> numbers(N);
+  for (unsigned i = 0; i < N; ++i) {
+    numbers[i]._n = i * 64; // vary only the higher bits of the hash.
+  }
+
+  // Mix inserts and erases, checking against a reference.
+  FlatHashMap<NumberDescriptor> map;
+  std::unordered_map<unsigned, Number *> ref;
+  std::minstd_rand rng(7);
+  bool ok_p = true;
+  for (unsigned i = 0; i < 8 * N; ++i) {
+    auto n = &numbers[rng() % N];
+    if (rng() % 3) {
+      ok_p = ok_p && (map.insert(n) == ref.emplace(n->_n, n).second);
+    } else {
+      ok_p = ok_p && (map.erase(n) == (ref.erase(n->_n) > 0));
+    }
+  }
+  REQUIRE(ok_p);
+  REQUIRE(map.count() == ref.size());
+
+  for (auto const &n : numbers) {
+    auto spot = map.find(n._n);
+    if (ref.count(n._n) ? (spot == map.end() || &*spot != &n) : spot != map.end()) {
+      ok_p = false;
+    }
+  }
+  REQUIRE(ok_p);
+
+  // Every value exactly once.
+  size_t count = 0;
+  for (auto const &n : map) {
+    ok_p = ok_p && ref.count(n._n);
+    ++count;
+  }
+  REQUIRE(ok_p);
+  REQUIRE(count == ref.size());
+
+  // Erase during iteration.
+  for (auto spot = map.begin(); spot != map.end();) {
+    spot = (spot->_n % 128) ? map.erase(spot) : ++spot;
+  }
+  for (auto const &n : numbers) {
+    if ((map.find(n._n) != map.end()) != (n._n % 128 == 0 && ref.count(n._n) > 0)) {
+      ok_p = false;
+    }
+  }
+  REQUIRE(ok_p);
+}
+
+TEST_CASE("FlatHashMap High Bits", "[libswoc][FlatHashMap]")
+{
+  // The high bits of the hash must spread keys across groups, or probing is quadratic.
+  constexpr unsigned N = 8000;
+  std::vector<Number> numbers(N);
+  HighBitsMap map;
+  for (unsigned i = 0; i < N; ++i) {
+    numbers[i]._n = i;
+    map.insert(&numbers[i]);
+  }
+  REQUIRE(map.count() == N);
+  std::set<size_t> groups;
+  std::set<int8_t> h2s;
+  for (auto const &n : numbers) {
+    auto probe = map.probe_for(n._n);
+    groups.insert(probe._group);
+    h2s.insert(probe._h2);
+  }
+  REQUIRE(groups.size() > map._capacity / HighBitsMap::GROUP_SIZE / 2);
+  REQUIRE(h2s.size() == 128);
+  bool ok_p = true;
+  for (auto const &n : numbers) {
+    if (auto spot = map.find(n._n); spot == map.end() || &*spot != &n) {
+      ok_p = false;
+    }
+  }
+  REQUIRE(ok_p);
+}
+
+TEST_CASE("FlatHashMap Arena", "[libswoc][FlatHashMap]")
+{
+  MemArena arena;
+  std::vector<std::string> names;
+  std::vector<Thing> things;
+  constexpr int N = 1000;
+  names.reserve(N);
+  things.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    swoc::bwprint(names.emplace_back(), "thing-{}", i);
+    things.emplace_back(names.back(), i);
+  }
+
+  Map map(N, &arena);
+  auto capacity = map.capacity();
+  REQUIRE(arena.size() > 0);
+  for (auto &thing : things) {
+    map.insert(&thing);
+  }
+  REQUIRE(map.capacity() == capacity); // reserved enough.
+  REQUIRE(map.count() == N);
+  REQUIRE(arena.contains(&*map.begin()) == false);
+  bool ok_p = true;
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = map.find(names[i]); spot == map.end() || spot->_n != i) {
+      ok_p = false;
+    }
+  }
+  REQUIRE(ok_p);
+
+  Map other{std::move(map)};
+  REQUIRE(other.count() == N);
+  REQUIRE(map.count() == 0);
+  REQUIRE(map.find("thing-1"sv) == map.end());
+  REQUIRE(other.find("thing-1"sv)->_n == 1);
+}
@@ -23,8 +23,14 @@
 #include <string>
 #include <bitset>
 #include <random>
+#include <map>
+#include <set>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 #include "swoc/IntrusiveHashMap.h"
+#include "swoc/ConcurrentIntrusiveHashMap.h"
 #include "swoc/bwf_base.h"
 #include "catch.hpp"
 
@@ -80,6 +86,47 @@ struct ThingMapDescriptor {
 
 using Map = IntrusiveHashMap<ThingMapDescriptor>;
 
+struct ThingPow2Descriptor : public ThingMapDescriptor {
+  static constexpr swoc::IntrusiveHashMapping BUCKET_MAPPING = swoc::IntrusiveHashMapping::POWER_OF_2;
+};
+
+using Pow2Map = IntrusiveHashMap<ThingPow2Descriptor>;
+
+// Access to the bucket selection.
+struct Pow2Index : public Pow2Map {
+  using Pow2Map::index_of;
+};
+
+// Hash values that differ only in the high bits.
+struct ThingHighBitsDescriptor {
+  static Thing *&
+  next_ptr(Thing *thing)
+  {
+    return thing->_next;
+  }
+  static Thing *&
+  prev_ptr(Thing *thing)
+  {
+    return thing->_prev;
+  }
+  static int
+  key_of(Thing *thing)
+  {
+    return thing->_n;
+  }
+  static uint64_t
+  hash_of(int n)
+  {
+    return uint64_t(n) << 40;
+  }
+  static bool
+  equal(int lhs, int rhs)
+  {
+    return lhs == rhs;
+  }
+  static constexpr swoc::IntrusiveHashMapping BUCKET_MAPPING = swoc::IntrusiveHashMapping::POWER_OF_2;
+};
+
 } // namespace
 
 TEST_CASE("IntrusiveHashMap", "[libts][IntrusiveHashMap]")
@@ -235,5 +282,284 @@ TEST_CASE("IntrusiveHashMapManyStrings", "[IntrusiveHashMap]")
   REQUIRE(miss_p == false);
 };
 
+TEST_CASE("IntrusiveHashMap Incremental", "[IntrusiveHashMap]")
+{
+  constexpr int N      = 20000;
+  constexpr int N_KEYS = 7000;
+  Map ihm;
+  ihm.set_expansion_policy(Map::INCREMENTAL);
+
+  std::vector<std::string> keys;
+  for (int i = 0; i < N_KEYS; ++i) {
+    swoc::bwprint(keys.emplace_back(), "key-{}", i);
+  }
+
+  // Reference - values for each key, in insertion order.
+  std::map<std::string_view, std::vector<Thing *>> ref;
+  std::vector<Thing *> things;
+  std::minstd_rand randu;
+  bool expanding_p = false;
+
+  // Verify the map against the reference.
+  auto check = [&]() -> bool {
+    size_t n = 0;
+    for (auto const &[key, values] : ref) {
+      auto [first, last] = ihm.equal_range(key);
+      for (auto v : values) {
+        if (first == last || &*first != v) {
+          return false;
+        }
+        ++first;
+      }
+      if (first != last) {
+        return false;
+      }
+      n += values.size();
+    }
+    return n == ihm.count() && n == size_t(std::distance(ihm.begin(), ihm.end()));
+  };
+
+  bool ok_p = true;
+  for (int i = 0; i < N; ++i) {
+    auto &key = keys[randu() % N_KEYS];
+    auto t    = new Thing(key, i);
+    things.push_back(t);
+    ihm.insert(t);
+    ref[t->_payload].push_back(t);
+    expanding_p = expanding_p || ihm.is_expanding();
+    // Remove elements as well, in the old and new tables.
+    if (i % 5 == 0) {
+      auto &vec = ref[keys[randu() % N_KEYS]];
+      if (!vec.empty()) {
+        auto target = vec[randu() % vec.size()];
+        if (ihm.erase(target) == false) {
+          ok_p = false;
+        }
+        vec.erase(std::find(vec.begin(), vec.end(), target));
+      }
+    }
+    if (ihm.is_expanding() && i % 97 == 0) {
+      ok_p = ok_p && check();
+    }
+  }
+  REQUIRE(expanding_p == true);
+  REQUIRE(ok_p == true);
+  REQUIRE(check() == true);
+
+  // Make sure the const lookup finds elements in the old table.
+  while (!ihm.is_expanding()) {
+    auto t = new Thing(keys[randu() % N_KEYS], 0);
+    things.push_back(t);
+    ihm.insert(t);
+    ref[t->_payload].push_back(t);
+  }
+  Map const &cihm = ihm;
+  for (auto const &[key, values] : ref) {
+    if (!values.empty() && (cihm.find(key) == cihm.end() || &*cihm.find(key) != values.front())) {
+      ok_p = false;
+    }
+  }
+  REQUIRE(ok_p == true);
+  REQUIRE(ihm.is_expanding() == true);
+
+  // An explicit expansion must finish the incremental one.
+  auto n_buckets = ihm.bucket_count();
+  ihm.expand();
+  REQUIRE(ihm.is_expanding() == false);
+  REQUIRE(ihm.bucket_count() > n_buckets);
+  REQUIRE(check() == true);
+
+  ihm.clear();
+  for (auto t : things) {
+    delete t;
+  }
+}
+
+TEST_CASE("IntrusiveHashMap Power of 2", "[IntrusiveHashMap]")
+{
+  static_assert(Map::BUCKET_MAPPING == swoc::IntrusiveHashMapping::PRIME);
+  static_assert(Pow2Map::BUCKET_MAPPING == swoc::IntrusiveHashMapping::POWER_OF_2);
+
+  constexpr int N = 5000;
+  std::vector<std::string> keys;
+  std::vector<Thing *> things;
+  for (int i = 0; i < N; ++i) {
+    swoc::bwprint(keys.emplace_back(), "key-{}", i);
+  }
+
+  auto is_pow2 = [](size_t n) { return n && (n & (n - 1)) == 0; };
+  Pow2Map map;
+  REQUIRE(is_pow2(map.bucket_count()));
+  for (int i = 0; i < N; ++i) {
+    map.insert(things.emplace_back(new Thing(keys[i], i)));
+  }
+  REQUIRE(map.count() == N);
+  REQUIRE(map.bucket_count() > Pow2Map::DEFAULT_BUCKET_COUNT);
+  REQUIRE(is_pow2(map.bucket_count()));
+
+  bool miss_p = false;
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = map.find(keys[i]); spot == map.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(map.find("nothing"sv) == map.end());
+
+  // Incremental expansion works the same.
+  map.clear();
+  map.set_expansion_policy(Pow2Map::INCREMENTAL);
+  for (auto t : things) {
+    map.insert(t);
+  }
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = map.find(keys[i]); spot == map.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(is_pow2(map.bucket_count()));
+
+  map.clear();
+  for (auto t : things) {
+    delete t;
+  }
+
+  // The high bits of the hash must spread across buckets, or the table expands until every chain is short.
+  IntrusiveHashMap<ThingHighBitsDescriptor> hmap;
+  hmap.set_expansion_policy(decltype(hmap)::MAXIMUM);
+  std::vector<Thing> hthings;
+  hthings.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    hmap.insert(&hthings.emplace_back(keys[i], i));
+  }
+  REQUIRE(hmap.count() == N);
+  REQUIRE(hmap.bucket_count() <= N);
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = hmap.find(i); spot == hmap.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  hmap.clear();
+}
+
+TEST_CASE("ConcurrentIntrusiveHashMap", "[IntrusiveHashMap]")
+{
+  using CMap = swoc::ConcurrentIntrusiveHashMap<ThingMapDescriptor>;
+  REQUIRE(CMap(1).shard_count() == 1);
+  REQUIRE(CMap(5).shard_count() == 8);
+
+  constexpr unsigned N_THREADS = 4;
+  constexpr unsigned N         = 2000;
+  std::vector<std::string> keys;
+  for (unsigned i = 0; i < N; ++i) {
+    swoc::bwprint(keys.emplace_back(), "key-{}", i);
+  }
+  // Each thread has its own elements, two for each key.
+  std::vector<std::vector<Thing>> things(N_THREADS);
+  for (unsigned t = 0; t < N_THREADS; ++t) {
+    things[t].reserve(2 * N);
+    for (unsigned i = 0; i < 2 * N; ++i) {
+      things[t].emplace_back(keys[i % N], t);
+    }
+  }
+
+  CMap map;
+  std::atomic<bool> ok_p{true};
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < N_THREADS; ++t) {
+    threads.emplace_back([&, t]() {
+      for (auto &thing : things[t]) {
+        map.insert(&thing);
+        if (map.find(thing._payload) == nullptr) {
+          ok_p = false;
+        }
+      }
+      // Remove half of the elements from this thread.
+      for (unsigned i = 0; i < N; ++i) {
+        if (!map.erase(&things[t][i])) {
+          ok_p = false;
+        }
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  REQUIRE(ok_p);
+  REQUIRE(map.count() == N_THREADS * N);
+
+  // Every key should have one element from each thread.
+  bool miss_p = false;
+  for (auto const &key : keys) {
+    std::bitset<N_THREADS> seen;
+    if (map.equal_range(key, [&](Thing &thing) { seen[thing._n] = true; }) != N_THREADS || !seen.all()) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+
+  size_t n = 0;
+  for (size_t idx = 0; idx < map.shard_count(); ++idx) {
+    auto shard = map.lock(idx);
+    for (auto &thing : *shard) {
+      miss_p = miss_p || map.shard_for(thing._payload) != idx;
+      ++n;
+    }
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(n == map.count());
+
+  // Threads taking elements must not get the same one.
+  std::atomic<unsigned> taken{0};
+  threads.clear();
+  for (unsigned t = 0; t < N_THREADS; ++t) {
+    threads.emplace_back([&]() {
+      for (auto const &key : keys) {
+        while (Thing *thing = map.take(key)) {
+          if (thing->_payload != key || thing->_next == reinterpret_cast<Thing *>(1)) {
+            ok_p = false;
+          }
+          thing->_next = reinterpret_cast<Thing *>(1); // mark as taken.
+          ++taken;
+        }
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  REQUIRE(ok_p);
+  REQUIRE(taken == N_THREADS * N);
+  REQUIRE(map.count() == 0);
+}
+
+TEST_CASE("ConcurrentIntrusiveHashMap Power of 2", "[IntrusiveHashMap]")
+{
+  // The elements of a shard must be spread over the buckets of the shard map.
+  using CMap         = swoc::ConcurrentIntrusiveHashMap<ThingPow2Descriptor>;
+  constexpr size_t N = 100000;
+  std::vector<Thing> things;
+  things.reserve(N);
+  CMap map(16);
+  std::string key;
+  for (size_t i = 0; i < N; ++i) {
+    map.insert(&things.emplace_back(swoc::bwprint(key, "key-{}", i)));
+  }
+  REQUIRE(map.count() == N);
+
+  for (size_t idx = 0; idx < map.shard_count(); ++idx) {
+    auto shard = map.lock(idx);
+    size_t n   = shard->bucket_count();
+    std::set<size_t> buckets;
+    for (auto &thing : *shard) {
+      buckets.insert(Pow2Index::index_of(thing._payload, n));
+    }
+    REQUIRE(shard->count() > 0);
+    REQUIRE(buckets.size() > std::min(n, shard->count()) / 2);
+  }
+}
+
 TEST_CASE("IntrusiveHashMap Utilities", "[IntrusiveHashMap]") {
 }
@@ -5,6 +5,9 @@
     Lexicon unit tests.
 */
 
+#include <string>
+#include <vector>
+
 #include "swoc/Lexicon.h"
 #include "catch.hpp"
 
@@ -200,3 +203,68 @@ TEST_CASE("Lexicon Constructor 2", "[libts][Lexicon]")
   REQUIRE(v5["q"] == INVALID);
   REQUIRE(v5[C] == "Invalid");
 }
+
+TEST_CASE("Lexicon Freeze", "[libts][Lexicon]")
+{
+  ExampleNames exnames{{Example::Value_0, {"zero", "0"}},
+                       {Example::Value_1, {"one", "1"}},
+                       {Example::Value_2, {"two", "2"}},
+                       {Example::Value_3, {"three", "3"}}};
+  exnames.set_default(Example::INVALID).set_default("INVALID");
+  REQUIRE(exnames.is_frozen() == false);
+  exnames.freeze();
+  REQUIRE(exnames.is_frozen() == true);
+
+  REQUIRE(exnames[Example::Value_0] == "zero");
+  REQUIRE(exnames[Example::Value_3] == "three");
+  REQUIRE(exnames[Example::INVALID] == "INVALID");
+  REQUIRE(exnames[static_cast<Example>(0xBADD00D)] == "INVALID");
+  REQUIRE(exnames[static_cast<Example>(-1)] == "INVALID");
+  REQUIRE(exnames["zero"] == Example::Value_0);
+  REQUIRE(exnames["ZeRo"] == Example::Value_0);
+  REQUIRE(exnames["2"] == Example::Value_2);
+  REQUIRE(exnames["THREE"] == Example::Value_3);
+  REQUIRE(exnames["Evil Dave"] == Example::INVALID);
+  REQUIRE(exnames[""] == Example::INVALID);
+  REQUIRE(exnames["zer"] == Example::INVALID);
+
+  ExampleNames const frozen = ExampleNames{{Example::Value_0, "zero"}, {Example::Value_1, "one"}}.freeze();
+  REQUIRE(frozen.is_frozen());
+  REQUIRE(frozen["ONE"] == Example::Value_1);
+  REQUIRE(frozen[Example::Value_0] == "zero");
+
+  // A failed define leaves the lexicon frozen and unchanged.
+  REQUIRE_THROWS_AS(exnames.define(Example::INVALID, "four", "TWO"), std::invalid_argument);
+  REQUIRE_THROWS_AS(exnames.define(Example::INVALID, "four", "Four"), std::invalid_argument);
+  REQUIRE(exnames.is_frozen() == true);
+  REQUIRE(exnames["four"] == Example::INVALID);
+  REQUIRE(exnames["two"] == Example::Value_2);
+
+  // Defining more names thaws.
+  exnames.define(Example::INVALID, "invalid");
+  REQUIRE(exnames.is_frozen() == false);
+  REQUIRE(exnames["invalid"] == Example::INVALID);
+  REQUIRE(exnames[Example::INVALID] == "invalid");
+
+  // Sparse values, and enough names that building the perfect hash has to work at it.
+  swoc::Lexicon<int> lex("none");
+  std::vector<std::string> names;
+  for (int i = 0; i < 2000; ++i) {
+    names.emplace_back(std::to_string(i * 1000) + "-name");
+  }
+  for (int i = 0; i < 2000; ++i) {
+    lex.define(i * 1000, names[i]);
+  }
+  lex.freeze();
+  REQUIRE(lex.is_frozen());
+  bool ok_p = true;
+  for (int i = 0; i < 2000; ++i) {
+    if (lex[i * 1000] != names[i] || lex[names[i]] != i * 1000) {
+      ok_p = false;
+    }
+  }
+  REQUIRE(ok_p);
+  REQUIRE(lex[1] == "none");
+  REQUIRE(lex[-1000] == "none");
+  REQUIRE_THROWS_AS(lex["nothing"], std::domain_error);
+}
@@ -20,7 +20,11 @@
 
 #include <string_view>
 #include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
 #include "swoc/MemArena.h"
+#include "swoc/ConcurrentMemArena.h"
 #include "swoc/TextView.h"
 #include "catch.hpp"
 
@@ -389,3 +393,161 @@ TEST_CASE("FixedArena", "[libswoc][FixedArena]") {
   three = fa.make();
   REQUIRE(two == three);
 };
+
+TEST_CASE("ConcurrentMemArena", "[libswoc][MemArena][concurrent]") {
+  static constexpr unsigned N_THREADS = 4;
+  static constexpr unsigned N_ALLOCS  = 20000;
+  swoc::ConcurrentMemArena arena{4096, 64};
+
+  // Each thread fills its allocations with its own tag and checks them after all threads are done.
+  std::vector<std::vector<MemSpan<char>>> spans(N_THREADS);
+  auto worker = [&](unsigned tag) {
+    std::minstd_rand rng(tag);
+    auto& mine = spans[tag];
+    for (unsigned idx = 0; idx < N_ALLOCS; ++idx) {
+      auto span = arena.alloc_span<char>(1 + rng() % (idx % 1000 == 0 ? 8192 : 96));
+      memset(span.data(), 'A' + tag, span.size());
+      mine.push_back(span);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned tag = 0; tag < N_THREADS; ++tag) {
+    threads.emplace_back(worker, tag);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  size_t total = 0;
+  for (unsigned tag = 0; tag < N_THREADS; ++tag) {
+    for (auto const& span : spans[tag]) {
+      total += span.size();
+      REQUIRE(arena.contains(span.data()));
+      REQUIRE(std::all_of(span.begin(), span.end(), [=](char c) { return c == char('A' + tag); }));
+    }
+  }
+  REQUIRE(arena.size() == total);
+  REQUIRE(arena.reserved_size() >= total);
+  REQUIRE(arena.pool().stats()._blocks == 0);
+  REQUIRE(arena.block_size() == MemArena::BlockPool::class_size(1));
+  int local;
+  REQUIRE_FALSE(arena.contains(&local));
+
+  // Frozen memory stays valid until thawed, then its blocks are reused.
+  auto first = spans[0][0];
+  arena.freeze();
+  REQUIRE(arena.size() == 0);
+  REQUIRE(arena.allocated_size() == total);
+  REQUIRE(arena.contains(first.data()));
+  auto thing = arena.make<std::pair<int, int>>(56, 3);
+  REQUIRE(thing->first == 56);
+  REQUIRE(arena.size() == sizeof(*thing));
+  arena.thaw();
+  REQUIRE(arena.allocated_size() == sizeof(*thing));
+  REQUIRE_FALSE(arena.contains(first.data()));
+  auto stats = arena.pool().stats();
+  REQUIRE(stats._blocks >= 64); // Capped by the pool size for each class.
+  REQUIRE(stats._drops > 0);
+  auto reserved = arena.reserved_size();
+  for (unsigned idx = 0; idx < 20 * 4096 / 64; ++idx) {
+    arena.alloc(64);
+  }
+  REQUIRE(arena.pool().stats()._hits >= stats._hits + 10); // Blocks came from the pool.
+  REQUIRE(arena.reserved_size() > reserved);
+
+  arena.discard();
+  REQUIRE(arena.size() == 0);
+  REQUIRE(arena.reserved_size() == arena.block_size());
+  arena.clear();
+  REQUIRE(arena.reserved_size() == 0);
+  REQUIRE(arena.allocated_size() == 0);
+
+  // Alternate among more arenas than a thread remembers, allocations must go to the right arena.
+  MemArena::BlockPool pool{16};
+  std::vector<std::unique_ptr<swoc::ConcurrentMemArena>> arenas;
+  for (unsigned idx = 0; idx <= swoc::ConcurrentMemArena::N_BINDINGS; ++idx) {
+    arenas.emplace_back(new swoc::ConcurrentMemArena{pool, 1024});
+  }
+  for (unsigned round = 0; round < 3; ++round) {
+    for (unsigned idx = 0; idx < arenas.size(); ++idx) {
+      for (unsigned k = 0; k <= idx; ++k) { // Vary the order of use.
+        auto span = arenas[idx]->alloc(16);
+        REQUIRE(arenas[idx]->contains(span.data()));
+        REQUIRE_FALSE(arenas[(idx + 1) % arenas.size()]->contains(span.data()));
+      }
+    }
+  }
+  for (unsigned idx = 0; idx < arenas.size(); ++idx) {
+    REQUIRE(arenas[idx]->size() == 3 * 16 * (idx + 1));
+  }
+}
+
+TEST_CASE("MemArena block pool", "[libswoc][MemArena][pool]") {
+  MemArena::BlockPool pool{4, 1 << 20};
+
+  // Size classes are powers of two pages, including the block header.
+  REQUIRE(MemArena::BlockPool::class_size(0) < 4096);
+  REQUIRE(MemArena::BlockPool::class_size(1) > 4096);
+  REQUIRE(MemArena::BlockPool::class_size(1) < 8192);
+
+  // Blocks are reused across arena clear cycles.
+  MemArena arena{1000, &pool};
+  REQUIRE(arena.pool() == &pool);
+  arena.alloc(1000);
+  REQUIRE(arena.reserved_size() == MemArena::BlockPool::class_size(0));
+  REQUIRE(pool.stats()._misses == 1);
+  for (unsigned idx = 0; idx < 100; ++idx) {
+    arena.clear(1000);
+    auto span = arena.alloc(1000);
+    REQUIRE(arena.contains(span.data()));
+  }
+  auto stats = pool.stats();
+  REQUIRE(stats._misses == 1);
+  REQUIRE(stats._hits == 100);
+  REQUIRE(stats._returns == 100);
+  REQUIRE(stats._blocks == 0);
+
+  // Freezing and thawing returns the frozen blocks.
+  arena.freeze();
+  arena.alloc(5000);
+  arena.thaw();
+  REQUIRE(pool.stats()._blocks == 1);
+  REQUIRE(pool.stats()._bytes == MemArena::BlockPool::class_size(0));
+
+  // The number of blocks in a class is capped.
+  {
+    MemArena::BlockPool::Stats before = pool.stats();
+    std::vector<MemArena> arenas(8);
+    for (auto& a : arenas) {
+      a = MemArena{100, &pool};
+      a.alloc(100);
+    }
+    arenas.clear();
+    stats = pool.stats();
+    REQUIRE(stats._blocks == 4);
+    REQUIRE(stats._drops == before._drops + 4);
+  }
+
+  // The memory is capped.
+  {
+    MemArena a{200000, &pool};
+    MemArena b{200000, &pool};
+    MemArena c{600000, &pool};
+    a.alloc(1);
+    b.alloc(1);
+    c.alloc(1);
+  }
+  stats = pool.stats();
+  REQUIRE(stats._bytes <= (1 << 20));
+
+  // Too large for any class.
+  {
+    MemArena big{0, &pool};
+    big.alloc(MemArena::BlockPool::class_size(MemArena::BlockPool::N_CLASSES - 1) + 1);
+    REQUIRE(big.reserved_size() > MemArena::BlockPool::class_size(MemArena::BlockPool::N_CLASSES - 1));
+  }
+  REQUIRE(pool.stats()._drops == stats._drops + 1);
+
+  pool.clear();
+  REQUIRE(pool.stats()._blocks == 0);
+  REQUIRE(pool.stats()._bytes == 0);
+}
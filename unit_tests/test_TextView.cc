@@ -18,10 +18,14 @@
     limitations under the License.
 */
 
+#include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
+#include <cstdlib>
+#include <cstring>
 
 #include "swoc/TextView.h"
 #include "catch.hpp"
@@ -104,6 +108,102 @@ TEST_CASE("TextView Find", "[libswoc][TextView]")
   REQUIRE(addr.rfind('.') == 10);
 }
 
+TEST_CASE("TextView Delimiter Search", "[libswoc][TextView]")
+{
+  // Check every position over a range of sizes to cover full, partial, and overlapped blocks, with
+  // delimiter sets that are and are not small enough to vectorize.
+  std::string_view const sets[] = {"\xff", ",;", " \t\r\n", "=,;: \t\r\n", "0123456789", "abcdefghijklmnopqrstuvwxyz"};
+  std::string text;
+  bool ok_p = true;
+  for (auto delimiters : sets) {
+    swoc::CharSet const set{delimiters};
+    char const mark  = delimiters[delimiters.size() / 2];
+    char const other = '~';
+    for (size_t n = 0; n <= 100; ++n) {
+      for (size_t pos = 0; pos <= n; ++pos) {
+        // One delimiter in other text.
+        text.assign(n, other);
+        if (pos < n) {
+          text[pos] = mark;
+        }
+        std::string_view sv{text};
+        auto first = sv.find_first_of(delimiters);
+        auto last  = sv.find_last_of(delimiters);
+        ok_p       = ok_p && TextView(sv).prefix_at(delimiters) == (first == sv.npos ? ""sv : sv.substr(0, first));
+        ok_p       = ok_p && TextView(sv).suffix_at(delimiters) == (last == sv.npos ? ""sv : sv.substr(last + 1));
+        ok_p       = ok_p && TextView(sv).take_prefix_at(delimiters) == sv.substr(0, first);
+        ok_p       = ok_p && TextView(sv).take_suffix_at(delimiters) == (last == sv.npos ? sv : sv.substr(last + 1));
+        ok_p       = ok_p && TextView(sv).suffix_at(mark) == (last == sv.npos ? ""sv : sv.substr(last + 1));
+        ok_p       = ok_p && TextView(sv).find_if(set) == first && TextView(sv).rfind_if(set) == last;
+        ok_p       = ok_p && TextView(sv).take_prefix_at(set) == sv.substr(0, first);
+        ok_p       = ok_p && TextView(sv).split_suffix_at(set) == (last == sv.npos ? ""sv : sv.substr(last + 1));
+
+        // One other character in delimiters.
+        for (size_t i = 0; i < n; ++i) {
+          text[i] = delimiters[i % delimiters.size()];
+        }
+        if (pos < n) {
+          text[pos] = other;
+        }
+        first = sv.find_first_not_of(delimiters);
+        last  = sv.find_last_not_of(delimiters);
+        ok_p  = ok_p && TextView(sv).ltrim(delimiters) == (first == sv.npos ? ""sv : sv.substr(first));
+        ok_p  = ok_p && TextView(sv).rtrim(delimiters) == (last == sv.npos ? ""sv : sv.substr(0, last + 1));
+        ok_p  = ok_p && TextView(sv).trim(delimiters) == (first == sv.npos ? ""sv : sv.substr(first, last + 1 - first));
+        ok_p  = ok_p && TextView(sv).trim(set) == (first == sv.npos ? ""sv : sv.substr(first, last + 1 - first));
+        if (delimiters.size() == 1) {
+          ok_p = ok_p && TextView(sv).ltrim(mark) == (first == sv.npos ? ""sv : sv.substr(first));
+          ok_p = ok_p && TextView(sv).rtrim(mark) == (last == sv.npos ? ""sv : sv.substr(0, last + 1));
+        }
+      }
+    }
+  }
+  REQUIRE(ok_p);
+
+  TextView line{"alpha=1, bravo= 2,charlie = 3,  delta =4  ,echo ,, ,foxtrot=6"};
+  REQUIRE(line.take_prefix_at(",;") == "alpha=1");
+  REQUIRE(line.ltrim(" \t") == "bravo= 2,charlie = 3,  delta =4  ,echo ,, ,foxtrot=6");
+  REQUIRE(line.split_suffix_at(",;") == "foxtrot=6");
+  REQUIRE(TextView(line).ltrim("") == line);
+  REQUIRE(TextView(line).take_prefix_at("") == line);
+}
+
+TEST_CASE("TextView CharSet", "[libswoc][TextView]")
+{
+  static constexpr swoc::CharSet Space{" \t"};
+  static constexpr swoc::CharSet Sep{",;"};
+  static_assert(Space.contains(' ') && Space('\t') && !Space.contains(','));
+  static_assert(swoc::CharSet{}.add('\x80').contains('\x80'));
+  static_assert(!swoc::CharSet{}.add('\x80').contains('\0'));
+
+  TextView line{"alpha=1, bravo= 2,charlie = 3,  delta =4  ,echo ,, ,foxtrot=6"};
+  REQUIRE(line.take_prefix_at(Sep) == "alpha=1");
+  REQUIRE(line.ltrim(Space) == "bravo= 2,charlie = 3,  delta =4  ,echo ,, ,foxtrot=6");
+  REQUIRE(line.split_suffix_at(Sep) == "foxtrot=6");
+  REQUIRE(TextView(line).remove_prefix_at(Sep).prefix_at(Sep) == "charlie = 3");
+  REQUIRE(TextView(line).remove_suffix_at(Sep).suffix_at(Sep) == "");
+  REQUIRE(TextView(line).take_suffix_at(Sep) == " ");
+  REQUIRE(TextView(line).take_prefix_if(Sep) == "bravo= 2");
+  REQUIRE(TextView("  \tvalue ").ltrim_if(Space) == "value ");
+
+  // Every character, in and out of the set.
+  swoc::CharSet odd;
+  for (int c = 1; c < 256; c += 2) {
+    odd.add(char(c));
+  }
+  std::string text;
+  for (int c = 0; c < 256; ++c) {
+    text += char(c);
+  }
+  bool ok_p = true;
+  for (size_t n = 0; n < text.size(); ++n) {
+    TextView tv{text.data() + n, text.size() - n};
+    ok_p = ok_p && tv.find_if(odd) == (n % 2 ? 0 : 1);
+    ok_p = ok_p && tv.rfind_if(odd) == tv.size() - 1;
+  }
+  REQUIRE(ok_p);
+}
+
 TEST_CASE("TextView Affixes", "[libswoc][TextView]")
 {
   TextView s; // scratch.
@@ -425,6 +525,147 @@ TEST_CASE("TextView Conversions", "[libswoc][TextView]")
   REQUIRE(true == fcmp(6.789e5, swoc::svtod("6.789E+5")));
 }
 
+TEST_CASE("TextView Conversions Checked", "[libswoc][TextView]")
+{
+  using swoc::svtoi_checked;
+  using swoc::svtou_checked;
+  using swoc::svto_radix_checked;
+
+  auto u = svtou_checked("  18446744073709551615 rest");
+  REQUIRE(u);
+  REQUIRE(u.value == std::numeric_limits<uintmax_t>::max());
+  REQUIRE(u.parsed == "18446744073709551615");
+  u = svtou_checked("18446744073709551616");
+  REQUIRE(u.error == std::errc::result_out_of_range);
+  REQUIRE(u.value == std::numeric_limits<uintmax_t>::max());
+  REQUIRE(u.parsed.size() == 20);
+  u = svtou_checked("000000000000000000000000000000042");
+  REQUIRE(u.value == 042);
+  u = svtou_checked("00000000000000000000000000000004200", 10);
+  REQUIRE(u.value == 4200);
+  REQUIRE(u.parsed.size() == 35);
+  u = svtou_checked("0xFFFFffffFFFFffff");
+  REQUIRE(u.value == std::numeric_limits<uintmax_t>::max());
+  REQUIRE(u.parsed.size() == 18);
+  u = svtou_checked("0x1FFFFffffFFFFffff");
+  REQUIRE(u.error == std::errc::result_out_of_range);
+  u = svtou_checked("0");
+  REQUIRE(u);
+  REQUIRE(u.parsed == "0");
+  u = svtou_checked("zz", 36);
+  REQUIRE(u.value == 36 * 35 + 35);
+  REQUIRE(svtou_checked("tT", 36).value == 29 * 36 + 29);
+  REQUIRE(svtou_checked("  ").error == std::errc::invalid_argument);
+  REQUIRE(svtou_checked("12", 37).error == std::errc::invalid_argument);
+  REQUIRE(svtou_checked("-12").error == std::errc::invalid_argument);
+
+  auto i = svtoi_checked("-9223372036854775808");
+  REQUIRE(i);
+  REQUIRE(i.value == std::numeric_limits<intmax_t>::min());
+  i = svtoi_checked("-9223372036854775809");
+  REQUIRE(i.error == std::errc::result_out_of_range);
+  REQUIRE(i.value == std::numeric_limits<intmax_t>::min());
+  i = svtoi_checked("+9223372036854775808");
+  REQUIRE(i.error == std::errc::result_out_of_range);
+  REQUIRE(i.value == std::numeric_limits<intmax_t>::max());
+  REQUIRE(i.parsed.size() == 20);
+  i = svtoi_checked(" -0x7f,");
+  REQUIRE(i.value == -127);
+  REQUIRE(i.parsed == "-0x7f");
+  REQUIRE(svtoi_checked("-").error == std::errc::invalid_argument);
+  REQUIRE(svtoi_checked("-0").value == 0);
+  REQUIRE(swoc::svtoi("-9999999999999999999999") == std::numeric_limits<intmax_t>::min());
+
+  // Every length and digit position, with the digits followed by other text.
+  std::string text;
+  bool ok_p = true;
+  for (int k = 0; k < 2000; ++k) {
+    uint64_t value = (uint64_t(k) * 0x9E3779B97F4A7C15ULL) >> (k % 64);
+    for (int radix : {10, 16}) {
+      char buff[32];
+      snprintf(buff, sizeof(buff), radix == 10 ? "%llu" : (k % 2 ? "%llx" : "%llX"), static_cast<unsigned long long>(value));
+      text = buff;
+      text += "g 123";
+      auto n = radix == 10 ? svto_radix_checked<10>(text) : svto_radix_checked<16>(text);
+      ok_p   = ok_p && n && n.value == value && n.parsed == std::string_view(buff);
+    }
+  }
+  REQUIRE(ok_p);
+}
+
+TEST_CASE("TextView Floating Point", "[libswoc][TextView]")
+{
+  using swoc::svtod;
+  using swoc::svtod_checked;
+
+  // Results must be the closest double, which is bitwise identical to @c strtod.
+  auto same = [](std::string const &text) {
+    double lhs = svtod(text);
+    double rhs = strtod(text.c_str(), nullptr);
+    return 0 == memcmp(&lhs, &rhs, sizeof(double));
+  };
+
+  TextView parsed;
+  REQUIRE(0.1 == svtod("0.1"));
+  REQUIRE(-2.5e-3 == svtod("-2.5e-3 rest", &parsed));
+  REQUIRE(parsed == "-2.5e-3");
+  REQUIRE(12.0 == svtod("12e", &parsed));
+  REQUIRE(parsed == "12");
+  REQUIRE(12.0 == svtod("12.e+z", &parsed));
+  REQUIRE(parsed == "12.");
+  REQUIRE(0.0 == svtod(".e1", &parsed));
+  REQUIRE(parsed.empty());
+
+  auto d = svtod_checked("1.5e1x");
+  REQUIRE(d);
+  REQUIRE(d.value == 15.0);
+  REQUIRE(d.parsed == "1.5e1");
+  d = svtod_checked("-");
+  REQUIRE(!d);
+  REQUIRE(d.error == std::errc::invalid_argument);
+  REQUIRE(svtod_checked("-0.000e-9999").error == std::errc{});
+  d = svtod_checked("1e309");
+  REQUIRE(d.error == std::errc::result_out_of_range);
+  REQUIRE(d.value == std::numeric_limits<double>::infinity());
+  d = svtod_checked("-1e-400");
+  REQUIRE(d.error == std::errc::result_out_of_range);
+  REQUIRE(d.value == 0.0);
+  REQUIRE(std::signbit(d.value));
+
+  // Boundaries and values that are close to halfway between two doubles.
+  std::string long_half = "9007199254740993";
+  std::string long_tie  = "2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125";
+  for (std::string text :
+       {"9007199254740993"s, "0.1000000000000000055511151231257827021181583404541015625"s, "2.2250738585072011e-308"s,
+        "2.2250738585072014e-308"s, "1.7976931348623158e308"s, "1.7976931348623159e308"s, "4.9406564584124654e-324"s,
+        "2.4703282292062327e-324"s, "2.4703282292062328e-324"s, "7.2057594037927933e16"s, "123456789012345678901234567890"s,
+        "0.000000000000000000000000000000000000001"s, "1e-5000"s, "1e5000"s, "00000000000000000000001.5"s, long_tie,
+        long_tie + "000000000000001", long_half + "." + std::string(900, '0'), long_half + std::string(900, '0') + "1e-900"}) {
+    INFO(text);
+    REQUIRE(same(text));
+  }
+
+  // Random doubles, at full and reduced precision, and random digit strings.
+  std::mt19937_64 rng(23);
+  bool ok_p = true;
+  char buff[64];
+  for (int i = 0; i < 20000 && ok_p; ++i) {
+    uint64_t bits = rng();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value)) {
+      continue;
+    }
+    snprintf(buff, sizeof(buff), "%.*g", 1 + i % 17, value);
+    if ((ok_p = same(buff))) {
+      snprintf(buff, sizeof(buff), "%llue%d", static_cast<unsigned long long>(rng() >> (i % 64)), int(rng() % 700) - 350);
+      ok_p = same(buff);
+    }
+  }
+  INFO(buff);
+  REQUIRE(ok_p);
+}
+
 TEST_CASE("TransformView", "[libswoc][TransformView]")
 {
   std::string_view source{"Evil Dave Rulz"};
@@ -7,6 +7,7 @@
 #include <chrono>
 #include <iostream>
 #include <variant>
+#include <vector>
 
 #include <netinet/in.h>
 
@@ -348,6 +349,54 @@ TEST_CASE("BWFormat integral", "[bwprint][bwformat]") {
   REQUIRE(bw.view() == "ax == 1");
 }
 
+TEST_CASE("BWFormat integer conversion", "[bwprint][bwformat]") {
+  std::vector<uint64_t> values{0, std::numeric_limits<uint64_t>::max()};
+  for (uint64_t p = 1; p <= std::numeric_limits<uint64_t>::max() / 10; p *= 10) {
+    values.insert(values.end(), {p - 1, p, p + 1, p * 10 - 1});
+  }
+  for (unsigned b = 0; b < 64; ++b) {
+    uint64_t p = uint64_t(1) << b;
+    values.insert(values.end(), {p - 1, p, p + 1});
+  }
+  uint64_t x = 0x9E3779B97F4A7C15ULL;
+  for (int i = 0; i < 1000; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    values.push_back(x >> (i % 64));
+  }
+
+  // Compare output with @c snprintf.
+  swoc::LocalBufferWriter<128> bw;
+  char buff[128];
+  bool ok_p = true;
+  auto check = [&](TextView fmt, char const *c_fmt, auto v) {
+    bw.clear().print(fmt, v);
+    snprintf(buff, sizeof(buff), c_fmt, v);
+    if (bw.view() != std::string_view(buff)) {
+      ok_p = false;
+      FAIL(bw.view() << " != " << buff);
+    }
+  };
+  for (auto v : values) {
+    auto u = static_cast<unsigned long long>(v);
+    auto n = static_cast<long long>(v);
+    check("{}", "%llu", u);
+    check("{}", "%lld", n);
+    check("{:+}", "%+lld", n);
+    check("{:x}", "%llx", u);
+    check("{:X}", "%llX", u);
+    check("{:o}", "%llo", u);
+    check("{:>24}", "%24llu", u);
+    check("{:<24}", "%-24lld", n);
+    if (v) { // @c snprintf doesn't put the radix prefix on zero.
+      check("{:#x}", "%#llx", u);
+      check("{:>#24X}", "%#24llX", u);
+    }
+  }
+  REQUIRE(ok_p);
+}
+
 TEST_CASE("BWFormat floating", "[bwprint][bwformat]") {
   swoc::LocalBufferWriter<256> bw;
   swoc::bwf::Spec spec;
@@ -479,6 +528,103 @@ TEST_CASE("BWFormat floating", "[bwprint][bwformat]") {
   bw.clear();
 }
 
+TEST_CASE("BWFormat floating decimal", "[bwprint][bwformat]") {
+  swoc::LocalBufferWriter<1600> bw;
+
+  bw.print("{:e} {:f} {:E} {:F}", 0.1, 0.1, 1.5, 1.5);
+  REQUIRE(bw.view() == "1e-01 0.1 1.5E+00 1.5");
+  bw.clear().print("{:e} {:f} {:e} {:f}", 1e23, 1e21, 123.456, 123.456);
+  REQUIRE(bw.view() == "1e+23 1000000000000000000000 1.23456e+02 123.456");
+  bw.clear().print("{:e} {:e} {:f}", 5e-324, std::numeric_limits<double>::max(), 1e-7);
+  REQUIRE(bw.view() == "5e-324 1.7976931348623157e+308 0.0000001");
+  bw.clear().print("{:e} {:f} {:.2e} {:.3f}", 0.0, 0.0, 0.0, 0.0);
+  REQUIRE(bw.view() == "0e+00 0 0.00e+00 0.000");
+  bw.clear().print("{:e} {:f} {:.2E} {:.3F}", -0.0, -0.0, -0.0, -0.0);
+  REQUIRE(bw.view() == "-0e+00 -0 -0.00E+00 -0.000");
+  bw.clear().print("{:.0f} {:.0f} {:.1f} {:.2f} {:.3e}", 2.5, 3.5, 0.25, 1.005, 9.9996);
+  REQUIRE(bw.view() == "2 4 0.2 1.00 1.000e+01");
+  bw.clear().print("{:e} {:+f} {:.2f}", -2.5, 2.5, -0.001);
+  REQUIRE(bw.view() == "-2.5e+00 +2.5 -0.00");
+  bw.clear().print("|{:>8.2f}|{:<8.1e}|{:^8f}|{:0=8.2f}|", 3.14159, 3.14159, -1.5, -1.5);
+  REQUIRE(bw.view() == "|    3.14|3.1e+00 |  -1.5  |-0001.50|");
+  bw.clear().print("{:e} {:f} {:e}", std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::nan(""));
+  REQUIRE(bw.view() == "Inf -Inf NaN");
+  bw.clear().print("{:.20f}", 0.1);
+  REQUIRE(bw.view() == "0.10000000000000000555");
+  bw.clear().print("{:.1e} {:.0e} {:.2e} {:.15e} {:.14e}", 0.125, 2.5, 5e-324, 1e23, 1e23);
+  REQUIRE(bw.view() == "1.2e-01 2e+00 4.94e-324 9.999999999999999e+22 1.00000000000000e+23");
+  // Default formatting is not changed.
+  bw.clear().print("{} {:.3}", 32.7, 0.1234);
+  REQUIRE(bw.view() == "32.70 0.123");
+  // Before 'f' was a type it was ignored and the default format used. These outputs must not change.
+  bw.clear().print("{:.1f} {:.2f} {:.3f} {:.4f}", 3.14159, 3.14159, 3.14159, 3.14159);
+  REQUIRE(bw.view() == "3.1 3.14 3.142 3.1416");
+  bw.clear().print("{:.2f} {:.3f} {:.2f} {:.1f} {:.3f} {:.2f}", 123.456, 1234567.891, 0.5, 2.675, 99.999, 0.1);
+  REQUIRE(bw.view() == "123.46 1234567.891 0.50 2.7 99.999 0.10");
+  bw.clear().print("{:>8.2f}|{:+.3f}|{:.2f}", 2.5, 3.14159, -1.5);
+  REQUIRE(bw.view() == "    2.50|+3.142|-1.50");
+  // Precision past the exact value is filled with zeros.
+  std::string big;
+  std::vector<char> c_big(2100);
+  swoc::bwprint(big, "{:.2000f}", 0.1);
+  snprintf(c_big.data(), c_big.size(), "%.2000f", 0.1);
+  REQUIRE(big == c_big.data());
+  REQUIRE(big.find_first_not_of('0', 1100) == std::string::npos);
+  swoc::bwprint(big, "{:>2010.1100e}", -0.1);
+  snprintf(c_big.data(), c_big.size(), "%2010.1100e", -0.1);
+  REQUIRE(big == c_big.data());
+  REQUIRE(big.substr(big.size() - 8) == "0000e-01");
+
+  // Compare with @c printf and check the shortest output converts back.
+  uint64_t x = 0x9E3779B97F4A7C15ULL;
+  char buff[1600];
+  bool ok_p = true;
+  for (int i = 0; i < 20000 && ok_p; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    uint64_t bits = x & 0x7FFFFFFFFFFFFFFFULL;
+    if (i % 3 == 1) {
+      bits &= 0x000FFFFFFFFFFFFFULL; // subnormal
+    } else if (i % 3 == 2) {
+      bits &= 0x7FF0000000000000ULL; // power of 2
+    }
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    if (!std::isfinite(v)) {
+      continue;
+    }
+    int prec = i % 20;
+    bw.clear().print("{:e}", v);
+    if (strtod(std::string(bw.view()).c_str(), nullptr) != v) {
+      ok_p = false;
+      FAIL(bw.view() << " does not convert back");
+    }
+    bw.clear().print("{:f}", v);
+    if (strtod(std::string(bw.view()).c_str(), nullptr) != v) {
+      ok_p = false;
+      FAIL(bw.view() << " does not convert back");
+    }
+    swoc::bwf::Spec spec;
+    spec._prec = prec;
+    spec._type = 'e';
+    bwformat(bw.clear(), spec, v);
+    snprintf(buff, sizeof(buff), "%.*e", prec, v);
+    if (bw.view() != buff) {
+      ok_p = false;
+      FAIL(bw.view() << " != " << buff);
+    }
+    spec._type = 'f';
+    bwformat(bw.clear(), spec, v);
+    snprintf(buff, sizeof(buff), "%.*f", prec, v);
+    if (bw.view() != buff) {
+      ok_p = false;
+      FAIL(bw.view() << " != " << buff);
+    }
+  }
+  REQUIRE(ok_p);
+}
+
 TEST_CASE("bwstring std formats", "[libswoc][bwprint]") {
   std::string_view text{"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"};
   swoc::LocalBufferWriter<120> w;
@@ -506,6 +652,42 @@ TEST_CASE("bwstring std formats", "[libswoc][bwprint]") {
   REQUIRE(w.view() == "1528484137 is 2018 Jun 08 12:55:37");
   w.clear().print("{} is {::local}", t, swoc::bwf::Date(t, "%a, %d %b %Y at %H.%M.%S"));
   REQUIRE(w.view() == "1528484137 is Fri, 08 Jun 2018 at 12.55.37");
+  // Repeated output comes from the cache, check it tracks the time, format, and zone.
+  w.clear().print("{} {::local} {} {}", swoc::bwf::Date(t, "%H:%M"), swoc::bwf::Date(t, "%H:%M"), swoc::bwf::Date(t + 60, "%H:%M"),
+                  swoc::bwf::Date(t + 60, "%M:%H"));
+  REQUIRE(w.view() == "18:55 12:55 18:56 56:18");
+
+  using swoc::bwf::Timestamp;
+  w.clear().print("{} {} {}", Timestamp(t), Timestamp(t, Timestamp::HTTP), Timestamp(t, Timestamp::CLF));
+  REQUIRE(w.view() == "2018-06-08T18:55:37Z Fri, 08 Jun 2018 18:55:37 GMT 08/Jun/2018:18:55:37 +0000");
+  w.clear().print("{::local} {::local} {::local}", Timestamp(t), Timestamp(t, Timestamp::HTTP), Timestamp(t, Timestamp::CLF));
+  REQUIRE(w.view() == "2018-06-08T12:55:37-06:00 Fri, 08 Jun 2018 18:55:37 GMT 08/Jun/2018:12:55:37 -0600");
+  w.clear().print("{:d} {}", Timestamp(t), Timestamp(t + 1));
+  REQUIRE(w.view() == "1528484137 2018-06-08T18:55:38Z");
+  auto tp = std::chrono::system_clock::from_time_t(t) + std::chrono::microseconds(12345);
+  w.clear().print("{:.3} {:.6} {:.9} {:.3:local}", Timestamp(tp), Timestamp(tp), Timestamp(tp), Timestamp(tp, Timestamp::CLF));
+  REQUIRE(w.view() == "2018-06-08T18:55:37.012Z 2018-06-08T18:55:37.012345Z 2018-06-08T18:55:37.012345000Z 08/Jun/2018:12:55:37.012 -0600");
+  w.clear().print("{} {} {}", Timestamp(0), Timestamp(-1, Timestamp::HTTP), Timestamp(951782400));
+  REQUIRE(w.view() == "1970-01-01T00:00:00Z Wed, 31 Dec 1969 23:59:59 GMT 2000-02-29T00:00:00Z");
+  w.clear().print("|{:>24}|{:-<24}|{:^28.3}|{:,10}|", Timestamp(t), Timestamp(t), Timestamp(t), Timestamp(t));
+  REQUIRE(w.view() == "|    2018-06-08T18:55:37Z|2018-06-08T18:55:37Z----|  2018-06-08T18:55:37.000Z  |2018-06-08|");
+  // Too far out for local time, which falls back to GMT. @c strftime can't do it at all.
+  time_t far = time_t(1) << 60;
+  std::string gmt, local;
+  swoc::bwprint(gmt, "{}", Timestamp(far));
+  swoc::bwprint(local, "{::local}", Timestamp(far));
+  REQUIRE(local == gmt.substr(0, gmt.size() - 1) + "+00:00");
+  w.clear().print("{::local}", swoc::bwf::Date(far));
+  REQUIRE(w.view().empty());
+  // Check against strftime across a range of times.
+  for (time_t x = -100000000; x < 4000000000; x += 7777777) {
+    char buff[64];
+    struct tm tm;
+    gmtime_r(&x, &tm);
+    strftime(buff, sizeof(buff), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    w.clear().print("{}", Timestamp(x, Timestamp::HTTP));
+    REQUIRE(w.view() == buff);
+  }
 
   unsigned v = htonl(0xdeadbeef);
   w.clear().print("{}", swoc::bwf::As_Hex(v));
@@ -586,6 +768,58 @@ TEST_CASE("bwstring std formats", "[libswoc][bwprint]") {
   REQUIRE(w.view() == "Clone?.");
 };
 
+namespace {
+// Static format strings, paired with the expected output for the arguments used in the test.
+constexpr char SF_LITERAL[]  = "Some text";
+constexpr char SF_EMPTY[]    = "";
+constexpr char SF_ARGS[]     = "arg 1 {1} and 2 {2} and 0 {0}";
+constexpr char SF_BRACES[]   = "Arg {{{0}}} Arg {} {1} {} {0} and {{stuff}}";
+constexpr char SF_ALIGN[]    = "left >{0:<9}< right >{0:>9}< center >{0:^9}< {0:%3A^9}";
+constexpr char SF_NUMERIC[]  = "Format |{:#010x}| |{:>#010x}| |{:+.3f}| |{:-08d}| |{:#b}|";
+constexpr char SF_MAX[]      = "|{:.>10,3}| |{:,2x}| {:s} {:S}";
+constexpr char SF_NAME[]     = "{leif}-{}";
+constexpr char SF_BAD_ARGS[] = "{0} {} {}";
+
+/// Print with @a F both statically and dynamically and check the results are the same.
+template <char const *F, typename... Args>
+std::string
+static_print(Args&&... args) {
+  swoc::LocalBufferWriter<256> lhs, rhs;
+  lhs.print<F>(args...);
+  rhs.print(std::string_view{F}, args...);
+  return lhs.view() == rhs.view() ? std::string(lhs.view()) : "MISMATCH "s + std::string(lhs.view()) + " vs " + std::string(rhs.view());
+}
+} // namespace
+
+TEST_CASE("bwprint static format", "[bwprint][bwformat]")
+{
+  static_assert(swoc::bwf::StaticFormat<SF_LITERAL>::items.size() == 1);
+  static_assert(swoc::bwf::StaticFormat<SF_EMPTY>::items.size() == 0);
+  static_assert(swoc::bwf::StaticFormat<SF_BRACES>::items[1]._idx == 0);
+  static_assert(swoc::bwf::StaticFormat<SF_BRACES>::items[6]._idx == 1);
+  static_assert(swoc::bwf::StaticFormat<SF_NUMERIC>::items[1]._fill == '0');
+
+  REQUIRE(static_print<SF_LITERAL>() == "Some text");
+  REQUIRE(static_print<SF_EMPTY>(1).empty());
+  REQUIRE(static_print<SF_ARGS>("zero", "one", "two") == "arg 1 one and 2 two and 0 zero");
+  REQUIRE(static_print<SF_BRACES>(5, 6) == "Arg {5} Arg 5 6 6 5 and {stuff}");
+  REQUIRE(static_print<SF_ALIGN>(956) == "left >956      < right >      956< center >   956   < :::956:::");
+  REQUIRE(static_print<SF_NUMERIC>(-956, -956, 3.14159, 27, 5) == "Format |-0x00003bc| |0000-0x3bc| |+3.142| |00000027| |0b101|");
+  REQUIRE(static_print<SF_MAX>("text", 0x12345, "Evil Dave", "Evil Dave"sv) == "|...| |12| evil dave EVIL DAVE");
+  REQUIRE(static_print<SF_NAME>(1) == "{~leif~}-1");
+
+  // Extra arguments are ignored.
+  swoc::LocalBufferWriter<256> w;
+  REQUIRE(w.print<SF_BAD_ARGS>(1, 2, 3).view() == "1 1 2");
+  REQUIRE(w.clear().print_v<SF_ARGS>(std::make_tuple(0, 1, 2)).view() == "arg 1 1 and 2 2 and 0 0");
+
+  // Truncated output.
+  swoc::LocalBufferWriter<10> small;
+  small.print<SF_ARGS>("zero", "one", "two");
+  REQUIRE(small.view() == "arg 1 one ");
+  REQUIRE(small.extent() == 30);
+}
+
 // Normally there's no point in running the performance tests, but it's worth keeping the code
 // for when additional testing needs to be done.
 #if 0
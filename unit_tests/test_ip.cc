@@ -8,6 +8,13 @@
 #include "catch.hpp"
 
 #include <set>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <optional>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include "swoc/TextView.h"
 #include "swoc/swoc_ip.h"
@@ -15,6 +22,10 @@
 #include "swoc/bwf_std.h"
 #include "swoc/swoc_file.h"
 #include "swoc/Lexicon.h"
+#include "swoc/IPSnapshot.h"
+#include "swoc/IPTrie.h"
+#include "swoc/SharedIPSpace.h"
+#include "swoc/IPSpaceBuilder.h"
 
 using namespace std::literals;
 using namespace swoc::literals;
@@ -342,6 +353,12 @@ TEST_CASE("IP ranges and networks", "[libswoc][ip][net][range]") {
 
   swoc::IP6Addr a_1{"2001:1f2d:c587:24c4::"};
   CHECK(a_1 == (a_1 & swoc::IPMask{62}));
+  // Masks at the word boundaries.
+  swoc::IP6Addr a_2{"2001:1f2d:c587:24c4:9128:3349:3cee:143"};
+  CHECK(swoc::IP6Addr{"2001:1f2d:c587:24c4::"} == (a_2 & swoc::IPMask{64}));
+  CHECK(swoc::IP6Addr{"::"} == (a_2 & swoc::IPMask{0}));
+  CHECK(a_2 == (a_2 & swoc::IPMask{128}));
+  CHECK(swoc::IP6Addr{"2001:1f2d:c587:24c4:ffff:ffff:ffff:ffff"} == (a_2 | swoc::IPMask{64}));
 
   std::array<swoc::IP4Net, 7> r_4_nets =
       {{
@@ -1577,3 +1594,897 @@ TEST_CASE("IPSpace skew overlap blend", "[libswoc][ipspace][blend][skew]") {
     ++idx;
   }
 }
+
+TEST_CASE("IPFlatSpace", "[libswoc][ipspace][flat]") {
+  using Space = swoc::IPSpace<unsigned>;
+  using Flat = swoc::IPFlatSpace<unsigned>;
+
+  Space space;
+  Flat empty_flat{space};
+  REQUIRE(empty_flat.count() == 0);
+  REQUIRE(empty_flat.begin() == empty_flat.end());
+  REQUIRE(empty_flat.find(IPAddr{"172.16.0.1"}) == empty_flat.end());
+
+  // Lots of ranges with gaps, so there are hits, misses and edges to check.
+  std::vector<IP4Addr> a4;
+  std::vector<IP6Addr> a6;
+  unsigned color = 0;
+  for (in_addr_t base = 0x0A000000; base < 0x0A400000; base += 0x1000) {
+    IP4Addr min{base}, max{base + 0x7FF};
+    space.mark(IP4Range{min, max}, ++color);
+    a4.push_back(min);
+    a4.push_back(max);
+    a4.push_back(--IP4Addr(min));
+    a4.push_back(++IP4Addr(max));
+  }
+  IP6Addr a6_base{"2001:db8::"};
+  for (unsigned idx = 0; idx < 1023; ++idx) {
+    IP6Addr min{a6_base};
+    IP6Addr max{min};
+    for (unsigned k = 0; k < 15; ++k) {
+      ++max;
+    }
+    space.mark(IP6Range{min, max}, ++color);
+    a6.push_back(min);
+    a6.push_back(max);
+    a6.push_back(--IP6Addr(min));
+    a6.push_back(++IP6Addr(max));
+    // Leave a gap before the next range.
+    a6_base = max;
+    for (unsigned k = 0; k < 17; ++k) {
+      ++a6_base;
+    }
+  }
+  // Add some edge cases.
+  space.mark(IPRange{"0.0.0.0-0.0.0.10"}, 99999);
+  space.mark(IPRange{"255.255.255.200-255.255.255.255"}, 99998);
+  a4.push_back(IP4Addr{"0.0.0.0"});
+  a4.push_back(IP4Addr{"255.255.255.255"});
+  a4.push_back(IP4Addr{"128.0.0.1"});
+
+  Flat flat{space};
+  REQUIRE(flat.count() == space.count());
+  REQUIRE(flat.count_ip4() == space.count_ip4());
+  REQUIRE(flat.count_ip6() == space.count_ip6());
+
+  // Iteration must yield the same ranges in the same order.
+  auto spot = space.begin();
+  for (auto const& [r, p] : flat) {
+    REQUIRE(spot != space.end());
+    REQUIRE(r == std::get<0>(*spot));
+    REQUIRE(p == std::get<1>(*spot));
+    ++spot;
+  }
+  REQUIRE(spot == space.end());
+
+  // Reverse iteration.
+  auto fspot = flat.end();
+  size_t n = 0;
+  while (fspot != flat.begin()) {
+    --fspot;
+    ++n;
+  }
+  REQUIRE(n == flat.count());
+
+  for (auto const& addr : a4) {
+    auto s = space.find(addr);
+    auto f = flat.find(addr);
+    REQUIRE((s == space.end()) == (f == flat.end()));
+    if (s != space.end()) {
+      REQUIRE(std::get<0>(*s) == std::get<0>(*f));
+      REQUIRE(std::get<1>(*s) == std::get<1>(*f));
+    }
+    REQUIRE((s == space.end()) == (flat.find(IPAddr{addr}) == flat.end()));
+  }
+
+  for (auto const& addr : a6) {
+    auto s = space.find(addr);
+    auto f = flat.find(addr);
+    REQUIRE((s == space.end()) == (f == flat.end()));
+    if (s != space.end()) {
+      REQUIRE(std::get<0>(*s) == std::get<0>(*f));
+      REQUIRE(std::get<1>(*s) == std::get<1>(*f));
+    }
+  }
+
+  // Non-trivial payload, to check construction and destruction.
+  swoc::IPSpace<std::string> sspace;
+  sspace.mark(IPRange{"10.1.0.0/16"}, "alpha");
+  sspace.mark(IPRange{"10.3.0.0/16"}, "bravo");
+  sspace.mark(IPRange{"1337::/64"}, "charlie");
+  swoc::IPFlatSpace<std::string> sflat{sspace};
+  REQUIRE(sflat.count() == 3);
+  REQUIRE(sflat.find(IPAddr{"10.2.0.1"}) == sflat.end());
+  REQUIRE(std::get<1>(*sflat.find(IPAddr{"10.3.0.1"})) == "bravo");
+  REQUIRE(std::get<1>(*sflat.find(IPAddr{"1337::ded:beef"})) == "charlie");
+  swoc::IPFlatSpace<std::string> sflat2{std::move(sflat)};
+  REQUIRE(std::get<1>(*sflat2.find(IPAddr{"10.1.255.255"})) == "alpha");
+  REQUIRE(sflat.count() == 0);
+  REQUIRE(sflat.find(IPAddr{"10.3.0.1"}) == sflat.end());
+
+  // Payload that is not default constructible.
+  struct Tag {
+    explicit Tag(int n) : _n(n) {}
+    bool operator==(Tag const& that) const { return _n == that._n; }
+    int _n;
+  };
+  swoc::IPSpace<Tag> tspace;
+  tspace.mark(IPRange{"10.1.0.0/16"}, Tag{1});
+  tspace.mark(IPRange{"10.3.0.0/16"}, Tag{3});
+  swoc::IPFlatSpace<Tag> tflat{tspace};
+  REQUIRE(tflat.count() == 2);
+  REQUIRE(std::get<1>(*tflat.find(IPAddr{"10.3.0.1"}))._n == 3);
+}
+
+TEST_CASE("IPSpace batch find", "[libswoc][ipspace][batch]") {
+  using Space = swoc::IPSpace<unsigned>;
+  using swoc::MemSpan;
+
+  Space space;
+  std::vector<IP4Addr> a4;
+  std::vector<IP6Addr> a6;
+  std::vector<IPAddr> addrs;
+  unsigned color = 0;
+
+  // Empty space, nothing found.
+  addrs.emplace_back("172.16.0.1");
+  addrs.emplace_back("2001:db8::1");
+  std::vector<Space::iterator> results(addrs.size());
+  REQUIRE(0 == space.find(MemSpan<IPAddr const>{addrs.data(), addrs.size()}, MemSpan<Space::iterator>{results.data(), results.size()}));
+  REQUIRE(results[0] == space.end());
+  REQUIRE(results[1] == space.end());
+  addrs.clear();
+
+  for (in_addr_t base = 0x0A000000; base < 0x0A100000; base += 0x1000) {
+    IP4Addr min{base}, max{base + 0x7FF};
+    space.mark(IP4Range{min, max}, ++color);
+    a4.push_back(min);
+    a4.push_back(--IP4Addr(min));
+    a4.push_back(IP4Addr{base + 0x400});
+    a4.push_back(++IP4Addr(max));
+  }
+  IP6Addr a6_base{"2001:db8::"};
+  for (unsigned idx = 0; idx < 257; ++idx) {
+    IP6Addr min{a6_base};
+    IP6Addr max{min};
+    for (unsigned k = 0; k < 15; ++k) {
+      ++max;
+    }
+    space.mark(IP6Range{min, max}, ++color);
+    a6.push_back(min);
+    a6.push_back(max);
+    a6.push_back(++IP6Addr(max));
+    a6_base = max;
+    for (unsigned k = 0; k < 17; ++k) {
+      ++a6_base;
+    }
+  }
+  // Interleave the families and throw in an invalid address.
+  for (size_t idx = 0; idx < std::max(a4.size(), a6.size()); ++idx) {
+    if (idx < a4.size()) {
+      addrs.emplace_back(a4[idx]);
+    }
+    if (idx < a6.size()) {
+      addrs.emplace_back(a6[idx]);
+    }
+    if (idx == 77) {
+      addrs.emplace_back();
+    }
+  }
+
+  // Check a batch against individual lookups.
+  auto check = [&](auto const& keys) -> void {
+    using addr_type = typename std::decay_t<decltype(keys)>::value_type;
+    std::vector<Space::iterator> spots(keys.size());
+    auto n = space.find(MemSpan<addr_type const>{keys.data(), keys.size()}, MemSpan<Space::iterator>{spots.data(), spots.size()});
+    size_t expected = 0;
+    for (size_t idx = 0; idx < keys.size(); ++idx) {
+      auto spot = space.find(keys[idx]);
+      REQUIRE(spots[idx] == spot);
+      if (spot != space.end()) {
+        ++expected;
+        REQUIRE(std::get<1>(*spots[idx]) == std::get<1>(*spot));
+      }
+    }
+    REQUIRE(n == expected);
+  };
+
+  check(a4);
+  check(a6);
+  check(addrs);
+
+  // Only the shorter of the spans is used.
+  std::vector<Space::iterator> spots(10, space.begin());
+  space.find(MemSpan<IP4Addr const>{a4.data(), 5}, MemSpan<Space::iterator>{spots.data(), spots.size()});
+  REQUIRE(spots[0] == space.find(a4[0]));
+  REQUIRE(spots[5] == space.begin());
+}
+
+// An iterator that yields elements by value, with a payload that is destroyed with the element.
+struct IP4LoadTransform {
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = std::pair<IP4Range, std::string>;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = void;
+  using reference         = value_type;
+
+  std::vector<std::pair<IPRange, unsigned>>::const_iterator _spot;
+
+  value_type operator*() const {
+    auto const& [range, payload] = *_spot;
+    return {range.ip4(), std::string(40, char('a' + payload))};
+  }
+  IP4LoadTransform& operator++() {
+    ++_spot;
+    return *this;
+  }
+  bool operator==(IP4LoadTransform const& that) const { return _spot == that._spot; }
+  bool operator!=(IP4LoadTransform const& that) const { return _spot != that._spot; }
+};
+
+TEST_CASE("IPSpace load", "[libswoc][ipspace][load]") {
+  using Space = swoc::IPSpace<unsigned>;
+  using Item  = std::pair<IPRange, unsigned>;
+
+  auto same = [](Space const& lhs, Space const& rhs) -> bool {
+    if (lhs.count() != rhs.count()) {
+      return false;
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](auto const& l, auto const& r) {
+      return std::get<0>(l) == std::get<0>(r) && std::get<1>(l) == std::get<1>(r);
+    });
+  };
+  auto marked = [](Space& space, std::vector<Item> const& items) -> Space& {
+    for (auto const& [range, payload] : items) {
+      space.mark(range, payload);
+    }
+    return space;
+  };
+
+  // Sorted and disjoint, with runs of adjacent ranges with the same payload.
+  std::vector<Item> items;
+  for (in_addr_t base = 0x0A000000; base < 0x0A100000; base += 0x1000) {
+    items.emplace_back(IP4Range{IP4Addr{base}, IP4Addr{base + 0x7FF}}, (base >> 14) & 3);
+    items.emplace_back(IP4Range{IP4Addr{base + 0x800}, IP4Addr{base + 0xBFF}}, (base >> 14) & 3);
+  }
+  items.emplace_back(IPRange{"2001:db8::/64"}, 1);
+  items.emplace_back(IPRange{"2001:db8:0:1::/64"}, 1);
+  items.emplace_back(IPRange{"2001:db8:0:2::/64"}, 2);
+
+  Space s1, s2;
+  s1.load(items.begin(), items.end());
+  marked(s2, items);
+  REQUIRE(s1.count() == 256 + 2);
+  REQUIRE(same(s1, s2));
+  for (auto const& [range, payload] : items) {
+    auto spot = s1.find(range.min());
+    REQUIRE(spot != s1.end());
+    REQUIRE(std::get<1>(*spot) == payload);
+    REQUIRE(s1.find(range.max()) == spot);
+  }
+  REQUIRE(s1.find(IPAddr{"10.0.0.0"}) != s1.end());
+  REQUIRE(s1.find(IPAddr{"10.0.12.0"}) == s1.end());
+
+  // The tree must be valid for further updates.
+  s1.mark(IPRange{"10.0.12.0-10.0.12.255"}, 9);
+  s2.mark(IPRange{"10.0.12.0-10.0.12.255"}, 9);
+  s1.erase(IPRange{"10.3.0.0/16"});
+  s2.erase(IPRange{"10.3.0.0/16"});
+  REQUIRE(same(s1, s2));
+
+  // Load from another space, which has the families in order.
+  Space s3;
+  s3.load(s1.begin(), s1.end());
+  REQUIRE(same(s1, s3));
+
+  // Append to a non-empty space.
+  std::vector<Item> more{{IPRange{"10.200.0.0/16"}, 5}, {IPRange{"10.201.0.0/16"}, 5}};
+  s3.load(more.begin(), more.end());
+  marked(s1, more);
+  REQUIRE(same(s1, s3));
+  REQUIRE(s3.find(IPAddr{"10.201.1.1"}) == s3.find(IPAddr{"10.200.1.1"}));
+
+  // Out of order and overlapping ranges.
+  std::vector<Item> mixed{{IPRange{"10.1.0.0/16"}, 1},       {IPRange{"10.2.0.0/16"}, 2},
+                          {IPRange{"10.1.128.0/17"}, 2},     {IPRange{"10.0.0.0-10.1.0.255"}, 3},
+                          {IPRange{"2001:db8::/32"}, 4},     {IPRange{"10.2.0.0/15"}, 2},
+                          {IPRange{"2001:db8:1::/48"}, 5},   {IPRange{"2001::/16"}, 6}};
+  Space s4, s5;
+  s4.load(mixed.begin(), mixed.end());
+  marked(s5, mixed);
+  REQUIRE(same(s4, s5));
+
+  // Randomized against mark.
+  std::mt19937 rng(0x10ad);
+  for (int pass = 0; pass < 8; ++pass) {
+    std::vector<Item> rand_items;
+    in_addr_t base = 0;
+    for (unsigned idx = 0; idx < 1000; ++idx) {
+      base += rng() % 64;
+      in_addr_t max = base + rng() % 64;
+      // Occasionally overlap the previous range.
+      rand_items.emplace_back(IP4Range{IP4Addr{pass > 3 && idx % 97 == 0 ? base - 100 : base}, IP4Addr{max}}, rng() % 3);
+      base = max + 1;
+    }
+    Space r1, r2;
+    r1.load(rand_items.begin(), rand_items.end());
+    marked(r2, rand_items);
+    REQUIRE(same(r1, r2));
+    for (unsigned k = 0; k < 1000; ++k) {
+      IP4Addr addr{in_addr_t(rng() % base)};
+      auto spot = r1.find(addr);
+      REQUIRE((spot == r1.end()) == (r2.find(addr) == r2.end()));
+      if (spot != r1.end()) {
+        REQUIRE(std::get<1>(*spot) == std::get<1>(*r2.find(addr)));
+      }
+    }
+  }
+
+  std::vector<Item> ip4_items{{IPRange{"10.0.0.0/24"}, 1}, {IPRange{"10.0.1.0/24"}, 2}, {IPRange{"10.0.0.128/25"}, 3}};
+  swoc::DiscreteSpace<IP4Addr, std::string> ds;
+  ds.load(IP4LoadTransform{ip4_items.cbegin()}, IP4LoadTransform{ip4_items.cend()});
+  REQUIRE(ds.count() == 3);
+  REQUIRE(ds.find(IP4Addr{"10.0.0.1"})->payload() == std::string(40, 'b'));
+  REQUIRE(ds.find(IP4Addr{"10.0.0.129"})->payload() == std::string(40, 'd'));
+  REQUIRE(ds.find(IP4Addr{"10.0.1.1"})->payload() == std::string(40, 'c'));
+}
+
+TEST_CASE("IPSpace blend erase fill edges", "[libswoc][ipspace][blend][erase][fill]") {
+  using PAYLOAD = std::bitset<4>;
+  using Space   = swoc::IPSpace<PAYLOAD>;
+  auto blender  = [](PAYLOAD& bits, unsigned bit) -> bool {
+    bits.flip(bit);
+    return bits.any();
+  };
+  auto payload_at = [](Space& space, TextView text) -> unsigned long {
+    auto spot = space.find(IPAddr{text});
+    return spot == space.end() ? 99 : std::get<1>(*spot).to_ulong();
+  };
+
+  // Erase starting before the first range.
+  Space space;
+  space.mark(IPRange{"10.0.0.10-10.0.0.20"}, PAYLOAD{1});
+  space.erase(IPRange{"10.0.0.5-10.0.0.12"});
+  REQUIRE(space.count() == 1);
+  REQUIRE(payload_at(space, "10.0.0.12") == 99);
+  REQUIRE(payload_at(space, "10.0.0.13") == 1);
+
+  // The gap before a range with the same color as unmapped addresses must not be blended twice.
+  space.clear();
+  space.mark(IPRange{"10.0.0.10-10.0.0.20"}, PAYLOAD{2});
+  space.blend(IPRange{"10.0.0.0-10.0.0.30"}, 1, blender);
+  REQUIRE(payload_at(space, "10.0.0.5") == 2);
+  REQUIRE(payload_at(space, "10.0.0.15") == 99);
+  REQUIRE(payload_at(space, "10.0.0.25") == 2);
+  REQUIRE(space.count() == 2);
+
+  // A non-adjacent predecessor must not be extended over the gap.
+  space.clear();
+  space.mark(IPRange{"10.0.0.1-10.0.0.2"}, PAYLOAD{1});
+  space.mark(IPRange{"10.0.0.10-10.0.0.20"}, PAYLOAD{2});
+  space.blend(IPRange{"10.0.0.5-10.0.0.12"}, 0, blender);
+  REQUIRE(payload_at(space, "10.0.0.3") == 99);
+  REQUIRE(payload_at(space, "10.0.0.5") == 1);
+  REQUIRE(payload_at(space, "10.0.0.11") == 3);
+
+  // Blending up to a range with the resulting color coalesces with it.
+  space.clear();
+  space.mark(IPRange{"10.0.0.10-10.0.0.10"}, PAYLOAD{2});
+  space.mark(IPRange{"10.0.0.11-10.0.0.20"}, PAYLOAD{3});
+  space.blend(IPRange{"10.0.0.10-10.0.0.10"}, 0, blender);
+  REQUIRE(space.count() == 1);
+
+  // Fill only sets unmapped addresses.
+  space.clear();
+  space.mark(IPRange{"10.0.0.10-10.0.0.20"}, PAYLOAD{2});
+  space.fill(IPRange{"10.0.0.0-10.0.0.30"}, PAYLOAD{4});
+  REQUIRE(payload_at(space, "10.0.0.5") == 4);
+  REQUIRE(payload_at(space, "10.0.0.15") == 2);
+  REQUIRE(payload_at(space, "10.0.0.25") == 4);
+  REQUIRE(space.count() == 3);
+}
+
+TEST_CASE("IPSpaceBuilder", "[libswoc][ipspace][builder]") {
+  using PAYLOAD = std::bitset<16>;
+  using Space   = swoc::IPSpace<PAYLOAD>;
+  using Builder = swoc::IPSpaceBuilder<PAYLOAD, unsigned>;
+
+  auto blender = [](PAYLOAD& bits, unsigned bit) -> bool {
+    bits.flip(bit);
+    return bits.any();
+  };
+  auto same = [](Space const& lhs, Space const& rhs) -> bool {
+    if (lhs.count() != rhs.count()) {
+      return false;
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](auto const& l, auto const& r) {
+      return std::get<0>(l) == std::get<0>(r) && std::get<1>(l) == std::get<1>(r);
+    });
+  };
+
+  std::mt19937 rng(0xb1d);
+  auto random_range = [&](bool ip6_p) -> IPRange {
+    if (ip6_p) {
+      IP6Addr min{"2001:db8::"};
+      for (unsigned k = rng() % 4096; k > 0; --k) {
+        ++min;
+      }
+      IP6Addr max{min};
+      for (unsigned k = rng() % 64; k > 0; --k) {
+        ++max;
+      }
+      return IP6Range{min, max};
+    }
+    in_addr_t min = 0x0A000000 + rng() % 0x10000;
+    return IP4Range{IP4Addr{min}, IP4Addr{in_addr_t(min + rng() % 256)}};
+  };
+
+  Space seq;
+  Builder builder;
+  for (unsigned idx = 0; idx < 4000; ++idx) {
+    auto range = random_range(idx % 5 == 0);
+    switch (rng() % 8) {
+    case 0: {
+      PAYLOAD bits{rng() & 0xFFFF};
+      seq.mark(range, bits);
+      builder.mark(range, bits);
+    } break;
+    case 1:
+      seq.fill(range, PAYLOAD{1});
+      builder.fill(range, PAYLOAD{1});
+      break;
+    case 2:
+      seq.erase(range);
+      builder.erase(range);
+      break;
+    default: {
+      unsigned bit = rng() % 4;
+      seq.blend(range, bit, blender);
+      builder.blend(range, bit);
+    } break;
+    }
+  }
+  // Operations that cross every partition.
+  seq.blend(IPRange{"10.0.0.0/15"}, 5u, blender);
+  builder.blend(IPRange{"10.0.0.0/15"}, 5u);
+  seq.erase(IPRange{"10.0.128.0/24"});
+  builder.erase(IPRange{"10.0.128.0/24"});
+  REQUIRE(builder.count() == 4002);
+
+  for (unsigned n_threads : {1, 2, 3, 8}) {
+    Space space;
+    builder.build(space, blender, n_threads);
+    REQUIRE(same(seq, space));
+  }
+
+  // Existing content is kept and the operations applied on top.
+  Space base, expected;
+  for (auto s : {&base, &expected}) {
+    s->mark(IPRange{"10.0.0.0/16"}, PAYLOAD{0x100});
+    s->mark(IPRange{"2001:db8::/120"}, PAYLOAD{0x200});
+  }
+  Builder more;
+  more.blend(IPRange{"10.0.1.0-10.0.200.255"}, 1).erase(IPRange{"10.0.100.0/24"}).mark(IPRange{"9.0.0.0/8"}, PAYLOAD{1});
+  expected.blend(IPRange{"10.0.1.0-10.0.200.255"}, 1u, blender).erase(IPRange{"10.0.100.0/24"}).mark(IPRange{"9.0.0.0/8"}, PAYLOAD{1});
+  more.build(base, blender, 4);
+  REQUIRE(same(base, expected));
+}
+
+TEST_CASE("IPSpace set operations", "[libswoc][ipspace][union][intersect][difference]") {
+  using PAYLOAD = std::bitset<16>;
+  using Space   = swoc::IPSpace<PAYLOAD>;
+
+  auto blender = [](PAYLOAD& bits, unsigned bit) -> bool {
+    bits.flip(bit);
+    return bits.any();
+  };
+
+  std::mt19937 rng(0x5e7);
+  auto random_range = [&]() -> IP4Range {
+    in_addr_t min = 0x0A000000 + rng() % 0x10000;
+    return IP4Range{IP4Addr{min}, IP4Addr{in_addr_t(min + rng() % 512)}};
+  };
+
+  Space lhs;
+  swoc::IPSpace<unsigned> rhs;
+  for (unsigned idx = 0; idx < 400; ++idx) {
+    lhs.mark(random_range(), PAYLOAD{rng() % 4});
+    rhs.mark(random_range(), rng() % 4);
+  }
+  // Ranges at the ends of the address space.
+  lhs.mark(IPRange{"0.0.0.0-0.0.0.10"}, PAYLOAD{1});
+  rhs.mark(IPRange{"0.0.0.5-0.0.0.20"}, 2);
+  lhs.mark(IPRange{"255.255.255.0-255.255.255.255"}, PAYLOAD{2});
+  rhs.mark(IPRange{"255.255.255.128-255.255.255.255"}, 1);
+  lhs.mark(IPRange{"2001:db8::/120"}, PAYLOAD{8});
+  rhs.mark(IPRange{"2001:db8::80-2001:db8::1:0"}, 3);
+  lhs.mark(IPRange{"ffff::/16"}, PAYLOAD{4});
+
+  Space u, i, d;
+  u.unite(lhs, rhs, blender);
+  i.intersect(lhs, rhs, blender);
+  d.difference(lhs, rhs);
+
+  // Union is the same as blending each range in to a copy.
+  Space expected;
+  expected.load(lhs.begin(), lhs.end());
+  for (auto const& [r, bit] : rhs) {
+    expected.blend(r, bit, blender);
+  }
+  REQUIRE(u.count() == expected.count());
+  REQUIRE(std::equal(u.begin(), u.end(), expected.begin(), [](auto const& l, auto const& r) {
+    return std::get<0>(l) == std::get<0>(r) && std::get<1>(l) == std::get<1>(r);
+  }));
+
+  // Check every address against the inputs.
+  auto check = [&](IPAddr const& addr) {
+    auto lspot = lhs.find(addr);
+    auto rspot = rhs.find(addr);
+    bool l_p   = lspot != lhs.end();
+    bool r_p   = rspot != rhs.end();
+    PAYLOAD blended{l_p ? std::get<1>(*lspot) : PAYLOAD{}};
+    bool blend_p = r_p && blender(blended, std::get<1>(*rspot));
+
+    auto uspot = u.find(addr);
+    if (r_p ? blend_p : l_p) {
+      REQUIRE(uspot != u.end());
+      REQUIRE(std::get<1>(*uspot) == (r_p ? blended : std::get<1>(*lspot)));
+    } else {
+      REQUIRE(uspot == u.end());
+    }
+    auto ispot = i.find(addr);
+    if (l_p && blend_p) {
+      REQUIRE(ispot != i.end());
+      REQUIRE(std::get<1>(*ispot) == blended);
+    } else {
+      REQUIRE(ispot == i.end());
+    }
+    auto dspot = d.find(addr);
+    if (l_p && !r_p) {
+      REQUIRE(dspot != d.end());
+      REQUIRE(std::get<1>(*dspot) == std::get<1>(*lspot));
+    } else {
+      REQUIRE(dspot == d.end());
+    }
+  };
+  for (in_addr_t addr = 0x0A000000; addr < 0x0A010400; ++addr) {
+    check(IP4Addr{addr});
+  }
+  for (in_addr_t addr = 0; addr < 32; ++addr) {
+    check(IP4Addr{addr});
+    check(IP4Addr{in_addr_t(0xFFFFFFFF - addr * 8)});
+  }
+  for (auto text : {"2001:db8::", "2001:db8::7f", "2001:db8::80", "2001:db8::ff", "2001:db8::100", "2001:db8::1:0",
+                    "2001:db8::1:1", "ffff::1", "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff"}) {
+    check(IPAddr{text});
+  }
+
+  // Results are fully coalesced.
+  for (Space const *s : {&u, &i, &d}) {
+    std::optional<std::tuple<IPRange, PAYLOAD>> prev;
+    for (auto const& [r, p] : *s) {
+      if (prev) {
+        auto const& [pr, pp] = *prev;
+        bool adjacent_p      = pr.is_ip4() && r.is_ip4() && ++IP4Addr{pr.ip4().max()} == r.ip4().min();
+        REQUIRE_FALSE((adjacent_p && pp == p));
+      }
+      prev.emplace(r, p);
+    }
+  }
+
+  // Empty operands.
+  Space empty, result;
+  REQUIRE(result.unite(lhs, swoc::IPSpace<unsigned>{}, blender).count() == lhs.count());
+  REQUIRE(result.intersect(lhs, swoc::IPSpace<unsigned>{}, blender).count() == 0);
+  REQUIRE(result.difference(empty, rhs).count() == 0);
+  REQUIRE(result.difference(lhs, swoc::IPSpace<unsigned>{}).count() == lhs.count());
+}
+
+TEST_CASE("IPSnapshot", "[libswoc][ipspace][flat][snapshot]") {
+  swoc::file::path path{"/tmp/swoc_ip_snapshot_test.ips"};
+  swoc::IPSpace<unsigned> space;
+  for (in_addr_t base = 0x0A000000; base < 0x0A100000; base += 0x1000) {
+    space.mark(IP4Range{IP4Addr{base}, IP4Addr{base + 0x7FF}}, base >> 12);
+  }
+  space.mark(IPRange{"1337::/64"}, 1337);
+  space.mark(IPRange{"2001:db8::/48"}, 2001);
+
+  swoc::IPFlatSpace<unsigned> flat{space};
+  auto errata = swoc::IPSnapshot<unsigned>::store(path, flat);
+  REQUIRE(errata.is_ok());
+
+  swoc::IPSnapshot<unsigned> snap;
+  errata = snap.map(path);
+  REQUIRE(errata.is_ok());
+  REQUIRE(snap.space().count() == space.count());
+  auto spot = space.begin();
+  for (auto const& [r, p] : snap.space()) {
+    REQUIRE(r == std::get<0>(*spot));
+    REQUIRE(p == std::get<1>(*spot));
+    ++spot;
+  }
+  REQUIRE(std::get<1>(*snap.space().find(IPAddr{"10.0.16.1"})) == 0xA001);
+  REQUIRE(snap.space().find(IPAddr{"10.0.16.1"}) != snap.space().end());
+  REQUIRE(snap.space().find(IPAddr{"10.0.24.1"}) == snap.space().end());
+  REQUIRE(std::get<1>(*snap.space().find(IPAddr{"2001:db8::1"})) == 2001);
+
+  // Moving must keep the space valid.
+  swoc::IPSnapshot<unsigned> snap2{std::move(snap)};
+  REQUIRE(std::get<1>(*snap2.space().find(IPAddr{"1337::1"})) == 1337);
+
+  // Loading rather than mapping.
+  swoc::IPSnapshot<unsigned> snap3;
+  REQUIRE(snap3.load(path).is_ok());
+  REQUIRE(snap3.space().count() == space.count());
+  REQUIRE(std::get<1>(*snap3.space().find(IPAddr{"10.0.0.1"})) == 0xA000);
+
+  // Payload type mismatch.
+  swoc::IPSnapshot<uint64_t> bad_payload;
+  REQUIRE_FALSE(bad_payload.map(path).is_ok());
+
+  // Variable sized payloads via the blob table.
+  swoc::IPBlobTable blobs;
+  swoc::IPSpace<swoc::IPBlobRef> bspace;
+  bspace.mark(IPRange{"10.1.0.0/16"}, blobs.add("alpha"));
+  bspace.mark(IPRange{"10.2.0.0/16"}, blobs.add("bravo"));
+  bspace.mark(IPRange{"10.3.0.0/16"}, blobs.add("alpha"));
+  bspace.mark(IPRange{"1337::/64"}, blobs.add("charlie"));
+  REQUIRE(blobs.size() == 5 + 5 + 7);
+  REQUIRE(swoc::IPSnapshot<swoc::IPBlobRef>::store(path, swoc::IPFlatSpace<swoc::IPBlobRef>{bspace}, &blobs).is_ok());
+  swoc::IPSnapshot<swoc::IPBlobRef> bsnap;
+  REQUIRE(bsnap.map(path).is_ok());
+  REQUIRE(bsnap.blob(std::get<1>(*bsnap.space().find(IPAddr{"10.3.0.1"}))) == "alpha");
+  REQUIRE(bsnap.blob(std::get<1>(*bsnap.space().find(IPAddr{"10.2.0.1"}))) == "bravo");
+  REQUIRE(bsnap.blob(std::get<1>(*bsnap.space().find(IPAddr{"1337::1"}))) == "charlie");
+  bsnap.clear();
+  REQUIRE(bsnap.space().count() == 0);
+  REQUIRE(bsnap.space().find(IPAddr{"10.3.0.1"}) == bsnap.space().end());
+  // The snapshot is written via a private temporary file, check it was made readable.
+  struct stat info;
+  REQUIRE(0 == stat(path.c_str(), &info));
+  REQUIRE((info.st_mode & 0777) == 0644);
+
+  // Corrupt a byte in a section, which should be detected only if verifying.
+  std::error_code ec;
+  auto content = swoc::file::load(path, ec);
+  REQUIRE(!ec);
+  auto hdr = reinterpret_cast<swoc::IPSnapshotFile::Header const *>(content.data());
+  content[hdr->_sections[swoc::IPSnapshotFile::BLOB]._offset] ^= 0x55;
+  {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size());
+  }
+  REQUIRE_FALSE(bsnap.map(path).is_ok());
+  REQUIRE(bsnap.map(path, false).is_ok());
+  // Corrupt the header.
+  content[offsetof(swoc::IPSnapshotFile::Header, _ip4_count)] ^= 0x55;
+  {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size());
+  }
+  REQUIRE_FALSE(bsnap.map(path, false).is_ok());
+  unlink(path.c_str());
+}
+
+TEST_CASE("IPTrie", "[libswoc][ip][trie]") {
+  using swoc::IPNet;
+  using Trie = swoc::IPTrie<unsigned>;
+  using NetList = std::vector<std::pair<IPNet, unsigned>>;
+  auto span_of = [](NetList const& nets) { return swoc::MemSpan<std::pair<IPNet, unsigned> const>{nets.data(), nets.size()}; };
+
+  Trie empty;
+  REQUIRE(empty.empty());
+  REQUIRE(std::get<1>(empty.find(IPAddr{"10.1.1.1"})) == nullptr);
+  REQUIRE(std::get<1>(empty.find(IPAddr{"::1"})) == nullptr);
+
+  // Nested networks, most specific wins regardless of order. Duplicates use the last payload.
+  NetList nested{{IPNet{"10.1.2.0/24"}, 99},         {IPNet{"10.0.0.0/8"}, 1},           {IPNet{"10.1.2.128/25"}, 4},
+                 {IPNet{"10.1.0.0/16"}, 2},          {IPNet{"10.1.2.7/32"}, 5},          {IPNet{"0.0.0.0/0"}, 0},
+                 {IPNet{"2001:db8:1::/48"}, 99},     {IPNet{"2001:db8::/32"}, 10},       {IPNet{"2001:db8:1::/48"}, 11},
+                 {IPNet{"2001:db8:1:2::1/128"}, 12}, {IPNet{"10.1.2.0/24"}, 3}};
+  Trie trie{span_of(nested)};
+  REQUIRE(trie.count() == 9);
+  REQUIRE(trie.count_ip4() == 6);
+  REQUIRE(trie.count_ip6() == 3);
+
+  auto check = [&](TextView addr, TextView net, unsigned payload) -> void {
+    auto [n, p] = trie.find(IPAddr{addr});
+    REQUIRE(p != nullptr);
+    CHECK(*p == payload);
+    CHECK(n == IPNet{net});
+  };
+  check("10.1.2.7", "10.1.2.7/32", 5);
+  check("10.1.2.6", "10.1.2.0/24", 3);
+  check("10.1.2.8", "10.1.2.0/24", 3);
+  check("10.1.2.200", "10.1.2.128/25", 4);
+  check("10.1.3.1", "10.1.0.0/16", 2);
+  check("10.2.3.1", "10.0.0.0/8", 1);
+  check("172.16.1.1", "0.0.0.0/0", 0);
+  check("2001:db8:1:2::1", "2001:db8:1:2::1/128", 12);
+  check("2001:db8:1:2::2", "2001:db8:1::/48", 11);
+  check("2001:db8:2::1", "2001:db8::/32", 10);
+  REQUIRE(std::get<1>(trie.find(IPAddr{"2001:db9::1"})) == nullptr);
+  REQUIRE(std::get<1>(trie.find(IPAddr{})) == nullptr);
+
+  // Networks are iterated in address order.
+  auto iter = trie.ip4().begin();
+  REQUIRE(iter->first == swoc::IP4Net{"0.0.0.0/0"});
+  ++iter;
+  REQUIRE(iter->first == swoc::IP4Net{"10.0.0.0/8"});
+
+  // Random networks, checked against a linear scan.
+  std::mt19937 rng{0x1DEA};
+  std::vector<std::pair<IPNet, unsigned>> nets;
+  for (unsigned idx = 0; idx < 2000; ++idx) {
+    // Keep the addresses clustered so there is a lot of nesting.
+    IP4Addr a4{in_addr_t(0x0A000000 | (rng() & 0x00FFFFFF))};
+    nets.emplace_back(IPNet{a4, IPMask(8 + rng() % 25)}, idx);
+    in6_addr raw6;
+    IP6Addr{"2001:db8::"}.copy_to(raw6);
+    for (unsigned k = 4; k < 16; ++k) {
+      raw6.s6_addr[k] = (k < 8 ? rng() & 0x3 : rng());
+    }
+    nets.emplace_back(IPNet{IP6Addr{raw6}, IPMask(32 + rng() % 97)}, idx);
+  }
+  Trie rtrie{span_of(nets)};
+
+  auto in_net = [](IPNet const& net, IPAddr const& addr) -> bool {
+    return net.family() == addr.family() && net.lower_bound() <= addr && addr <= net.upper_bound();
+  };
+  auto brute = [&](IPAddr const& addr) -> unsigned const * {
+    unsigned const *zret = nullptr;
+    unsigned width       = 0;
+    for (auto const& [net, payload] : nets) {
+      if (in_net(net, addr) && (zret == nullptr || net.width() >= width)) {
+        zret  = &payload;
+        width = net.width();
+      }
+    }
+    return zret;
+  };
+
+  for (unsigned idx = 0; idx < 2000; ++idx) {
+    // Mix addresses at network boundaries with random ones.
+    auto const& net = nets[rng() % nets.size()].first;
+    for (IPAddr addr : {net.lower_bound(), net.upper_bound(), IPAddr{IP4Addr{in_addr_t(0x0A000000 | (rng() & 0x00FFFFFF))}}}) {
+      auto expected = brute(addr);
+      auto [n, p] = rtrie.find(addr);
+      if (expected == nullptr) {
+        REQUIRE(p == nullptr);
+      } else {
+        REQUIRE(p != nullptr);
+        // Duplicate networks keep the last payload.
+        REQUIRE(*p == *expected);
+        REQUIRE(in_net(n, addr));
+      }
+    }
+  }
+
+  // Export from an IPSpace - every address in the space must find the same payload.
+  swoc::IPSpace<unsigned> space;
+  space.mark(IPRange{"10.0.0.0-10.0.1.255"}, 1);
+  space.mark(IPRange{"10.0.0.17-10.0.0.93"}, 2);
+  space.mark(IPRange{"172.16.0.3-172.18.4.7"}, 3);
+  space.mark(IPRange{"2001:db8::5-2001:db8::1:7"}, 4);
+  space.mark(IPRange{"::-::ff"}, 5);
+  Trie exported{space};
+  for (auto const& [range, payload] : space) {
+    for (IPAddr addr : {range.min(), range.max()}) {
+      auto [n, p] = exported.find(addr);
+      REQUIRE(p != nullptr);
+      REQUIRE(*p == payload);
+    }
+    IPAddr before = range.is_ip4() ? IPAddr{--IP4Addr{range.min().ip4()}} : IPAddr{--IP6Addr{range.min().ip6()}};
+    auto spot = space.find(before);
+    auto [n, p] = exported.find(before);
+    REQUIRE((spot == space.end()) == (p == nullptr));
+  }
+  REQUIRE(std::get<1>(exported.find(IPAddr{"10.0.2.0"})) == nullptr);
+  CHECK(*std::get<1>(exported.find(IPAddr{"10.0.0.50"})) == 2);
+  CHECK(*std::get<1>(exported.find(IPAddr{"172.17.200.1"})) == 3);
+}
+
+TEST_CASE("SharedIPSpace", "[libswoc][ipspace][shared]") {
+  using Shared = swoc::SharedIPSpace<unsigned>;
+  Shared shared;
+  IPAddr a1{"10.1.1.1"};
+  IPAddr a2{"172.16.1.1"};
+
+  {
+    Shared::Reader reader{shared};
+    {
+      auto ref = reader.lock();
+      REQUIRE(ref->count() == 0);
+      REQUIRE(ref->find(a1) == ref->end());
+    }
+
+    auto epoch = shared.epoch();
+    shared.update([&](Shared::space_type& space) { space.mark(IPRange{"10.0.0.0/8"}, 1); });
+    REQUIRE(shared.epoch() == epoch + 1);
+    {
+      auto ref = reader.lock();
+      REQUIRE(ref->count() == 1);
+      auto spot = ref->find(a1);
+      REQUIRE(spot != ref->end());
+      REQUIRE(std::get<1>(*spot) == 1);
+
+      // The version in use is kept while a new version is published and not reclaimed.
+      shared.update([&](Shared::space_type& space) { space.mark(IPRange{"172.16.0.0/12"}, 2); });
+      REQUIRE(ref->count() == 1);
+      REQUIRE(ref->find(a2) == ref->end());
+      REQUIRE(shared.reclaim() == 1);
+    }
+    // Read section ended, the old version can be reclaimed.
+    REQUIRE(shared.reclaim() == 0);
+    {
+      auto ref = reader.lock();
+      REQUIRE(ref->count() == 2);
+      REQUIRE(std::get<1>(*ref->find(a1)) == 1);
+      REQUIRE(std::get<1>(*ref->find(a2)) == 2);
+    }
+
+    shared.rebuild([&](Shared::space_type& space) { space.mark(IPRange{"172.16.0.0/12"}, 3); });
+    {
+      auto ref = reader.lock();
+      REQUIRE(ref->count() == 1);
+      REQUIRE(ref->find(a1) == ref->end());
+      REQUIRE(std::get<1>(*ref->find(a2)) == 3);
+      REQUIRE(std::get<1>(*ref->find(a2.ip4())) == 3);
+      REQUIRE(ref->find(IPAddr{"1337::1"}.ip6()) == ref->end());
+    }
+
+    // A failed update does not change the current version.
+    epoch = shared.epoch();
+    REQUIRE_THROWS(shared.update([&](Shared::space_type& space) {
+      space.mark(IPRange{"10.0.0.0/8"}, 4);
+      throw std::runtime_error("update failed");
+    }));
+    REQUIRE_THROWS(shared.rebuild([&](Shared::space_type&) { throw std::runtime_error("rebuild failed"); }));
+    REQUIRE(shared.epoch() == epoch);
+    {
+      auto ref = reader.lock();
+      REQUIRE(ref->count() == 1);
+      REQUIRE(ref->find(a1) == ref->end());
+    }
+  }
+
+  // Concurrent readers must always see a consistent version - each version has the same payload
+  // in both ranges.
+  shared.rebuild([&](Shared::space_type& space) {
+    space.mark(IPRange{"10.0.0.0/8"}, 0);
+    space.mark(IPRange{"172.16.0.0/12"}, 0);
+  });
+  std::atomic<bool> done_p{false};
+  std::atomic<unsigned> errors{0};
+  std::atomic<unsigned> reads{0};
+  std::vector<std::thread> threads;
+  for (unsigned idx = 0; idx < 4; ++idx) {
+    threads.emplace_back([&]() {
+      Shared::Reader reader{shared};
+      while (!done_p.load()) {
+        auto ref   = reader.lock();
+        auto spot1 = ref->find(a1);
+        auto spot2 = ref->find(a2);
+        if (spot1 == ref->end() || spot2 == ref->end() || std::get<1>(*spot1) != std::get<1>(*spot2)) {
+          ++errors;
+        }
+        ++reads;
+      }
+    });
+  }
+  while (reads.load() < 100) { // make sure the readers are running.
+    std::this_thread::yield();
+  }
+  for (unsigned k = 1; k <= 500; ++k) {
+    shared.update([&](Shared::space_type& space) {
+      space.mark(IPRange{"10.0.0.0/8"}, k);
+      space.mark(IPRange{"172.16.0.0/12"}, k);
+    });
+  }
+  done_p = true;
+  for (auto& t : threads) {
+    t.join();
+  }
+  REQUIRE(errors == 0);
+  REQUIRE(shared.reclaim() == 0);
+}